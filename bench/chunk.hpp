@@ -0,0 +1,459 @@
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <cstring>
+
+#include <Engine/Clock.hpp>
+#include <Engine/FlatHashMap.hpp>
+
+#include <Game/MapChunk.hpp>
+#include <Game/MapChunkEdit.hpp>
+#include <Game/ChunkCodec.hpp>
+#include <Game/MapGenerator2.hpp>
+
+namespace ChunkBench {
+	using Game::MapChunk;
+	using Game::MapChunkEdit;
+	using Game::BlockId;
+
+	/** The unpacked chunk layout used before palette compression. */
+	struct DenseChunk {
+		MapChunk::DenseData data;
+	};
+
+	/**
+	 * A set of generated chunks from the sky down through the surface and caves.
+	 */
+	inline const std::vector<MapChunk>& corpus() {
+		static const auto chunks = []{
+			const Game::MapGenerator2 mgen{12345};
+			std::vector<MapChunk> res;
+			std::vector<Game::BlockEntityDesc> entData;
+
+			for (int x = -4; x < 4; ++x) {
+				for (int y = -6; y < 2; ++y) {
+					auto& chunk = res.emplace_back();
+					mgen.init(glm::ivec2{x, y} * MapChunk::size, chunk, entData);
+				}
+			}
+
+			return res;
+		}();
+		return chunks;
+	}
+
+	inline const std::vector<DenseChunk>& denseCorpus() {
+		static const auto chunks = []{
+			std::vector<DenseChunk> res;
+			for (const auto& chunk : corpus()) {
+				chunk.toDense(res.emplace_back().data);
+			}
+			return res;
+		}();
+		return chunks;
+	}
+
+	/**
+	 * A 5x5 brush edit in the center of a chunk similar to MapSystem::tick.
+	 */
+	inline const MapChunkEdit& brushEdit() {
+		static const auto edit = []{
+			MapChunkEdit res;
+			for (int x = 30; x < 35; ++x) {
+				for (int y = 30; y < 35; ++y) {
+					res.set({x, y}, BlockId::Air);
+				}
+			}
+			return res;
+		}();
+		return edit;
+	}
+
+	/**
+	 * The original full chunk edit application from MapChunk::apply.
+	 * Applies all non-None blocks from @p edit.
+	 */
+	inline bool applyDense(MapChunk& chunk, const MapChunk& edit) {
+		bool editMade = false;
+
+		for (int x = 0; x < MapChunk::size.x; ++x) {
+			for (auto edits = ~edit.columnMask(x, BlockId::None); edits; edits &= edits - 1) {
+				const glm::ivec2 pos = {x, std::countr_zero(edits)};
+				const auto ed = edit.getBlock(pos);
+				if (chunk.getBlock(pos) == ed) { continue; }
+
+				editMade = true;
+				chunk.setBlock(pos, ed);
+			}
+		}
+
+		return editMade;
+	}
+
+	/**
+	 * Simulates a player continuously digging with a 5x5 brush through the corpus.
+	 * Each tick the edits are recorded, applied, and encoded for the network like MapSystem::tick.
+	 * @param edit Called as `edit(chunkPos, blockIndex)` for each block in the brush.
+	 * @param finish Called as `finish(chunks)` at the end of each tick. Should apply, encode, and clear the edits.
+	 */
+	template<class Edit, class Finish>
+	void dig(Edit&& edit, Finish&& finish) {
+		auto chunks = std::make_unique<std::vector<MapChunk>>(corpus());
+		const auto chunkAt = [&](const glm::ivec2 chunkPos) -> MapChunk& {
+			// Matches the order used by corpus
+			return (*chunks)[(chunkPos.x + 4) * 8 + (chunkPos.y + 6)];
+		};
+
+		// Dig back and forth through the surface and caves crossing chunk borders
+		for (int tick = 0; tick < 4096; ++tick) {
+			const auto step = tick % 1000;
+			const glm::ivec2 center = {
+				-250 + (step < 500 ? step : 999 - step),
+				-300 + (tick / 32) % 200,
+			};
+
+			for (int x = -2; x < 3; ++x) {
+				for (int y = -2; y < 3; ++y) {
+					const auto block = center + glm::ivec2{x, y};
+					const auto blockIndex = (MapChunk::size + block % MapChunk::size) % MapChunk::size;
+					const auto chunkPos = (block - blockIndex) / MapChunk::size;
+					edit(chunkPos, blockIndex);
+				}
+			}
+
+			finish(chunkAt);
+		}
+	}
+
+	/**
+	 * The original MapChunk::toRLE. Grows the output a run at a time.
+	 */
+	inline void encodeRLEOriginal(const DenseChunk& chunk, std::vector<Engine::byte>& encoding) {
+		using Engine::byte;
+		encoding.clear();
+
+		const BlockId* linear = &chunk.data[0][0];
+		MapChunk::RLEPair pair = {.bid = linear[0], .count = 1};
+
+		const auto insert = [&]{
+			if (pair.count == 1) {
+				BlockId bid = pair.bid | MapChunk::RLE_COUNT_BIT;
+				const byte* start = reinterpret_cast<const byte*>(&bid);
+				encoding.insert(encoding.cend(), start, start + sizeof(bid));
+			} else {
+				const byte* start = reinterpret_cast<const byte*>(&pair);
+				encoding.insert(encoding.cend(), start, start + sizeof(pair));
+			}
+		};
+
+		for (int i = 1; i < MapChunk::size.x * MapChunk::size.y; ++i) {
+			if (linear[i] == pair.bid) {
+				++pair.count;
+			} else {
+				insert();
+				pair.bid = linear[i];
+				pair.count = 1;
+			}
+		}
+		insert();
+	}
+
+	/**
+	 * The original MapChunk::fromRLE without validation.
+	 */
+	inline void decodeRLEOriginal(const Engine::byte* begin, const Engine::byte* end, DenseChunk& chunk) {
+		BlockId* linear = &chunk.data[0][0];
+		MapChunk::RLEPair pair;
+
+		int i = 0;
+		while (begin != end) {
+			pair.bid = *reinterpret_cast<const BlockId*>(begin);
+			begin += sizeof(pair.bid);
+
+			if (pair.bid & MapChunk::RLE_COUNT_BIT) {
+				pair.bid ^= MapChunk::RLE_COUNT_BIT;
+				pair.count = 1;
+			} else {
+				pair.count = *reinterpret_cast<const decltype(pair.count)*>(begin);
+				begin += sizeof(pair.count);
+			}
+
+			while (pair.count) {
+				linear[i++] = pair.bid;
+				--pair.count;
+			}
+		}
+	}
+
+	/**
+	 * Prints the average encoded size and throughput of an encoder and decoder over the corpus.
+	 * Throughput is measured in uncompressed (dense) bytes.
+	 */
+	template<class Encode, class Decode>
+	void reportCodec(const char* name, Encode&& encode, Decode&& decode) {
+		using Seconds = std::chrono::duration<double, std::ratio<1, 1>>;
+		constexpr int passes = 100;
+		const auto& chunks = denseCorpus();
+		const double denseBytes = double(sizeof(DenseChunk)) * chunks.size() * passes;
+
+		std::vector<std::vector<Engine::byte>> encoded(chunks.size());
+		size_t total = 0;
+		for (size_t i = 0; i < chunks.size(); ++i) {
+			encode(chunks[i], encoded[i]);
+			total += encoded[i].size();
+		}
+
+		std::vector<Engine::byte> encoding;
+		const auto encodeStart = Engine::Clock::now();
+		for (int p = 0; p < passes; ++p) {
+			for (const auto& chunk : chunks) {
+				encode(chunk, encoding);
+			}
+		}
+		const auto encodeTime = Seconds{Engine::Clock::now() - encodeStart}.count();
+
+		auto decoded = std::make_unique<DenseChunk>();
+		bool valid = true;
+		const auto decodeStart = Engine::Clock::now();
+		for (int p = 0; p < passes; ++p) {
+			for (const auto& enc : encoded) {
+				valid = decode(enc.data(), enc.data() + enc.size(), *decoded) && valid;
+			}
+		}
+		const auto decodeTime = Seconds{Engine::Clock::now() - decodeStart}.count();
+
+		for (size_t i = 0; i < chunks.size(); ++i) {
+			decode(encoded[i].data(), encoded[i].data() + encoded[i].size(), *decoded);
+			valid = valid && !memcmp(decoded->data, chunks[i].data, sizeof(decoded->data));
+		}
+
+		std::cout
+			<< "  " << name << ": " << (total / chunks.size()) << " bytes/chunk, "
+			<< (denseBytes / encodeTime / 1e6) << " MB/s encode, "
+			<< (denseBytes / decodeTime / 1e6) << " MB/s decode"
+			<< (valid ? "" : " (MISMATCH)") << "\n";
+	}
+	/**
+	 * The original per block greedy expansion from MapSystem::buildActiveChunkData.
+	 */
+	template<class Usable, class SubmitArea>
+	void greedyExpandPerBlock(const DenseChunk& chunk, Usable&& usable, SubmitArea&& submitArea) {
+		bool used[MapChunk::size.x][MapChunk::size.y] = {};
+
+		for (glm::ivec2 begin = {0, 0}; begin.x < MapChunk::size.x; ++begin.x) {
+			for (begin.y = 0; begin.y < MapChunk::size.y;) {
+				const auto& blockMeta = Game::getBlockMeta(chunk.data[begin.x][begin.y]);
+				auto end = begin;
+				while (end.y < MapChunk::size.y && !used[end.x][end.y] && usable(end, blockMeta)) { ++end.y; }
+				if (end.y == begin.y) { ++begin.y; continue; }
+
+				for (bool cond = true; cond;) {
+					memset(&used[end.x][begin.y], 1, end.y - begin.y);
+					++end.x;
+
+					if (end.x == MapChunk::size.x) { break; }
+					for (int y = begin.y; y < end.y; ++y) {
+						if (used[end.x][y] || !usable(glm::ivec2{end.x, y}, blockMeta)) { cond = false; break; }
+					}
+				}
+
+				submitArea(begin, end);
+				begin.y = end.y;
+			}
+		}
+	}
+}
+
+Engine::Clock::Duration chunkGreedyPerBlock() {
+	using namespace ChunkBench;
+	const auto& chunks = denseCorpus();
+	volatile int64_t areas = 0;
+
+	const auto start = Engine::Clock::now();
+	for (int i = 0; i < 100; ++i) {
+		for (const auto& chunk : chunks) {
+			greedyExpandPerBlock(chunk, [&](const auto& pos, const auto& blockMeta) {
+				return blockMeta.id != BlockId::None
+					&& blockMeta.id != BlockId::Air
+					&& chunk.data[pos.x][pos.y] == blockMeta.id;
+			}, [&](const auto& begin, const auto& end) { areas = areas + (end.x - begin.x) * (end.y - begin.y); });
+
+			greedyExpandPerBlock(chunk, [&](const auto& pos, const auto& blockMeta) {
+				return Game::getBlockMeta(chunk.data[pos.x][pos.y]).solid;
+			}, [&](const auto& begin, const auto& end) { areas = areas + (end.x - begin.x) * (end.y - begin.y); });
+		}
+	}
+	const auto stop = Engine::Clock::now();
+	return stop - start;
+}
+
+Engine::Clock::Duration chunkGreedyBitmask() {
+	using namespace ChunkBench;
+	const auto& chunks = corpus();
+	volatile int64_t areas = 0;
+
+	const auto start = Engine::Clock::now();
+	for (int i = 0; i < 100; ++i) {
+		for (const auto& chunk : chunks) {
+			chunk.forEachRenderArea([&](const auto& begin, const auto& end) { areas = areas + (end.x - begin.x) * (end.y - begin.y); });
+			chunk.forEachSolidArea([&](const auto& begin, const auto& end) { areas = areas + (end.x - begin.x) * (end.y - begin.y); });
+		}
+	}
+	const auto stop = Engine::Clock::now();
+	return stop - start;
+}
+
+Engine::Clock::Duration chunkApplyPerBlock() {
+	using namespace ChunkBench;
+	auto chunks = std::make_unique<std::vector<DenseChunk>>();
+	DenseChunk edit = {};
+	for (const auto& entry : brushEdit().entries()) {
+		const auto pos = MapChunkEdit::toPos(entry.index);
+		edit.data[pos.x][pos.y] = entry.bid;
+	}
+	volatile int64_t edits = 0;
+
+	Engine::Clock::Duration total = {};
+	for (int i = 0; i < 100; ++i) {
+		// Reset so every iteration has edits to apply
+		*chunks = denseCorpus();
+
+		const auto start = Engine::Clock::now();
+		for (auto& chunk : *chunks) {
+			bool editMade = false;
+			for (int x = 0; x < MapChunk::size.x; ++x) {
+				for (int y = 0; y < MapChunk::size.y; ++y) {
+					const auto& ed = edit.data[x][y];
+					if (ed == BlockId::None) { continue; }
+
+					auto& cd = chunk.data[x][y];
+					if (cd == ed) { continue; }
+
+					editMade = true;
+					cd = ed;
+				}
+			}
+			edits = edits + editMade;
+		}
+		total += Engine::Clock::now() - start;
+	}
+	return total;
+}
+
+Engine::Clock::Duration chunkApplySparse() {
+	using namespace ChunkBench;
+	auto chunks = std::make_unique<std::vector<MapChunk>>();
+	const auto& edit = brushEdit();
+	volatile int64_t edits = 0;
+
+	Engine::Clock::Duration total = {};
+	for (int i = 0; i < 100; ++i) {
+		// Reset so every iteration has edits to apply
+		*chunks = corpus();
+
+		const auto start = Engine::Clock::now();
+		for (auto& chunk : *chunks) {
+			edits = edits + chunk.apply(edit);
+		}
+		total += Engine::Clock::now() - start;
+	}
+	return total;
+}
+
+Engine::Clock::Duration mapDigDense() {
+	using namespace ChunkBench;
+	Engine::FlatHashMap<glm::ivec2, MapChunk> edits;
+	std::vector<Engine::byte> encoding;
+	volatile int64_t bytes = 0;
+
+	const auto start = Engine::Clock::now();
+	dig([&](const glm::ivec2 chunkPos, const glm::ivec2 blockIndex) {
+		edits[chunkPos].setBlock(blockIndex, BlockId::Air);
+	}, [&](auto&& chunkAt) {
+		for (const auto& [chunkPos, edit] : edits) {
+			if (applyDense(chunkAt(chunkPos), edit)) {
+				edit.toRLE(encoding);
+				bytes = bytes + encoding.size();
+			}
+		}
+		edits.clear();
+	});
+	const auto stop = Engine::Clock::now();
+	return stop - start;
+}
+
+Engine::Clock::Duration mapDigSparse() {
+	using namespace ChunkBench;
+	Engine::FlatHashMap<glm::ivec2, MapChunkEdit> edits;
+	std::vector<Engine::byte> encoding;
+	volatile int64_t bytes = 0;
+
+	const auto start = Engine::Clock::now();
+	dig([&](const glm::ivec2 chunkPos, const glm::ivec2 blockIndex) {
+		edits[chunkPos].set(blockIndex, BlockId::Air);
+	}, [&](auto&& chunkAt) {
+		for (auto it = edits.begin(); it != edits.end();) {
+			if (it->second.empty()) {
+				it = edits.erase(it);
+				continue;
+			}
+
+			if (chunkAt(it->first).apply(it->second)) {
+				it->second.encode(encoding);
+				bytes = bytes + encoding.size();
+			}
+
+			it->second.clear();
+			++it;
+		}
+	});
+	const auto stop = Engine::Clock::now();
+	return stop - start;
+}
+
+void chunkMemory() {
+	using namespace ChunkBench;
+	const auto& chunks = corpus();
+	constexpr size_t chunksPerRegion = 16 * 16; // MapRegion::size
+
+	size_t total = 0;
+	size_t byBits[MapChunk::directBits + 1] = {};
+	for (const auto& chunk : chunks) {
+		total += chunk.memoryUsage();
+		++byBits[chunk.bitsPerBlock()];
+	}
+
+	const auto avg = total / chunks.size();
+	const auto dense = sizeof(DenseChunk) + sizeof(MapChunk::solidMask) + sizeof(MapChunk::renderMask);
+	std::cout << "Chunk memory:\n";
+	std::cout << "Dense: " << dense << " bytes/chunk, " << (dense * chunksPerRegion) << " bytes/region\n";
+	std::cout << "Palette: " << avg << " bytes/chunk, " << (avg * chunksPerRegion) << " bytes/region\n";
+	for (size_t i = 0; i < std::size(byBits); ++i) {
+		if (byBits[i]) { std::cout << "  " << i << " bits: " << byBits[i] << " chunks\n"; }
+	}
+	std::cout << "\n";
+}
+
+void chunkCodecs() {
+	using namespace ChunkBench;
+	std::cout << "Chunk codecs (" << denseCorpus().size() << " chunks, " << sizeof(DenseChunk) << " bytes/chunk dense):\n";
+
+	reportCodec("RLE (original)", [](const DenseChunk& chunk, std::vector<Engine::byte>& encoding) {
+		encodeRLEOriginal(chunk, encoding);
+	}, [](const Engine::byte* begin, const Engine::byte* end, DenseChunk& chunk) {
+		decodeRLEOriginal(begin, end, chunk);
+		return true;
+	});
+
+	for (int c = 0; c < static_cast<int>(Game::ChunkCodec::_COUNT); ++c) {
+		const auto codec = static_cast<Game::ChunkCodec>(c);
+		reportCodec(Game::getChunkCodecName(codec), [&](const DenseChunk& chunk, std::vector<Engine::byte>& encoding) {
+			encoding.clear();
+			Game::encodeChunk(codec, chunk.data, encoding);
+		}, [&](const Engine::byte* begin, const Engine::byte* end, DenseChunk& chunk) {
+			return Game::decodeChunk(codec, begin, end, chunk.data);
+		});
+	}
+
+	std::cout << "\n";
+}
@@ -0,0 +1,157 @@
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <iostream>
+#include <algorithm>
+
+#include <Engine/Clock.hpp>
+
+#include <Game/MapChunk.hpp>
+#include <Game/MapGenerator2.hpp>
+
+namespace GeneratorBench {
+	/**
+	 * Chunks from the sky down through the surface and caves.
+	 */
+	template<class Func>
+	void forEachChunk(Func&& func) {
+		for (int x = -8; x < 8; ++x) {
+			for (int y = -8; y < 4; ++y) {
+				func(glm::ivec2{x, y} * Game::MapChunk::size);
+			}
+		}
+	}
+
+	/**
+	 * Single threaded chunks per second for generatorThroughput in a release build.
+	 * Update when the generator is intentionally made slower or faster. Zero to only report the value.
+	 */
+	constexpr double baselineSingle = 3500;
+
+	/**
+	 * The multi threaded rate divided by the single threaded rate times the thread count.
+	 * Used instead of a rate so the baseline doesn't depend on core speed. Zero to only report the value.
+	 * Measured as the best of generatorThroughput's samples with GCC -O2 on a single core machine.
+	 */
+	constexpr double baselineScaling = 1.0;
+
+	/**
+	 * The thread count baselineScaling was measured with.
+	 * Scaling depends on the number of cores, so the multi threaded results are only compared at this count.
+	 */
+	constexpr int baselineThreads = 1;
+
+	/** How far below the baseline a result can be before it is reported as a regression. */
+	constexpr double tolerance = 0.15;
+
+	/**
+	 * Generates every chunk from forEachChunk @p rounds times split between @p threadCount threads.
+	 * @return Chunks per second.
+	 */
+	double chunksPerSecond(const int threadCount, const int rounds) {
+		std::vector<glm::ivec2> chunks;
+		forEachChunk([&](const glm::ivec2 pos) { chunks.push_back(pos); });
+
+		const Game::MapGenerator2 mgen{12345};
+		const auto total = chunks.size() * rounds;
+		std::atomic<size_t> next = 0;
+
+		const auto work = [&]{
+			std::vector<Game::BlockEntityDesc> entData;
+			Game::MapChunk chunk;
+			for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < total;) {
+				entData.clear();
+				mgen.init(chunks[i % chunks.size()], chunk, entData);
+			}
+		};
+
+		std::vector<std::thread> threads;
+		const auto start = Engine::Clock::now();
+		for (int t = 1; t < threadCount; ++t) { threads.emplace_back(work); }
+		work();
+		for (auto& t : threads) { t.join(); }
+		const auto stop = Engine::Clock::now();
+
+		return total / std::chrono::duration<double>{stop - start}.count();
+	}
+
+	/**
+	 * The best of several chunksPerSecond samples. Used so a single slow sample from another process doesn't
+	 * show as a regression.
+	 */
+	double bestChunksPerSecond(const int threadCount, const int rounds) {
+		constexpr int samples = 5;
+		double best = 0;
+		for (int i = 0; i < samples; ++i) {
+			best = std::max(best, chunksPerSecond(threadCount, rounds));
+		}
+		return best;
+	}
+
+	void reportThroughput(const char* name, const double value, const double baseline, const char* unit) {
+		std::cout << name << ": " << value << unit;
+		if (baseline > 0) {
+			const auto ratio = value / baseline;
+			std::cout << " (" << (ratio * 100) << "% of baseline " << baseline << unit << ")";
+			if (ratio < 1 - tolerance) { std::cout << " REGRESSION"; }
+		}
+		std::cout << "\n";
+	}
+}
+
+Engine::Clock::Duration generatorPerBlock() {
+	using namespace GeneratorBench;
+	const Game::MapGenerator2 mgen{12345};
+	Game::MapGenerator2::BlockGenData bgd;
+	volatile int64_t sum = 0;
+
+	const auto start = Engine::Clock::now();
+	forEachChunk([&](const glm::ivec2 pos) {
+		for (int x = 0; x < Game::MapChunk::size.x; ++x) {
+			for (int y = 0; y < Game::MapChunk::size.y; ++y) {
+				bgd.exists = false;
+				sum = sum + mgen.value(pos.x + x, pos.y + y, bgd);
+			}
+		}
+	});
+	const auto stop = Engine::Clock::now();
+	return stop - start;
+}
+
+Engine::Clock::Duration generatorPerChunk() {
+	using namespace GeneratorBench;
+	const Game::MapGenerator2 mgen{12345};
+	std::vector<Game::BlockEntityDesc> entData;
+	Game::MapChunk chunk;
+
+	const auto start = Engine::Clock::now();
+	forEachChunk([&](const glm::ivec2 pos) {
+		entData.clear();
+		mgen.init(pos, chunk, entData);
+	});
+	const auto stop = Engine::Clock::now();
+	return stop - start;
+}
+
+void generatorThroughput() {
+	using namespace GeneratorBench;
+	const int threadCount = std::max(1u, std::thread::hardware_concurrency());
+	constexpr int rounds = 8;
+
+	// Warm up
+	chunksPerSecond(1, 1);
+
+	const auto single = bestChunksPerSecond(1, rounds);
+	const auto multi = bestChunksPerSecond(threadCount, rounds * threadCount);
+	const auto scaling = multi / (single * threadCount);
+	const auto scalingBaseline = threadCount == baselineThreads ? baselineScaling : 0;
+
+	std::cout << "Generator throughput (" << threadCount << " threads):\n";
+	reportThroughput("Single threaded", single, baselineSingle, " chunks/s");
+	reportThroughput("Multi threaded", multi, baselineSingle * scalingBaseline * threadCount, " chunks/s");
+	reportThroughput("Scaling", scaling, scalingBaseline, "");
+	if (threadCount != baselineThreads) {
+		std::cout << "No scaling baseline for " << threadCount << " threads (measured with " << baselineThreads << ")\n";
+	}
+	std::cout << "\n";
+}
@@ -0,0 +1,109 @@
+#include <array>
+#include <vector>
+#include <memory>
+#include <iostream>
+#include <cmath>
+
+#include <Engine/Clock.hpp>
+#include <Engine/ECS/SpatialIndex.hpp>
+
+namespace LagCompBench {
+	constexpr int entityCount = 1024;
+	constexpr int playerCount = 64;
+	constexpr int historySize = 33;
+	constexpr int tickCount = 256;
+	constexpr float hitRadius = 0.5f;
+
+	/**
+	 * Entities moving in circles with a history of their positions.
+	 * Every player attacks every tick with a view delay between 4 and 15 ticks.
+	 * Similar to LagCompensationSystem on a full server.
+	 */
+	class Scene {
+		public:
+			std::array<std::vector<glm::vec2>, historySize> history;
+			std::array<int, playerCount> delays;
+			Engine::ECS::ComponentBitset players;
+			Engine::ECS::ComponentBitset all;
+
+			Scene() {
+				players.set(0);
+				for (int p = 0; p < playerCount; ++p) { delays[p] = 4 + (p * 7) % 12; }
+				for (int t = 0; t < historySize; ++t) { store(t); }
+			}
+
+			void store(const int tick) {
+				auto& positions = history[tick % historySize];
+				positions.resize(entityCount);
+				for (int i = 0; i < entityCount; ++i) {
+					const float a = 0.05f * tick + i;
+					positions[i] = {(i % 64) * 4.0f + 2.0f * std::cos(a), (i / 64) * 4.0f + 2.0f * std::sin(a)};
+				}
+			}
+
+			void build(Engine::ECS::SpatialIndex& index, const int tick) const {
+				Engine::ECS::ComponentBitset comps;
+				index.clear();
+				const auto& positions = history[tick % historySize];
+				for (int i = 0; i < entityCount; ++i) {
+					Engine::ECS::Entity ent;
+					ent.id = static_cast<decltype(ent.id)>(i);
+					ent.gen = 0;
+					index.insert(ent, positions[i], i < playerCount ? players : comps);
+				}
+				index.build();
+			}
+
+			/** The position a player aims at: another player's position as seen at their view tick. */
+			glm::vec2 target(const int p, const int tick) const {
+				return history[tick % historySize][(p + 1) % playerCount];
+			}
+	};
+
+	template<class Query>
+	Engine::Clock::Duration run(Query&& query) {
+		auto scene = std::make_unique<Scene>();
+		Engine::ECS::SpatialIndex::Results results;
+		int hits = 0;
+
+		const auto start = Engine::Clock::now();
+		for (int tick = historySize; tick < historySize + tickCount; ++tick) {
+			scene->store(tick);
+			for (int p = 0; p < playerCount; ++p) {
+				const auto viewTick = tick - scene->delays[p];
+				results.clear();
+				hits += !query(*scene, viewTick, scene->target(p, viewTick), results).empty();
+			}
+		}
+
+		const auto time = Engine::Clock::now() - start;
+		if (hits != playerCount * tickCount) { std::cout << "Unexpected hit count: " << hits << "\n"; }
+		return time;
+	}
+}
+
+Engine::Clock::Duration lagCompRebuildPerQuery() {
+	Engine::ECS::SpatialIndex index;
+	return LagCompBench::run([&](const auto& scene, int viewTick, glm::vec2 pos, auto& results){
+		scene.build(index, viewTick);
+		return index.queryRadius(pos, LagCompBench::hitRadius, scene.players, results);
+	});
+}
+
+Engine::Clock::Duration lagCompCachedPerTick() {
+	// Same as LagCompensationSystem::getIndex
+	struct Frame {
+		int tick = -1;
+		Engine::ECS::SpatialIndex index;
+	};
+
+	std::array<Frame, LagCompBench::historySize> frames;
+	return LagCompBench::run([&](const auto& scene, int viewTick, glm::vec2 pos, auto& results){
+		auto& frame = frames[viewTick % frames.size()];
+		if (frame.tick != viewTick) {
+			scene.build(frame.index, viewTick);
+			frame.tick = viewTick;
+		}
+		return frame.index.queryRadius(pos, LagCompBench::hitRadius, scene.players, results);
+	});
+}
@@ -7,22 +7,60 @@
 #include <Engine/Clock.hpp>
 
 #include "noise.hpp"
+#include "chunk.hpp"
+#include "generator.hpp"
+#include "physics.hpp"
+#include "lagcomp.hpp"
 
-int main(int argc, char* argv[]) {
-	using Seconds = std::chrono::duration<long double, std::ratio<1, 1>>;
-	using Milliseconds = std::chrono::duration<long double, std::milli>;
+namespace {
+	template<class Func>
+	void bench(const char* name, Func&& func) {
+		using Seconds = std::chrono::duration<long double, std::ratio<1, 1>>;
+
+		std::vector<Engine::Clock::Duration> times;
+		times.resize(10);
 
-	std::vector<Engine::Clock::Duration> times;
-	times.resize(10);
+		std::cout << name << ":\n";
+		for (auto& t : times) {
+			t = func();
+			std::cout << "Time: " << Seconds{t}.count() << "\n";
+		}
 
-	for (auto& t : times) {
-		t = noise();
-		std::cout << "Time: " << Seconds{t}.count() << "\n";
+		Engine::Clock::Duration sum = std::accumulate(times.cbegin(), times.cend(), Engine::Clock::Duration{});
+		std::cout << "Avg: " << Seconds{sum / times.size()}.count() << "s\n\n";
 	}
+}
+
+int main(int argc, char* argv[]) {
+	bench("Noise", noise);
+	bench("Noise Worley (batch)", noiseWorleyBatch);
+	bench("Noise OpenSimplex (scalar)", noiseOpenSimplex);
+	bench("Noise OpenSimplex (batch)", noiseOpenSimplexBatch);
+	bench("Noise Simplex 1D (scalar)", noiseSimplex);
+	bench("Noise Simplex 1D (batch)", noiseSimplexBatch);
+
+	bench("Chunk greedy (per block)", chunkGreedyPerBlock);
+	bench("Chunk greedy (bitmask)", chunkGreedyBitmask);
+	bench("Chunk apply (per block)", chunkApplyPerBlock);
+	bench("Chunk apply (sparse)", chunkApplySparse);
+	bench("Map dig (dense edits)", mapDigDense);
+	bench("Map dig (sparse edits)", mapDigSparse);
+	chunkMemory();
+	chunkCodecs();
+
+	bench("Generator (per block)", generatorPerBlock);
+	bench("Generator (per chunk)", generatorPerChunk);
+	generatorThroughput();
 
-	Engine::Clock::Duration sum = std::accumulate(times.cbegin(), times.cend(), Engine::Clock::Duration{});
-	std::cout << "Avg: " << Seconds{sum / times.size()}.count() << "s\n";
+	bench("Physics restore (per body)", physicsRestorePerBody);
+	bench("Physics restore (bulk)", physicsRestoreBulk);
+	bench("Physics selective replay (dynamic)", physicsReplayDynamic);
+	bench("Physics selective replay (kinematic)", physicsReplayKinematic);
+	bench("Physics step dug terrain (single world)", physicsStepSingleWorld);
+	bench("Physics step dug terrain (parallel worlds)", physicsStepParallelWorlds);
 
+	bench("Lag compensation (rebuild per query)", lagCompRebuildPerQuery);
+	bench("Lag compensation (cached per tick)", lagCompCachedPerTick);
 
 	std::cin.get();
 	return 0;
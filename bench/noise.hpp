@@ -1,11 +1,18 @@
 #include <Engine/Clock.hpp>
 #include <Engine/Noise/WorleyNoise.hpp>
+#include <Engine/Noise/OpenSimplexNoise.hpp>
+#include <Engine/Noise/SimplexNoise.hpp>
 
-Engine::Clock::Duration noise() {
-	Engine::Noise::WorleyNoise noise{1645448290048005};
-
+namespace NoiseBench {
 	constexpr int w = 1024;
 	constexpr int h = w;
+	constexpr float openSimplexStep = 0.05f;
+	constexpr float simplexStep = 0.01f;
+}
+
+Engine::Clock::Duration noise() {
+	using namespace NoiseBench;
+	Engine::Noise::WorleyNoise noise{1645448290048005};
 
 	auto data = new float[w][h];
 
@@ -20,3 +27,80 @@ Engine::Clock::Duration noise() {
 	delete[] data;
 	return stop - start;
 }
+
+Engine::Clock::Duration noiseWorleyBatch() {
+	using namespace NoiseBench;
+	Engine::Noise::WorleyNoise noise{1645448290048005};
+
+	auto data = new float[w][h];
+
+	const auto start = Engine::Clock::now();
+	noise.valueF2F1Grid({0, 0}, {1, 1}, {w, h}, &data[0][0]);
+	const auto stop = Engine::Clock::now();
+	delete[] data;
+	return stop - start;
+}
+
+Engine::Clock::Duration noiseOpenSimplex() {
+	using namespace NoiseBench;
+	Engine::Noise::OpenSimplexNoise noise{1645448290048005};
+
+	auto data = new float[w][h];
+
+	const auto start = Engine::Clock::now();
+	for (int x = 0; x < w; ++x) {
+		for (int y = 0; y < h; ++y) {
+			data[x][y] = noise.value(x * openSimplexStep, y * openSimplexStep);
+		}
+	}
+	const auto stop = Engine::Clock::now();
+	delete[] data;
+	return stop - start;
+}
+
+Engine::Clock::Duration noiseOpenSimplexBatch() {
+	using namespace NoiseBench;
+	Engine::Noise::OpenSimplexNoise noise{1645448290048005};
+
+	auto data = new float[w][h];
+
+	const auto start = Engine::Clock::now();
+	noise.valueGrid({0, 0}, {openSimplexStep, openSimplexStep}, {w, h}, &data[0][0]);
+	const auto stop = Engine::Clock::now();
+	delete[] data;
+	return stop - start;
+}
+
+Engine::Clock::Duration noiseSimplex() {
+	using namespace NoiseBench;
+	Engine::Noise::SimplexNoise noise{1645448290048005};
+
+	auto xs = new float[w * h];
+	auto data = new float[w * h];
+	for (int i = 0; i < w * h; ++i) { xs[i] = i * simplexStep; }
+
+	const auto start = Engine::Clock::now();
+	for (int i = 0; i < w * h; ++i) {
+		data[i] = noise.value1D(xs[i]);
+	}
+	const auto stop = Engine::Clock::now();
+	delete[] xs;
+	delete[] data;
+	return stop - start;
+}
+
+Engine::Clock::Duration noiseSimplexBatch() {
+	using namespace NoiseBench;
+	Engine::Noise::SimplexNoise noise{1645448290048005};
+
+	auto xs = new float[w * h];
+	auto data = new float[w * h];
+	for (int i = 0; i < w * h; ++i) { xs[i] = i * simplexStep; }
+
+	const auto start = Engine::Clock::now();
+	noise.value1DN(xs, data, w * h);
+	const auto stop = Engine::Clock::now();
+	delete[] xs;
+	delete[] data;
+	return stop - start;
+}
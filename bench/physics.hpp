@@ -0,0 +1,301 @@
+#include <vector>
+#include <memory>
+#include <thread>
+#include <algorithm>
+
+#include <Engine/Clock.hpp>
+#include <Engine/WorkerPool.hpp>
+
+#include <Game/PhysicsState.hpp>
+#include <Game/MapChunk.hpp>
+#include <Game/MapGenerator2.hpp>
+
+namespace PhysicsBench {
+	constexpr int bodyCount = 512;
+	constexpr int awakeEvery = 10;
+	constexpr int rollbackDepth = 8;
+	constexpr int rollbackCount = 256;
+	constexpr float timeStep = 1.0f / 64;
+
+	/**
+	 * A grid of circles resting on the ground where only every `awakeEvery` body is kept moving.
+	 * Similar to a client with many idle entities when a correction for one arrives.
+	 */
+	class Scene {
+		public:
+			b2World world{{0.0f, -10.0f}};
+			std::vector<b2Body*> bodies;
+
+			Scene() {
+				b2BodyDef groundDef;
+				groundDef.position = {0.0f, -1.0f};
+				b2PolygonShape groundShape;
+				groundShape.SetAsBox(10000.0f, 1.0f);
+				world.CreateBody(&groundDef)->CreateFixture(&groundShape, 0.0f);
+
+				b2CircleShape shape;
+				shape.m_radius = 0.49f;
+
+				for (int i = 0; i < bodyCount; ++i) {
+					b2BodyDef bodyDef;
+					bodyDef.type = b2_dynamicBody;
+					bodyDef.position = {(i % 128) * 2.0f, 0.5f + (i / 128) * 1.0f};
+					bodyDef.linearDamping = 10.0f;
+					bodyDef.fixedRotation = true;
+
+					auto* body = bodies.emplace_back(world.CreateBody(&bodyDef));
+					body->CreateFixture(&shape, 1.0f);
+				}
+
+				for (int i = 0; i < 256; ++i) { step(false); }
+			}
+
+			void step(bool active = true) {
+				if (active) {
+					for (int i = 0; i < bodyCount; i += awakeEvery) {
+						bodies[i]->ApplyLinearImpulseToCenter({0.5f, 0.0f}, true);
+					}
+				}
+				world.Step(timeStep, 8, 3);
+			}
+	};
+
+	constexpr int regionCount = 8;
+	constexpr int bodiesPerRegion = 64;
+	constexpr int stressSteps = 256;
+
+	/**
+	 * Groups of circles moving around rooms dug out of generated terrain.
+	 * Each region is in its own chunk column with untouched terrain between so regions never interact.
+	 * Regions are split evenly over `worldCount` worlds.
+	 */
+	class DugScene {
+		public:
+			std::vector<std::unique_ptr<b2World>> worlds;
+			std::vector<b2Body*> bodies;
+
+			DugScene(const int worldCount) {
+				using Game::MapChunk;
+
+				for (int i = 0; i < worldCount; ++i) {
+					worlds.push_back(std::make_unique<b2World>(b2Vec2{0.0f, -10.0f}));
+				}
+
+				const Game::MapGenerator2 mgen{12345};
+				std::vector<Game::BlockEntityDesc> entData;
+				b2PolygonShape shape;
+				b2CircleShape circle;
+				circle.m_radius = 0.25f;
+
+				for (int r = 0; r < regionCount; ++r) {
+					auto& world = *worlds[r % worldCount];
+					const glm::ivec2 chunkPos = {r * 2, -2};
+					const glm::ivec2 blockPos = chunkPos * MapChunk::size;
+
+					MapChunk chunk;
+					mgen.init(blockPos, chunk, entData);
+
+					// A room with an uneven floor and a shaft up through the top of the chunk
+					for (int x = 4; x < 60; ++x) {
+						for (int y = 8 + (x * 7) % 5; y < 48; ++y) {
+							chunk.setBlock({x, y}, Game::BlockId::Air);
+						}
+					}
+					for (int x = 28; x < 36; ++x) {
+						for (int y = 48; y < MapChunk::size.y; ++y) {
+							chunk.setBlock({x, y}, Game::BlockId::Air);
+						}
+					}
+
+					// Same as MapSystem::buildActiveChunkData
+					b2BodyDef groundDef;
+					groundDef.position = MapChunk::blockSize * b2Vec2{static_cast<float>(blockPos.x), static_cast<float>(blockPos.y)};
+					auto* ground = world.CreateBody(&groundDef);
+					chunk.forEachSolidArea([&](const auto& begin, const auto& end){
+						const auto halfSize = MapChunk::blockSize * 0.5f * b2Vec2{static_cast<float>(end.x - begin.x), static_cast<float>(end.y - begin.y)};
+						const auto center = MapChunk::blockSize * b2Vec2{static_cast<float>(begin.x), static_cast<float>(begin.y)} + halfSize;
+						shape.SetAsBox(halfSize.x, halfSize.y, center, 0.0f);
+						ground->CreateFixture(&shape, 0.0f);
+					});
+
+					for (int i = 0; i < bodiesPerRegion; ++i) {
+						b2BodyDef bodyDef;
+						bodyDef.type = b2_dynamicBody;
+						bodyDef.position = groundDef.position + b2Vec2{1.75f + (i % 8) * 1.5f, 4.0f + (i / 8) * 1.0f};
+						bodyDef.fixedRotation = true;
+
+						auto* body = bodies.emplace_back(world.CreateBody(&bodyDef));
+						body->CreateFixture(&circle, 1.0f);
+					}
+				}
+			}
+
+			void step(Engine::WorkerPool& pool, const int i) {
+				const float dir = (i % 64) < 32 ? 2.0f : -2.0f;
+				for (auto* body : bodies) {
+					body->ApplyForceToCenter({dir, 0.0f}, true);
+				}
+
+				pool.forEach(static_cast<int>(worlds.size()), [&](int w){
+					worlds[w]->Step(timeStep, 8, 3);
+				});
+			}
+	};
+
+	inline Engine::Clock::Duration stress(const int worldCount, const int threadCount) {
+		auto scene = std::make_unique<DugScene>(worldCount);
+		Engine::WorkerPool pool{threadCount};
+
+		for (int i = 0; i < 64; ++i) { scene->step(pool, i); }
+
+		const auto start = Engine::Clock::now();
+		for (int i = 0; i < stressSteps; ++i) { scene->step(pool, i); }
+		return Engine::Clock::now() - start;
+	}
+
+	template<class Restore>
+	Engine::Clock::Duration rollback(Restore&& restore) {
+		auto scene = std::make_unique<Scene>();
+		Game::PhysicsState state;
+		Engine::Clock::Duration total = {};
+
+		for (int i = 0; i < rollbackCount; ++i) {
+			state.store(scene->world);
+			for (int j = 0; j < rollbackDepth; ++j) { scene->step(); }
+
+			const auto start = Engine::Clock::now();
+			restore(scene->world, state);
+			total += Engine::Clock::now() - start;
+		}
+
+		return total;
+	}
+
+	/** The bodies resimulated in selectiveReplay. All other bodies are unaffected. */
+	constexpr int affectedCount = 8;
+
+	struct Recorded {
+		b2Transform trans;
+		b2Vec2 vel;
+		float angVel;
+	};
+
+	/**
+	 * Rolls back the first `affectedCount` bodies and replays `rollbackDepth` steps.
+	 * @param replay Called with the scene and the recorded state of every body at the start of each step, including
+	 *        the state the replay should end at. Must leave unaffected bodies at their final recorded state.
+	 */
+	template<class Replay>
+	Engine::Clock::Duration selectiveReplay(Replay&& replay) {
+		auto scene = std::make_unique<Scene>();
+		Game::PhysicsState state;
+		std::vector<std::vector<Recorded>> history(rollbackDepth + 1);
+		Engine::Clock::Duration total = {};
+
+		for (int i = 0; i < rollbackCount; ++i) {
+			state.store(scene->world);
+			for (int j = 0; j <= rollbackDepth; ++j) {
+				if (j != 0) { scene->step(); }
+				history[j].clear();
+				for (const auto* body : scene->bodies) {
+					history[j].push_back({body->GetTransform(), body->GetLinearVelocity(), body->GetAngularVelocity()});
+				}
+			}
+
+			state.load(scene->world, [&](const b2Body& body){
+				return std::find(scene->bodies.begin(), scene->bodies.begin() + affectedCount, &body) != scene->bodies.begin() + affectedCount;
+			});
+
+			const auto start = Engine::Clock::now();
+			replay(*scene, history);
+			total += Engine::Clock::now() - start;
+		}
+
+		return total;
+	}
+
+	void setRecorded(b2Body& body, const Recorded& recorded) {
+		const auto& trans = body.GetTransform();
+		if (trans.p != recorded.trans.p || trans.q.s != recorded.trans.q.s || trans.q.c != recorded.trans.q.c) {
+			body.SetTransform(recorded.trans.p, recorded.trans.q.GetAngle());
+		}
+		body.SetLinearVelocity(recorded.vel);
+		body.SetAngularVelocity(recorded.angVel);
+	}
+}
+
+Engine::Clock::Duration physicsRestorePerBody() {
+	return PhysicsBench::rollback([](b2World& world, const Game::PhysicsState& state){
+		// Equivalent to PhysicsBodyComponent::operator= for every snapshot component
+		for (const auto& body : state.getBodies()) {
+			body.body->SetTransform(body.pos, body.angle);
+			body.body->SetLinearVelocity(body.vel);
+			body.body->SetAngularVelocity(body.angVel);
+		}
+	});
+}
+
+Engine::Clock::Duration physicsRestoreBulk() {
+	return PhysicsBench::rollback([](b2World& world, const Game::PhysicsState& state){
+		state.load(world);
+	});
+}
+
+Engine::Clock::Duration physicsReplayDynamic() {
+	using namespace PhysicsBench;
+	return selectiveReplay([](Scene& scene, const std::vector<std::vector<Recorded>>& history){
+		// Unaffected bodies are still solved and have their recorded state set each step
+		for (int j = 0; j < rollbackDepth; ++j) {
+			for (int k = affectedCount; k < bodyCount; ++k) {
+				setRecorded(*scene.bodies[k], history[j][k]);
+			}
+			scene.step();
+		}
+
+		for (int k = affectedCount; k < bodyCount; ++k) {
+			setRecorded(*scene.bodies[k], history[rollbackDepth][k]);
+		}
+	});
+}
+
+Engine::Clock::Duration physicsReplayKinematic() {
+	using namespace PhysicsBench;
+	return selectiveReplay([](Scene& scene, const std::vector<std::vector<Recorded>>& history){
+		// Same as PhysicsSystem::postLoadSnapshot, preTick and postRollback
+		for (int k = affectedCount; k < bodyCount; ++k) {
+			auto& body = *scene.bodies[k];
+			const auto awake = body.IsAwake();
+			body.SetType(b2_kinematicBody);
+			body.SetAwake(awake);
+			setRecorded(body, history[0][k]);
+		}
+
+		for (int j = 0; j < rollbackDepth; ++j) {
+			for (int k = affectedCount; k < bodyCount; ++k) {
+				auto& body = *scene.bodies[k];
+				const auto& trans = body.GetTransform();
+				const auto& target = history[j + 1][k].trans;
+				body.SetLinearVelocity((1.0f / timeStep) * (target.p - trans.p));
+				body.SetAngularVelocity((1.0f / timeStep) * b2MulT(trans.q, target.q).GetAngle());
+			}
+			scene.step();
+		}
+
+		for (int k = affectedCount; k < bodyCount; ++k) {
+			auto& body = *scene.bodies[k];
+			const auto awake = body.IsAwake();
+			body.SetType(b2_dynamicBody);
+			setRecorded(body, history[rollbackDepth][k]);
+			body.SetAwake(awake);
+		}
+	});
+}
+
+Engine::Clock::Duration physicsStepSingleWorld() {
+	return PhysicsBench::stress(1, 0);
+}
+
+Engine::Clock::Duration physicsStepParallelWorlds() {
+	const int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	return PhysicsBench::stress(PhysicsBench::regionCount, threads - 1);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+// Engine
+#include <Engine/Engine.hpp>
+
+
+namespace Engine::CPU {
+	/**
+	 * Instruction set extensions we have optimized code paths for.
+	 * Detected once at startup. All x64 processors support at least SSE2.
+	 */
+	class Features {
+		public:
+			bool sse41 = false;
+			bool avx2 = false;
+	};
+
+	/**
+	 * Gets the instruction set extensions supported by the current processor and OS.
+	 */
+	[[nodiscard]]
+	const Features& features() noexcept;
+
+	[[nodiscard]]
+	ENGINE_INLINE inline bool hasSSE41() noexcept { return features().sse41; }
+
+	[[nodiscard]]
+	ENGINE_INLINE inline bool hasAVX2() noexcept { return features().avx2; }
+}
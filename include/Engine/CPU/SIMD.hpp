@@ -0,0 +1,151 @@
+#pragma once
+
+// STD
+#include <immintrin.h>
+
+// Engine
+#include <Engine/Engine.hpp>
+
+
+namespace Engine::CPU {
+	/**
+	 * Thin wrappers around the SIMD instructions used by our vectorized algorithms.
+	 * This allows an algorithm to be written once and instantiated for each instruction set.
+	 * Check hasAVX2, hasSSE41, etc. before using a type.
+	 *
+	 * Every float operation is a single IEEE operation per lane. Code that performs the
+	 * same operations in the same order as a scalar version gives bit identical results.
+	 */
+	class AVX2 {
+		public:
+			using FloatV = __m256;
+			using IntV = __m256i;
+			constexpr static int32 width = 8;
+
+			[[nodiscard]] ENGINE_INLINE static FloatV load(const float32* p) noexcept { return _mm256_loadu_ps(p); }
+			ENGINE_INLINE static void store(float32* p, const FloatV v) noexcept { _mm256_storeu_ps(p, v); }
+
+			[[nodiscard]] ENGINE_INLINE static FloatV setf(const float32 v) noexcept { return _mm256_set1_ps(v); }
+			[[nodiscard]] ENGINE_INLINE static IntV seti(const int32 v) noexcept { return _mm256_set1_epi32(v); }
+
+			[[nodiscard]] ENGINE_INLINE static FloatV add(const FloatV a, const FloatV b) noexcept { return _mm256_add_ps(a, b); }
+			[[nodiscard]] ENGINE_INLINE static FloatV sub(const FloatV a, const FloatV b) noexcept { return _mm256_sub_ps(a, b); }
+			[[nodiscard]] ENGINE_INLINE static FloatV mul(const FloatV a, const FloatV b) noexcept { return _mm256_mul_ps(a, b); }
+			[[nodiscard]] ENGINE_INLINE static FloatV min(const FloatV a, const FloatV b) noexcept { return _mm256_min_ps(a, b); }
+			[[nodiscard]] ENGINE_INLINE static FloatV max(const FloatV a, const FloatV b) noexcept { return _mm256_max_ps(a, b); }
+
+			[[nodiscard]] ENGINE_INLINE static IntV add(const IntV a, const IntV b) noexcept { return _mm256_add_epi32(a, b); }
+			[[nodiscard]] ENGINE_INLINE static IntV sub(const IntV a, const IntV b) noexcept { return _mm256_sub_epi32(a, b); }
+
+			[[nodiscard]] ENGINE_INLINE static FloatV bitAnd(const FloatV a, const FloatV b) noexcept { return _mm256_and_ps(a, b); }
+			[[nodiscard]] ENGINE_INLINE static FloatV bitOr(const FloatV a, const FloatV b) noexcept { return _mm256_or_ps(a, b); }
+			[[nodiscard]] ENGINE_INLINE static FloatV bitXor(const FloatV a, const FloatV b) noexcept { return _mm256_xor_ps(a, b); }
+			[[nodiscard]] ENGINE_INLINE static IntV bitAnd(const IntV a, const IntV b) noexcept { return _mm256_and_si256(a, b); }
+
+			template<int N>
+			[[nodiscard]] ENGINE_INLINE static IntV shiftLeft(const IntV a) noexcept { return _mm256_slli_epi32(a, N); }
+
+			template<int N>
+			[[nodiscard]] ENGINE_INLINE static IntV shiftRight(const IntV a) noexcept { return _mm256_srli_epi32(a, N); }
+
+			[[nodiscard]] ENGINE_INLINE static FloatV cmpLT(const FloatV a, const FloatV b) noexcept { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+			[[nodiscard]] ENGINE_INLINE static FloatV cmpLE(const FloatV a, const FloatV b) noexcept { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+			[[nodiscard]] ENGINE_INLINE static FloatV cmpGT(const FloatV a, const FloatV b) noexcept { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+			[[nodiscard]] ENGINE_INLINE static FloatV cmpEq(const IntV a, const IntV b) noexcept { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)); }
+
+			/** Selects @p b where @p mask is set and @p a otherwise. */
+			[[nodiscard]] ENGINE_INLINE static FloatV select(const FloatV a, const FloatV b, const FloatV mask) noexcept { return _mm256_blendv_ps(a, b, mask); }
+			[[nodiscard]] ENGINE_INLINE static IntV select(const IntV a, const IntV b, const FloatV mask) noexcept { return _mm256_blendv_epi8(a, b, _mm256_castps_si256(mask)); }
+
+			[[nodiscard]] ENGINE_INLINE static FloatV toFloat(const IntV a) noexcept { return _mm256_cvtepi32_ps(a); }
+			[[nodiscard]] ENGINE_INLINE static IntV truncate(const FloatV a) noexcept { return _mm256_cvttps_epi32(a); }
+			[[nodiscard]] ENGINE_INLINE static IntV asInt(const FloatV a) noexcept { return _mm256_castps_si256(a); }
+			[[nodiscard]] ENGINE_INLINE static FloatV asFloat(const IntV a) noexcept { return _mm256_castsi256_ps(a); }
+
+			/** Loads `table[idx]` for each lane. */
+			[[nodiscard]] ENGINE_INLINE static IntV gather(const int32* table, const IntV idx) noexcept { return _mm256_i32gather_epi32(table, idx, 4); }
+
+			/** Loads `table[idx]` for each lane. Indices must be in `[0, 8)`. */
+			[[nodiscard]] ENGINE_INLINE static FloatV lookup8(const float32* table, const IntV idx) noexcept {
+				return _mm256_permutevar8x32_ps(_mm256_loadu_ps(table), idx);
+			}
+	};
+
+	/** @see AVX2 */
+	class SSE41 {
+		public:
+			using FloatV = __m128;
+			using IntV = __m128i;
+			constexpr static int32 width = 4;
+
+			[[nodiscard]] ENGINE_INLINE static FloatV load(const float32* p) noexcept { return _mm_loadu_ps(p); }
+			ENGINE_INLINE static void store(float32* p, const FloatV v) noexcept { _mm_storeu_ps(p, v); }
+
+			[[nodiscard]] ENGINE_INLINE static FloatV setf(const float32 v) noexcept { return _mm_set1_ps(v); }
+			[[nodiscard]] ENGINE_INLINE static IntV seti(const int32 v) noexcept { return _mm_set1_epi32(v); }
+
+			[[nodiscard]] ENGINE_INLINE static FloatV add(const FloatV a, const FloatV b) noexcept { return _mm_add_ps(a, b); }
+			[[nodiscard]] ENGINE_INLINE static FloatV sub(const FloatV a, const FloatV b) noexcept { return _mm_sub_ps(a, b); }
+			[[nodiscard]] ENGINE_INLINE static FloatV mul(const FloatV a, const FloatV b) noexcept { return _mm_mul_ps(a, b); }
+			[[nodiscard]] ENGINE_INLINE static FloatV min(const FloatV a, const FloatV b) noexcept { return _mm_min_ps(a, b); }
+			[[nodiscard]] ENGINE_INLINE static FloatV max(const FloatV a, const FloatV b) noexcept { return _mm_max_ps(a, b); }
+
+			[[nodiscard]] ENGINE_INLINE static IntV add(const IntV a, const IntV b) noexcept { return _mm_add_epi32(a, b); }
+			[[nodiscard]] ENGINE_INLINE static IntV sub(const IntV a, const IntV b) noexcept { return _mm_sub_epi32(a, b); }
+
+			[[nodiscard]] ENGINE_INLINE static FloatV bitAnd(const FloatV a, const FloatV b) noexcept { return _mm_and_ps(a, b); }
+			[[nodiscard]] ENGINE_INLINE static FloatV bitOr(const FloatV a, const FloatV b) noexcept { return _mm_or_ps(a, b); }
+			[[nodiscard]] ENGINE_INLINE static FloatV bitXor(const FloatV a, const FloatV b) noexcept { return _mm_xor_ps(a, b); }
+			[[nodiscard]] ENGINE_INLINE static IntV bitAnd(const IntV a, const IntV b) noexcept { return _mm_and_si128(a, b); }
+
+			template<int N>
+			[[nodiscard]] ENGINE_INLINE static IntV shiftLeft(const IntV a) noexcept { return _mm_slli_epi32(a, N); }
+
+			template<int N>
+			[[nodiscard]] ENGINE_INLINE static IntV shiftRight(const IntV a) noexcept { return _mm_srli_epi32(a, N); }
+
+			[[nodiscard]] ENGINE_INLINE static FloatV cmpLT(const FloatV a, const FloatV b) noexcept { return _mm_cmplt_ps(a, b); }
+			[[nodiscard]] ENGINE_INLINE static FloatV cmpLE(const FloatV a, const FloatV b) noexcept { return _mm_cmple_ps(a, b); }
+			[[nodiscard]] ENGINE_INLINE static FloatV cmpGT(const FloatV a, const FloatV b) noexcept { return _mm_cmpgt_ps(a, b); }
+			[[nodiscard]] ENGINE_INLINE static FloatV cmpEq(const IntV a, const IntV b) noexcept { return _mm_castsi128_ps(_mm_cmpeq_epi32(a, b)); }
+
+			/** Selects @p b where @p mask is set and @p a otherwise. */
+			[[nodiscard]] ENGINE_INLINE static FloatV select(const FloatV a, const FloatV b, const FloatV mask) noexcept { return _mm_blendv_ps(a, b, mask); }
+			[[nodiscard]] ENGINE_INLINE static IntV select(const IntV a, const IntV b, const FloatV mask) noexcept { return _mm_blendv_epi8(a, b, _mm_castps_si128(mask)); }
+
+			[[nodiscard]] ENGINE_INLINE static FloatV toFloat(const IntV a) noexcept { return _mm_cvtepi32_ps(a); }
+			[[nodiscard]] ENGINE_INLINE static IntV truncate(const FloatV a) noexcept { return _mm_cvttps_epi32(a); }
+			[[nodiscard]] ENGINE_INLINE static IntV asInt(const FloatV a) noexcept { return _mm_castps_si128(a); }
+			[[nodiscard]] ENGINE_INLINE static FloatV asFloat(const IntV a) noexcept { return _mm_castsi128_ps(a); }
+
+			/** Loads `table[idx]` for each lane. SSE has no gather instruction so this is done per lane. */
+			[[nodiscard]] ENGINE_INLINE static IntV gather(const int32* table, const IntV idx) noexcept {
+				return _mm_setr_epi32(
+					table[_mm_extract_epi32(idx, 0)],
+					table[_mm_extract_epi32(idx, 1)],
+					table[_mm_extract_epi32(idx, 2)],
+					table[_mm_extract_epi32(idx, 3)]
+				);
+			}
+
+			/** Loads `table[idx]` for each lane. Indices must be in `[0, 8)`. */
+			[[nodiscard]] ENGINE_INLINE static FloatV lookup8(const float32* table, const IntV idx) noexcept {
+				return _mm_setr_ps(
+					table[_mm_extract_epi32(idx, 0)],
+					table[_mm_extract_epi32(idx, 1)],
+					table[_mm_extract_epi32(idx, 2)],
+					table[_mm_extract_epi32(idx, 3)]
+				);
+			}
+	};
+
+	/**
+	 * Vectorized version of Engine::Noise::floorTo.
+	 */
+	template<class SIMD>
+	[[nodiscard]] ENGINE_INLINE typename SIMD::IntV floorToInt(const typename SIMD::FloatV v) noexcept {
+		const auto t = SIMD::truncate(v);
+		const auto lt = SIMD::cmpLT(v, SIMD::toFloat(t));
+		return SIMD::add(t, SIMD::asInt(lt)); // lt is -1 where set
+	}
+}
@@ -0,0 +1,282 @@
+#pragma once
+
+// STD
+#include <algorithm>
+#include <limits>
+#include <span>
+#include <vector>
+
+// GLM
+#include <glm/vec2.hpp>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+// Engine
+#include <Engine/ECS/Common.hpp>
+
+
+namespace Engine::ECS {
+	/**
+	 * A uniform grid over entity positions for area and nearest queries.
+	 *
+	 * Entities are stored as points along with their component bitset so that queries can be filtered without a World.
+	 * An entity may also have bounds for overlap queries. It is still placed in the cell of its point and overlap queries
+	 * search further by the largest distance any bounds extend from their point, so one very large entity slows every overlap query.
+	 * Entries are sorted by cell, row major, so that each row of cells covered by a query is one contiguous range found by binary search.
+	 * No hash map or per cell storage is needed and an empty index costs nothing.
+	 *
+	 * The index is rebuilt rather than updated: call clear, insert each entity, then build.
+	 * Queries are only valid after build and are const so they may be run from multiple threads given separate Results.
+	 */
+	class SpatialIndex {
+		public:
+			/**
+			 * Storage for the results of a batch of queries.
+			 * Each query appends one result which can be accessed by index after the batch has completed.
+			 */
+			class Results {
+				private:
+					friend class SpatialIndex;
+					std::vector<Entity> ents;
+					std::vector<int32> ends;
+
+					/** Scratch storage for nearest queries */
+					std::vector<std::pair<float32, int32>> nearest;
+
+				public:
+					ENGINE_INLINE void clear() noexcept {
+						ents.clear();
+						ends.clear();
+					}
+
+					/**
+					 * Gets the number of queries run.
+					 */
+					[[nodiscard]]
+					ENGINE_INLINE int32 size() const noexcept { return static_cast<int32>(ends.size()); }
+
+					/**
+					 * Gets the entities found by the @p i'th query.
+					 */
+					[[nodiscard]]
+					ENGINE_INLINE std::span<const Entity> operator[](const int32 i) const noexcept {
+						const auto begin = i == 0 ? 0 : ends[i - 1];
+						return {ents.data() + begin, ents.data() + ends[i]};
+					}
+
+				private:
+					ENGINE_INLINE std::span<const Entity> close() {
+						ends.push_back(static_cast<int32>(ents.size()));
+						return (*this)[size() - 1];
+					}
+			};
+
+		private:
+			struct Item {
+				uint64 key;
+				glm::vec2 pos;
+				glm::vec2 min;
+				glm::vec2 max;
+				Entity ent;
+				ComponentBitset comps;
+			};
+
+			float32 cellSize;
+			float32 invCellSize;
+
+			/** Sorted by key after build. */
+			std::vector<Item> items;
+
+			/** The key of each item. Kept separate from `items` so binary searches touch as little memory as possible. */
+			std::vector<uint64> keys;
+
+			/** The cells covered by all items. Used to clamp queries. */
+			glm::ivec2 minCell = {};
+			glm::ivec2 maxCell = {};
+
+			/** The furthest any item's bounds extend from its position. */
+			glm::vec2 reach = {};
+
+		public:
+			/**
+			 * @param cellSize The size of each cell. Should be similar to the size of common queries.
+			 */
+			explicit SpatialIndex(const float32 cellSize = 8.0f)
+				: cellSize{cellSize}
+				, invCellSize{1.0f / cellSize} {
+			}
+
+			ENGINE_INLINE void clear() noexcept {
+				items.clear();
+				keys.clear();
+			}
+
+			ENGINE_INLINE void insert(const Entity ent, const glm::vec2 pos, const ComponentBitset& comps) {
+				items.push_back({.key = 0, .pos = pos, .min = pos, .max = pos, .ent = ent, .comps = comps});
+			}
+
+			/**
+			 * Inserts an entity with bounds. The bounds are only used by queryOverlap.
+			 * @param min,max The bounds of the entity. Should contain @p pos.
+			 */
+			ENGINE_INLINE void insert(const Entity ent, const glm::vec2 pos, const glm::vec2 min, const glm::vec2 max, const ComponentBitset& comps) {
+				items.push_back({.key = 0, .pos = pos, .min = min, .max = max, .ent = ent, .comps = comps});
+			}
+
+			/**
+			 * Sorts the inserted entities for querying.
+			 * Entities in the same cell are ordered by id so results do not depend on insertion order.
+			 */
+			void build() {
+				minCell = glm::ivec2{std::numeric_limits<int32>::max()};
+				maxCell = glm::ivec2{std::numeric_limits<int32>::min()};
+				reach = {};
+
+				for (auto& item : items) {
+					const auto cell = toCell(item.pos);
+					item.key = toKey(cell);
+					minCell = glm::min(minCell, cell);
+					maxCell = glm::max(maxCell, cell);
+					reach = glm::max(reach, glm::max(item.pos - item.min, item.max - item.pos));
+				}
+
+				std::sort(items.begin(), items.end(), [](const Item& a, const Item& b){
+					if (a.key != b.key) { return a.key < b.key; }
+					return a.ent.id < b.ent.id;
+				});
+
+				keys.resize(items.size());
+				for (size_t i = 0; i < items.size(); ++i) {
+					keys[i] = items[i].key;
+				}
+			}
+
+			[[nodiscard]]
+			ENGINE_INLINE int32 size() const noexcept { return static_cast<int32>(items.size()); }
+
+			[[nodiscard]]
+			ENGINE_INLINE float32 getCellSize() const noexcept { return cellSize; }
+
+			/**
+			 * Finds the entities within an axis aligned box that have at least the components in @p with.
+			 * @return The entities found. Only valid until the next query using @p out.
+			 */
+			std::span<const Entity> queryAABB(const glm::vec2 min, const glm::vec2 max, const ComponentBitset& with, Results& out) const {
+				forEachInBox(min, max, [&](const Item& item) ENGINE_INLINE {
+					if (item.pos.x < min.x || item.pos.x > max.x || item.pos.y < min.y || item.pos.y > max.y) { return; }
+					if (!matches(item, with)) { return; }
+					out.ents.push_back(item.ent);
+				});
+				return out.close();
+			}
+
+			/**
+			 * Finds the entities whose bounds overlap an axis aligned box that have at least the components in @p with.
+			 * Entities inserted without bounds are treated as points.
+			 * @return The entities found. Only valid until the next query using @p out.
+			 */
+			std::span<const Entity> queryOverlap(const glm::vec2 min, const glm::vec2 max, const ComponentBitset& with, Results& out) const {
+				forEachInBox(min - reach, max + reach, [&](const Item& item) ENGINE_INLINE {
+					if (item.max.x < min.x || item.min.x > max.x || item.max.y < min.y || item.min.y > max.y) { return; }
+					if (!matches(item, with)) { return; }
+					out.ents.push_back(item.ent);
+				});
+				return out.close();
+			}
+
+			/**
+			 * Finds the entities within @p radius of @p center that have at least the components in @p with.
+			 * @return The entities found. Only valid until the next query using @p out.
+			 */
+			std::span<const Entity> queryRadius(const glm::vec2 center, const float32 radius, const ComponentBitset& with, Results& out) const {
+				const auto r2 = radius * radius;
+				forEachInBox(center - radius, center + radius, [&](const Item& item) ENGINE_INLINE {
+					const auto d = item.pos - center;
+					if (glm::dot(d, d) > r2) { return; }
+					if (!matches(item, with)) { return; }
+					out.ents.push_back(item.ent);
+				});
+				return out.close();
+			}
+
+			/**
+			 * Finds up to @p k entities nearest to @p center within @p maxRange that have at least the components in @p with.
+			 * Ties are broken by entity id.
+			 * @return The entities found, nearest first. Only valid until the next query using @p out.
+			 */
+			std::span<const Entity> queryNearest(const glm::vec2 center, const int32 k, const float32 maxRange, const ComponentBitset& with, Results& out) const {
+				auto& nearest = out.nearest;
+				if (k <= 0) { return out.close(); }
+
+				// Search an increasing radius. Once there are k results inside the radius nothing outside of it can be closer.
+				for (float32 range = std::min(cellSize, maxRange);; range = std::min(range * 2.0f, maxRange)) {
+					const auto r2 = range * range;
+					nearest.clear();
+
+					forEachInBox(center - range, center + range, [&](const Item& item) ENGINE_INLINE {
+						const auto d = item.pos - center;
+						const auto d2 = glm::dot(d, d);
+						if (d2 > r2) { return; }
+						if (!matches(item, with)) { return; }
+						nearest.emplace_back(d2, static_cast<int32>(&item - items.data()));
+					});
+
+					if (static_cast<int32>(nearest.size()) >= k || range >= maxRange) { break; }
+				}
+
+				const auto count = std::min(k, static_cast<int32>(nearest.size()));
+				std::partial_sort(nearest.begin(), nearest.begin() + count, nearest.end(), [&](const auto& a, const auto& b){
+					if (a.first != b.first) { return a.first < b.first; }
+					return items[a.second].ent.id < items[b.second].ent.id;
+				});
+
+				for (int32 i = 0; i < count; ++i) {
+					out.ents.push_back(items[nearest[i].second].ent);
+				}
+
+				return out.close();
+			}
+
+		private:
+			[[nodiscard]]
+			ENGINE_INLINE glm::ivec2 toCell(const glm::vec2 pos) const noexcept {
+				return glm::ivec2{glm::floor(pos * invCellSize)};
+			}
+
+			/**
+			 * Gets a key that sorts cells by row and then by column.
+			 */
+			[[nodiscard]]
+			ENGINE_INLINE constexpr static uint64 toKey(const glm::ivec2 cell) noexcept {
+				// Flip the sign bit so that negative values sort before positive ones
+				const auto x = static_cast<uint64>(static_cast<uint32>(cell.x) ^ 0x8000'0000u);
+				const auto y = static_cast<uint64>(static_cast<uint32>(cell.y) ^ 0x8000'0000u);
+				return (y << 32) | x;
+			}
+
+			[[nodiscard]]
+			ENGINE_INLINE static bool matches(const Item& item, const ComponentBitset& with) noexcept {
+				return (item.comps & with) == with;
+			}
+
+			/**
+			 * Calls `func(const Item&)` for each item in the cells overlapping a box.
+			 */
+			template<class Func>
+			void forEachInBox(const glm::vec2 min, const glm::vec2 max, Func&& func) const {
+				if (items.empty()) { return; }
+
+				const auto lo = glm::max(toCell(min), minCell);
+				const auto hi = glm::min(toCell(max), maxCell);
+
+				for (int32 y = lo.y; y <= hi.y; ++y) {
+					const auto first = std::lower_bound(keys.cbegin(), keys.cend(), toKey({lo.x, y}));
+					const auto last = std::upper_bound(first, keys.cend(), toKey({hi.x, y}));
+
+					for (auto it = first; it != last; ++it) {
+						func(items[it - keys.cbegin()]);
+					}
+				}
+			}
+	};
+}
@@ -3,6 +3,7 @@
 // STD
 #include <tuple>
 #include <type_traits>
+#include <vector>
 
 // Meta
 #include <Meta/IndexOf.hpp>
@@ -124,6 +125,30 @@ namespace Engine::ECS {
 	template<class T>
 	struct IsSnapshotRelevant<T, std::void_t<typename T::SnapshotData>> : std::true_type {};
 
+	/**
+	 * Statistics about a world rollback.
+	 */
+	class RollbackStats {
+		public:
+			/** How many ticks back the rollback went. */
+			Tick depth = 0;
+
+			/** How many ticks have been replayed. */
+			Tick replayed = 0;
+
+			/** The number of corrections coalesced into the rollback. */
+			int32 corrections = 0;
+
+			/** The number of entities resimulated. Zero for full rollbacks. */
+			int32 affected = 0;
+
+			/** The number of frames the replay has been spread over. */
+			int32 frames = 0;
+
+			/** The total time spent replaying ticks. */
+			Clock::Duration time = {};
+	};
+
 	// TODO: rm - work around for requires clauses not working in `if constexpr` on msvc
 	template<class Sys, class Comp>
 	concept HasComponentAddedCallbackFor = requires (Sys sys, Engine::ECS::Entity ent, Comp comp) {
@@ -168,6 +193,9 @@ namespace Engine::ECS {
 			/** TODO: doc */
 			bool performingRollback = false;
 
+			/** The tick the current rollback started from. */
+			Tick rollbackStartTick = -1;
+
 			/** Beginning of last run. */
 			Clock::TimePoint beginTime;
 
@@ -223,11 +251,47 @@ namespace Engine::ECS {
 			/** The containers for storing components. */
 			std::tuple<ComponentContainer<Cs>...> compContainers;
 
+			/** A rollback that has been scheduled but not yet started. Corrections are coalesced into the earliest tick. */
 			struct {
 				Engine::ECS::Tick tick = -1;
+
+				/** If only the entities affected by `corrected` should be resimulated. */
+				bool selective = false;
+
+				/** The number of corrections coalesced into this rollback. */
+				int32 corrections = 0;
+
+				/** The entities with corrected state. Only used for selective rollbacks. */
+				std::vector<Entity> corrected;
+			} pendingRollback;
+
+			/** The rollback currently being performed. */
+			struct {
+				/** The tick to replay up to. */
+				Engine::ECS::Tick tick = -1;
+
+				/** The tick time to restore once the replay is complete. */
 				Clock::TimePoint time = {};
+
+				bool selective = false;
+				std::vector<Entity> corrected;
 			} rollbackData;
 
+			/** Statistics for the current or last rollback. */
+			RollbackStats rollbackStats;
+
+			/**
+			 * The time that can be spent replaying ticks each frame.
+			 * At least one tick is replayed per frame regardless of the budget.
+			 */
+			Clock::Duration rollbackBudget = std::chrono::milliseconds{4};
+
+			/** The entities being resimulated during a selective rollback. */
+			std::vector<Entity> rollbackAffected;
+
+			/** If an entity is in `rollbackAffected`. Indexed by entity id. */
+			std::vector<bool> rollbackAffectedFlags;
+
 			struct Snapshot {
 				Clock::TimePoint tickTime = {};
 
@@ -268,7 +332,86 @@ namespace Engine::ECS {
 			void run();
 
 			ENGINE_INLINE bool isPerformingRollback() const noexcept { return performingRollback; }
-			ENGINE_INLINE void scheduleRollback(Tick t) { rollbackData.tick = t; }
+
+			/**
+			 * Schedules a rollback that resimulates every entity from tick @p t.
+			 * Multiple rollbacks scheduled before the next run are coalesced and start from the earliest tick.
+			 * Rollbacks scheduled while one is being performed start once it is complete.
+			 */
+			ENGINE_INLINE void scheduleRollback(Tick t) {
+				addPendingRollback(t);
+				pendingRollback.selective = false;
+			}
+
+			/**
+			 * Schedules a rollback from tick @p t that only resimulates the entities affected by a correction to @p ent.
+			 * Systems extend the affected set from the corrected entities in `preRollback` using markRollbackAffected.
+			 * Unaffected entities keep their current state and history.
+			 * If a full rollback is also scheduled the full rollback is used.
+			 */
+			ENGINE_INLINE void scheduleRollback(Tick t, Entity ent) {
+				addPendingRollback(t);
+				pendingRollback.corrected.push_back(ent);
+			}
+
+			/**
+			 * Gets statistics for the rollback currently being performed or the last rollback if none is in progress.
+			 */
+			ENGINE_INLINE const RollbackStats& getRollbackStats() const noexcept { return rollbackStats; }
+
+			/**
+			 * Sets the time that can be spent replaying ticks each frame.
+			 * Rollbacks that take longer are spread over multiple frames.
+			 */
+			ENGINE_INLINE void setRollbackBudget(Clock::Duration budget) noexcept { rollbackBudget = budget; }
+			ENGINE_INLINE Clock::Duration getRollbackBudget() const noexcept { return rollbackBudget; }
+
+			/**
+			 * Checks if the current rollback only resimulates some entities.
+			 * @see scheduleRollback
+			 */
+			ENGINE_INLINE bool isSelectiveRollback() const noexcept { return performingRollback && rollbackData.selective; }
+
+			/**
+			 * Checks if an entity should be simulated this tick.
+			 * Always true unless a selective rollback is being performed.
+			 */
+			ENGINE_INLINE bool isRollbackAffected(Entity ent) const noexcept {
+				return !isSelectiveRollback()
+					|| (ent.id < rollbackAffectedFlags.size() && rollbackAffectedFlags[ent.id]);
+			}
+
+			/**
+			 * Adds an entity to the set resimulated by a selective rollback.
+			 * Only valid during `preRollback`.
+			 */
+			ENGINE_INLINE void markRollbackAffected(Entity ent) {
+				if (isRollbackAffected(ent)) { return; }
+				if (rollbackAffectedFlags.size() <= ent.id) { rollbackAffectedFlags.resize(ent.id + 1); }
+				rollbackAffectedFlags[ent.id] = true;
+				rollbackAffected.push_back(ent);
+			}
+
+			/**
+			 * Gets the entities with corrected state for the current selective rollback.
+			 */
+			ENGINE_INLINE const auto& getRollbackCorrected() const noexcept { return rollbackData.corrected; }
+
+			/**
+			 * Gets the entities being resimulated by the current selective rollback.
+			 */
+			ENGINE_INLINE const auto& getRollbackAffected() const noexcept { return rollbackAffected; }
+
+			/**
+			 * Gets the tick the current rollback started from.
+			 */
+			ENGINE_INLINE Tick getRollbackTick() const noexcept { return rollbackStartTick; }
+
+			/**
+			 * Gets the last tick replayed by the current rollback.
+			 */
+			ENGINE_INLINE Tick getRollbackEndTick() const noexcept { return rollbackData.tick; }
+
 			ENGINE_INLINE bool hasHistory(Tick tick) const { return history.contains(tick); }
 			
 			////////////////////////////////////////////////////////////////////////////////
@@ -506,6 +649,38 @@ namespace Engine::ECS {
 				return history.get(tick).getComponentContainer<C>().contains(ent);
 			}
 
+			/**
+			 * Calls `func(Entity, C::SnapshotData&)` for every stored state of a component in the snapshot history.
+			 * Used to keep the history consistent when the meaning of stored values changes, such as an origin shift.
+			 */
+			template<class C, class Func>
+			void forEachComponentState(Func&& func) {
+				for (auto tick = history.minValid(); tick != history.max() + 1; ++tick) {
+					auto* snap = history.find(tick);
+					if (!snap) { continue; }
+
+					for (auto& pair : snap->template getComponentContainer<C>()) {
+						func(pair.first, pair.second);
+					}
+				}
+			}
+
+			/**
+			 * Calls `func(Entity, const C::SnapshotData&)` for each state of a component stored in the snapshot for @p tick.
+			 * @return False if the tick is not in the snapshot history.
+			 */
+			template<class C, class Func>
+			bool forEachComponentState(const Tick tick, Func&& func) const {
+				const auto* snap = history.find(tick);
+				if (!snap) { return false; }
+
+				for (const auto& pair : snap->template getComponentContainer<C>()) {
+					func(pair.first, pair.second);
+				}
+
+				return true;
+			}
+
 			// TODO: Doc
 			/**
 			 * 
@@ -653,6 +828,30 @@ namespace Engine::ECS {
 			bool loadSnapshot(Tick tick);
 			void tickSystems();
 
+			/**
+			 * Starts the pending rollback.
+			 * @return False if there is not enough history to perform the rollback.
+			 */
+			bool beginRollback();
+
+			/**
+			 * Replays ticks of the current rollback until it is complete or the budget is used.
+			 */
+			void continueRollback();
+
+			ENGINE_INLINE void addPendingRollback(Tick t) {
+				if (pendingRollback.tick == -1) {
+					pendingRollback.tick = t;
+					pendingRollback.selective = true;
+					pendingRollback.corrections = 0;
+					pendingRollback.corrected.clear();
+				} else if (seqLess(t, pendingRollback.tick)) {
+					pendingRollback.tick = t;
+				}
+
+				++pendingRollback.corrections;
+			}
+
 			/**
 			 * Get the container for components of type @p Component.
 			 * @tparam C The type of the component.
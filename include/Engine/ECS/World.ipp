@@ -31,37 +31,13 @@ namespace Engine::ECS {
 		deltaTime = Clock::Seconds{deltaTimeNS}.count();
 
 		if constexpr (ENGINE_CLIENT) {
-			if (rollbackData.tick != -1 && !performingRollback) {
-				const auto oldTick = currTick;
-				const auto oldTime = tickTime;
-
-				if (loadSnapshot(rollbackData.tick)) {
-					ENGINE_LOG(">>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> ", rollbackData.tick, " ", currTick);
-					rollbackData.tick = oldTick;
-					rollbackData.time = oldTime;
-					performingRollback = true;
-				} else {
-					ENGINE_WARN("Unable to perform world rollback to tick ", rollbackData.tick, " ", oldTick);
-					rollbackData.tick = -1;
-				}
+			if (pendingRollback.tick != -1 && !performingRollback) {
+				beginRollback();
 			}
 		}
 
 		if (ENGINE_CLIENT && performingRollback) {
-			while (currTick < rollbackData.tick) {
-				const auto& found = history.get(currTick + 1);
-				const auto nextTickTime = found.tickTime;
-				tickSystems();
-				ENGINE_LOG("Rollback2: ", currTick);
-				tickTime = nextTickTime;
-			}
-
-			if (currTick == rollbackData.tick) {
-				tickTime = rollbackData.time;
-				performingRollback = false;
-				rollbackData.tick = -1;
-				ENGINE_LOG("<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<< ", currTick);
-			}
+			continueRollback();
 		} else {
 			constexpr auto maxTickCount = 6;
 			int tickCount = -1;
@@ -75,6 +51,77 @@ namespace Engine::ECS {
 		destroyMarkedEntities();
 	}
 
+	WORLD_TPARAMS
+	bool WORLD_CLASS::beginRollback() {
+		const auto tick = pendingRollback.tick;
+		pendingRollback.tick = -1;
+
+		if (!history.contains(tick)) {
+			ENGINE_WARN("Unable to perform world rollback to tick ", tick, " ", currTick);
+			return false;
+		}
+
+		rollbackData.tick = currTick;
+		rollbackData.time = tickTime;
+		rollbackData.selective = pendingRollback.selective;
+		rollbackData.corrected.swap(pendingRollback.corrected);
+		pendingRollback.corrected.clear();
+
+		rollbackStats = {
+			.depth = currTick - tick,
+			.corrections = pendingRollback.corrections,
+		};
+
+		performingRollback = true;
+		rollbackStartTick = tick;
+
+		if (rollbackData.selective) {
+			for (const auto ent : rollbackData.corrected) {
+				if (isAlive(ent)) { markRollbackAffected(ent); }
+			}
+		}
+
+		(getSystem<Ss>().preRollback(), ...);
+		rollbackStats.affected = static_cast<int32>(rollbackAffected.size());
+		loadSnapshot(tick);
+
+		ENGINE_LOG(">>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> ", tick, " ", rollbackData.tick);
+		return true;
+	}
+
+	WORLD_TPARAMS
+	void WORLD_CLASS::continueRollback() {
+		const auto start = Clock::now();
+		auto elapsed = Clock::Duration{};
+
+		while (currTick < rollbackData.tick) {
+			const auto nextTickTime = history.get(currTick + 1).tickTime;
+			tickSystems();
+			tickTime = nextTickTime;
+			++rollbackStats.replayed;
+
+			elapsed = Clock::now() - start;
+			if (elapsed >= rollbackBudget) { break; }
+		}
+
+		rollbackStats.time += elapsed;
+		++rollbackStats.frames;
+
+		if (currTick == rollbackData.tick) {
+			tickTime = rollbackData.time;
+			(getSystem<Ss>().postRollback(), ...);
+
+			for (const auto ent : rollbackAffected) {
+				rollbackAffectedFlags[ent.id] = false;
+			}
+
+			rollbackAffected.clear();
+			rollbackData.corrected.clear();
+			performingRollback = false;
+			ENGINE_LOG("<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<< ", currTick, " (", rollbackStats.frames, " frames)");
+		}
+	}
+
 	WORLD_TPARAMS
 	void WORLD_CLASS::tickSystems() {
 		++currTick;
@@ -133,6 +180,29 @@ namespace Engine::ECS {
 	void WORLD_CLASS::storeSnapshot() {
 		(getSystem<Ss>().preStoreSnapshot(), ...);
 
+		// Unaffected entities keep their existing history during a selective rollback
+		if (isSelectiveRollback() && history.contains(currTick)) {
+			auto& snap = history.get(currTick);
+			Meta::ForEach<Cs...>::call([&]<class C>{
+				if constexpr (IsSnapshotRelevant<C>::value) {
+					auto& cont = getComponentContainer<C>();
+					auto& scont = snap.getComponentContainer<C>();
+					for (const auto ent : rollbackAffected) {
+						if (cont.contains(ent)) {
+							if (scont.contains(ent)) {
+								scont.get(ent) = cont.get(ent);
+							} else {
+								scont.add(ent, cont.get(ent));
+							}
+						} else if (scont.contains(ent)) {
+							scont.erase(ent);
+						}
+					}
+				}
+			});
+			return;
+		}
+
 		auto& snap = history.insert(currTick);
 		snap.tickTime = tickTime;
 		Meta::ForEach<Cs...>::call([&]<class C>{
@@ -151,14 +221,24 @@ namespace Engine::ECS {
 	bool WORLD_CLASS::loadSnapshot(Tick tick) {
 		if (!history.contains(tick)) { return false; }
 
+		(getSystem<Ss>().preLoadSnapshot(), ...);
+
 		auto& snap = history.get(tick);
 		Meta::ForEach<Cs...>::call([&]<class C>{
 			if constexpr (IsSnapshotRelevant<C>::value) {
 				auto& cont = getComponentContainer<C>();
 				auto& scont = snap.getComponentContainer<C>();
-				for (auto& [ent, comp] : scont) {
-					if (cont.contains(ent)) {
-						cont.get(ent) = comp;
+				if (isSelectiveRollback()) {
+					for (const auto ent : rollbackAffected) {
+						if (cont.contains(ent) && scont.contains(ent)) {
+							cont.get(ent) = scont.get(ent);
+						}
+					}
+				} else {
+					for (auto& [ent, comp] : scont) {
+						if (cont.contains(ent)) {
+							cont.get(ent) = comp;
+						}
 					}
 				}
 			}
@@ -50,18 +50,12 @@ namespace Engine::Graphics {
 		public:
 			Mesh();
 			Mesh(const Mesh&) = delete;
-			Mesh(Mesh&& other) { swap(*this, other); };
+			Mesh(Mesh&& other) noexcept { swap(*this, other); };
 
 			Mesh& operator=(const Mesh&) = delete;
-			Mesh& operator=(Mesh&& other) {
-				vao = other.vao;
-				eboCount = other.eboCount;
-				vbo = other.vbo;
-				ebo = other.ebo;
-				other.vao = 0;
-				other.eboCount = 0;
-				other.vbo = 0;
-				other.ebo = 0;
+			Mesh& operator=(Mesh&& other) noexcept {
+				// Swap so our old buffers are deleted by `other` instead of leaked
+				swap(*this, other);
 				return *this;
 			}
 
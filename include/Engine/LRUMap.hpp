@@ -0,0 +1,157 @@
+#pragma once
+
+// STD
+#include <vector>
+
+// Engine
+#include <Engine/Engine.hpp>
+#include <Engine/FlatHashMap.hpp>
+
+
+namespace Engine {
+	/**
+	 * A map with a fixed capacity that evicts the least recently used entry when full.
+	 *
+	 * Entries are kept in a pool linked in order of use so that no allocations
+	 * are made once the map has reached capacity.
+	 */
+	template<class Key, class Value, class Hash = Engine::Hash<Key>>
+	class LRUMap {
+		private:
+			using Index = int32;
+			constexpr static Index invalid = -1;
+
+			struct Node {
+				Key key;
+				Value value;
+				Index prev;
+				Index next;
+			};
+
+			std::vector<Node> nodes;
+			FlatHashMap<Key, Index, Hash> lookup;
+			size_t cap;
+
+			/** The most recently used node */
+			Index head = invalid;
+
+			/** The least recently used node */
+			Index tail = invalid;
+
+			/** Nodes available for reuse. Linked through `Node::next`. */
+			Index unused = invalid;
+
+		public:
+			explicit LRUMap(const size_t capacity) : cap{capacity} {
+				ENGINE_DEBUG_ASSERT(capacity > 0, "LRUMap capacity must be non-zero.");
+			}
+
+			/**
+			 * Finds an entry and marks it as the most recently used.
+			 * @return The value or nullptr if not found.
+			 */
+			Value* find(const Key& key) {
+				const auto found = lookup.find(key);
+				if (found == lookup.end()) { return nullptr; }
+				moveToFront(found->second);
+				return &nodes[found->second].value;
+			}
+
+			/**
+			 * Finds an entry without changing its use order.
+			 * @return The value or nullptr if not found.
+			 */
+			[[nodiscard]]
+			const Value* peek(const Key& key) const {
+				const auto found = lookup.find(key);
+				return found == lookup.end() ? nullptr : &nodes[found->second].value;
+			}
+
+			/**
+			 * Inserts or replaces an entry and marks it as the most recently used.
+			 * If the map is full the least recently used entry is evicted.
+			 */
+			Value& insert(const Key& key, Value value) {
+				if (const auto found = lookup.find(key); found != lookup.end()) {
+					moveToFront(found->second);
+					auto& node = nodes[found->second];
+					node.value = std::move(value);
+					return node.value;
+				}
+
+				Index idx;
+				if (lookup.size() == cap) {
+					idx = tail;
+					unlink(idx);
+					lookup.erase(nodes[idx].key);
+					nodes[idx].key = key;
+					nodes[idx].value = std::move(value);
+				} else if (unused != invalid) {
+					idx = unused;
+					unused = nodes[idx].next;
+					nodes[idx].key = key;
+					nodes[idx].value = std::move(value);
+				} else {
+					idx = static_cast<Index>(nodes.size());
+					nodes.push_back({key, std::move(value), invalid, invalid});
+				}
+
+				lookup[key] = idx;
+				linkFront(idx);
+				return nodes[idx].value;
+			}
+
+			/**
+			 * Removes an entry.
+			 * @return True if the entry existed.
+			 */
+			bool erase(const Key& key) {
+				const auto found = lookup.find(key);
+				if (found == lookup.end()) { return false; }
+
+				const auto idx = found->second;
+				lookup.erase(found);
+				unlink(idx);
+				nodes[idx].value = {};
+				nodes[idx].next = unused;
+				unused = idx;
+				return true;
+			}
+
+			void clear() {
+				nodes.clear();
+				lookup.clear();
+				head = invalid;
+				tail = invalid;
+				unused = invalid;
+			}
+
+			[[nodiscard]]
+			ENGINE_INLINE size_t size() const noexcept { return lookup.size(); }
+
+			[[nodiscard]]
+			ENGINE_INLINE size_t capacity() const noexcept { return cap; }
+
+		private:
+			void unlink(const Index idx) noexcept {
+				auto& node = nodes[idx];
+				if (node.prev != invalid) { nodes[node.prev].next = node.next; } else { head = node.next; }
+				if (node.next != invalid) { nodes[node.next].prev = node.prev; } else { tail = node.prev; }
+			}
+
+			void linkFront(const Index idx) noexcept {
+				auto& node = nodes[idx];
+				node.prev = invalid;
+				node.next = head;
+				if (head != invalid) { nodes[head].prev = idx; }
+				head = idx;
+				if (tail == invalid) { tail = idx; }
+			}
+
+			void moveToFront(const Index idx) noexcept {
+				if (idx == head) { return; }
+				unlink(idx);
+				linkFront(idx);
+			}
+	};
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+// STD
+#include <memory>
+
 // Engine
 #include <Engine/Net/MessageHeader.hpp>
 #include <Engine/Net/BufferWriter.hpp>
@@ -411,6 +414,15 @@ namespace Engine::Net {
 				ENGINE_DEBUG_ASSERT(size <= MAX_MESSAGE_BLOB_SIZE, "Attempting to send too much data");
 				channel.writeBlob(*buff, type, data, size);
 			}
+
+			/**
+			 * Writes data that may be shared with other messages.
+			 * The data must not be modified after it is written.
+			 */
+			ENGINE_INLINE void writeBlob(std::shared_ptr<const std::vector<byte>> data) {
+				ENGINE_DEBUG_ASSERT(data->size() <= MAX_MESSAGE_BLOB_SIZE, "Attempting to send too much data");
+				channel.writeBlob(*buff, type, std::move(data));
+			}
 	};
 
 	// TODO: update desc for Channel_LargeReliableOrdered
@@ -439,10 +451,13 @@ namespace Engine::Net {
 
 			struct WriteBlob {
 				int32 curr = 0;
-				std::vector<byte> data;
+
+				/** Shared so the same data can be sent on many channels without copying. */
+				std::shared_ptr<const std::vector<byte>> data;
+
 				MessageType type;
 				SeqNum parts;
-				const int32 remaining() const noexcept { return static_cast<int32>(data.size()) - curr; }
+				const int32 remaining() const noexcept { return static_cast<int32>(data->size()) - curr; }
 			};
 
 			struct RecvBlob {
@@ -519,10 +534,14 @@ namespace Engine::Net {
 			}
 
 			void writeBlob(BufferWriter& buff, MessageType type, const byte* data, int32 size) {
+				writeBlob(buff, type, std::make_shared<const std::vector<byte>>(data, data + size));
+			}
+
+			void writeBlob(BufferWriter& buff, MessageType type, std::shared_ptr<const std::vector<byte>> data) {
 				ENGINE_DEBUG_ASSERT(canWriteMessage(), "Unable to write message");
 				auto& blob = writeBlobs.insert(nextBlob);
 				blob.type = type;
-				blob.data.assign(data, data + size);
+				blob.data = std::move(data);
 				attemptWriteBlob(buff, nextBlob);
 				++nextBlob;
 			}
@@ -592,11 +611,11 @@ namespace Engine::Net {
 						msg.write(head);
 
 						if (blob->curr == 0) {
-							msg.write(static_cast<int32>(blob->data.size()));
+							msg.write(static_cast<int32>(blob->data->size()));
 						}
 
 						const int32 len = std::min(space, blob->remaining());
-						msg.write(blob->data.data() + blob->curr, len);
+						msg.write(blob->data->data() + blob->curr, len);
 						// ENGINE_INFO("Write blob part: ", head.seq(), " = ", seq, " ", len);
 						blob->curr += len;
 						++blob->parts;
@@ -652,6 +671,7 @@ namespace Engine::Net {
 							--blob->parts;
 							// ENGINE_INFO("Blob part ack: ", pktSeq, " ", s, " ", seq, " ", blob->parts);
 							if (blob->parts == 0 && blob->remaining() == 0) {
+								blob->data.reset(); // Removed entries are not destroyed until reused
 								writeBlobs.remove(seq);
 								// ENGINE_SUCCESS("Blob complete! ", seq);
 							}
@@ -1,5 +1,11 @@
 #pragma once
 
+// STD
+#include <algorithm>
+
+// GLM
+#include <glm/glm.hpp>
+
 
 namespace Engine::Noise {
 	// TODO: name
@@ -30,4 +36,28 @@ namespace Engine::Noise {
 		Int xi = static_cast<Int>(x);
 		return x < xi ? xi - 1 : xi;
 	}
+
+	/**
+	 * Evaluates a batched noise function over a regular grid.
+	 * The sample at `out[x * size.y + y]` is at `{origin.x + x * step.x, origin.y + y * step.y}`.
+	 * @param batch Called as `batch(xs, ys, out, n)` to evaluate @p n points.
+	 */
+	template<class Float, class Int, class Batch>
+	void fillGrid(const glm::vec<2, Float> origin, const glm::vec<2, Float> step, const glm::vec<2, Int> size, Float* out, Batch&& batch) {
+		constexpr Int blockSize = 256;
+		Float xs[blockSize];
+		Float ys[blockSize];
+
+		for (Int x = 0; x < size.x; ++x) {
+			std::fill(std::begin(xs), std::end(xs), origin.x + x * step.x);
+
+			for (Int y = 0; y < size.y; y += blockSize) {
+				const auto n = std::min(blockSize, size.y - y);
+				for (Int i = 0; i < n; ++i) {
+					ys[i] = origin.y + (y + i) * step.y;
+				}
+				batch(xs, ys, out + x * size.y + y, static_cast<size_t>(n));
+			}
+		}
+	}
 }
@@ -3,10 +3,15 @@
 // TODO: move to namespace
 // TODO: Cleanup
 
+// STD
+#include <concepts>
+
 // GLM
 #include <glm/fwd.hpp>
 
 // Engine
+#include <Engine/CPU/CPU.hpp>
+#include <Engine/CPU/SIMD.hpp>
 #include <Engine/Noise/Noise.hpp>
 #include <Engine/Noise/RangePermutation.hpp>
 
@@ -146,6 +151,36 @@ namespace Engine::Noise {
 				return value * RescaleMult2D;
 			}
 
+			/**
+			 * Evaluates the noise at @p n points.
+			 * Uses AVX2 or SSE4.1 if available. The results are bit identical to calling `value(xs[i], ys[i])` for each point.
+			 */
+			void valueN(const Float* xs, const Float* ys, Float* out, const size_t n) const noexcept {
+				size_t i = 0;
+
+				if constexpr (hasSIMD) {
+					if (CPU::hasAVX2()) {
+						i = valueN<CPU::AVX2>(xs, ys, out, n);
+					} else if (CPU::hasSSE41()) {
+						i = valueN<CPU::SSE41>(xs, ys, out, n);
+					}
+				}
+
+				for (; i < n; ++i) {
+					out[i] = value(xs[i], ys[i]);
+				}
+			}
+
+			/**
+			 * Evaluates the noise over a grid of points.
+			 * @see fillGrid
+			 */
+			void valueGrid(const FVec2 origin, const FVec2 step, const glm::vec<2, Int> size, Float* out) const noexcept {
+				fillGrid(origin, step, size, out, [&](const Float* xs, const Float* ys, Float* res, const size_t n) ENGINE_INLINE {
+					valueN(xs, ys, res, n);
+				});
+			}
+
 		private:
 			constexpr static Float STRETCH_CONSTANT_2D	= Float(-0.211324865405187); // (1/sqrt(2+1)-1)/2;
 			constexpr static Float SQUISH_CONSTANT_2D	= Float(0.366025403784439);  // (sqrt(2+1)-1)/2;
@@ -162,6 +197,9 @@ namespace Engine::Noise {
 
 			RangePermutation<256, Int> perm;
 
+			/** The SIMD paths are only implemented for 32 bit types. */
+			constexpr static bool hasSIMD = std::same_as<Float, float32> && std::same_as<Int, int32>;
+
 			// Gradients for 2D. They approximate the directions to the
 			// vertices of an octagon from the center.
 			const int8 gradients2D[16] = {
@@ -177,6 +215,116 @@ namespace Engine::Noise {
 				return gradients2D[index] * dx + gradients2D[index + 1] * dy;
 			}
 
+			/**
+			 * Vectorized version of `valueN`.
+			 * @return The number of points evaluated. Always a multiple of the SIMD width.
+			 */
+			template<class SIMD>
+			size_t valueN(const Float* xs, const Float* ys, Float* out, const size_t n) const noexcept {
+				size_t i = 0;
+				for (; i + SIMD::width <= n; i += SIMD::width) {
+					SIMD::store(out + i, valueSIMD<SIMD>(SIMD::load(xs + i), SIMD::load(ys + i)));
+				}
+				return i;
+			}
+
+			/**
+			 * Vectorized version of `value`.
+			 * Each operation mirrors the scalar version so that the results are bit identical.
+			 * Both triangles of the rhombus are computed and then selected between per lane.
+			 */
+			template<class SIMD>
+			typename SIMD::FloatV valueSIMD(const typename SIMD::FloatV x, const typename SIMD::FloatV y) const noexcept {
+				using S = SIMD;
+				const auto one = S::setf(1);
+				const auto two = S::setf(2);
+				const auto squish = S::setf(SQUISH_CONSTANT_2D);
+				const auto squish2 = S::setf(2 * SQUISH_CONSTANT_2D);
+				const auto ione = S::seti(1);
+				const auto itwo = S::seti(2);
+
+				const auto extrapolate = [&](const auto xsb, const auto ysb, const auto dx, const auto dy) ENGINE_INLINE {
+					// Gradient index bit 0 swaps the components, bit 1 negates x, and bit 2 negates y. See `gradients2D`.
+					const auto g = S::template shiftRight<1>(S::bitAnd(perm.template valueSIMD<S>(xsb, ysb), S::seti(0x0E)));
+					const auto swap = S::cmpEq(S::bitAnd(g, ione), ione);
+					const auto gx = S::bitXor(S::select(S::setf(5), two, swap), S::asFloat(S::template shiftLeft<30>(S::bitAnd(g, itwo))));
+					const auto gy = S::bitXor(S::select(two, S::setf(5), swap), S::asFloat(S::template shiftLeft<29>(S::bitAnd(g, S::seti(4)))));
+					return S::add(S::mul(gx, dx), S::mul(gy, dy));
+				};
+
+				const auto contribution = [&](const auto xsb, const auto ysb, const auto dx, const auto dy) ENGINE_INLINE {
+					auto attn = S::sub(S::sub(two, S::mul(dx, dx)), S::mul(dy, dy));
+					const auto active = S::cmpGT(attn, S::setf(0));
+					attn = S::mul(attn, attn);
+					return S::bitAnd(active, S::mul(S::mul(attn, attn), extrapolate(xsb, ysb, dx, dy)));
+				};
+
+				// Place input coordinates onto grid.
+				const auto stretchOffset = S::mul(S::add(x, y), S::setf(STRETCH_CONSTANT_2D));
+				const auto xs = S::add(x, stretchOffset);
+				const auto ys = S::add(y, stretchOffset);
+
+				// Floor to get grid coordinates of rhombus (stretched square) super-cell origin.
+				auto xsb = CPU::floorToInt<S>(xs);
+				auto ysb = CPU::floorToInt<S>(ys);
+				const auto xsbf = S::toFloat(xsb);
+				const auto ysbf = S::toFloat(ysb);
+
+				// Skew out to get actual coordinates of rhombus origin.
+				const auto squishOffset = S::mul(S::toFloat(S::add(xsb, ysb)), squish);
+				const auto xb = S::add(xsbf, squishOffset);
+				const auto yb = S::add(ysbf, squishOffset);
+
+				// Compute grid coordinates relative to rhombus origin.
+				const auto xins = S::sub(xs, xsbf);
+				const auto yins = S::sub(ys, ysbf);
+				const auto inSum = S::add(xins, yins);
+
+				// Positions relative to origin point.
+				auto dx0 = S::sub(x, xb);
+				auto dy0 = S::sub(y, yb);
+
+				// Contribution (1,0) and (0,1)
+				auto value = contribution(S::add(xsb, ione), ysb, S::sub(S::sub(dx0, one), squish), S::sub(dy0, squish));
+				value = S::add(value, contribution(xsb, S::add(ysb, ione), S::sub(dx0, squish), S::sub(S::sub(dy0, one), squish)));
+
+				const auto xGreater = S::cmpGT(xins, yins);
+				const auto inLower = S::cmpLE(inSum, one);
+
+				// Inside the triangle (2-Simplex) at (0,0)
+				const auto zinsL = S::sub(one, inSum);
+				const auto nearL = S::bitOr(S::cmpGT(zinsL, xins), S::cmpGT(zinsL, yins));
+				const auto xsvL = S::select(S::add(xsb, ione), S::select(S::sub(xsb, ione), S::add(xsb, ione), xGreater), nearL);
+				const auto ysvL = S::select(S::add(ysb, ione), S::select(S::add(ysb, ione), S::sub(ysb, ione), xGreater), nearL);
+				const auto dxL = S::select(S::sub(S::sub(dx0, one), squish2), S::select(S::add(dx0, one), S::sub(dx0, one), xGreater), nearL);
+				const auto dyL = S::select(S::sub(S::sub(dy0, one), squish2), S::select(S::sub(dy0, one), S::add(dy0, one), xGreater), nearL);
+
+				// Inside the triangle (2-Simplex) at (1,1)
+				const auto zinsU = S::sub(two, inSum);
+				const auto nearU = S::bitOr(S::cmpLT(zinsU, xins), S::cmpLT(zinsU, yins));
+				const auto xsvU = S::select(xsb, S::select(xsb, S::add(xsb, itwo), xGreater), nearU);
+				const auto ysvU = S::select(ysb, S::select(S::add(ysb, itwo), ysb, xGreater), nearU);
+				const auto dxU = S::select(dx0, S::select(S::sub(dx0, squish2), S::sub(S::sub(dx0, two), squish2), xGreater), nearU);
+				const auto dyU = S::select(dy0, S::select(S::sub(S::sub(dy0, two), squish2), S::sub(dy0, squish2), xGreater), nearU);
+
+				const auto xsvExt = S::select(xsvU, xsvL, inLower);
+				const auto ysvExt = S::select(ysvU, ysvL, inLower);
+				const auto dxExt = S::select(dxU, dxL, inLower);
+				const auto dyExt = S::select(dyU, dyL, inLower);
+
+				xsb = S::select(S::add(xsb, ione), xsb, inLower);
+				ysb = S::select(S::add(ysb, ione), ysb, inLower);
+				dx0 = S::select(S::sub(S::sub(dx0, one), squish2), dx0, inLower);
+				dy0 = S::select(S::sub(S::sub(dy0, one), squish2), dy0, inLower);
+
+				// Contribution (0,0) or (1,1)
+				value = S::add(value, contribution(xsb, ysb, dx0, dy0));
+
+				// Extra Vertex
+				value = S::add(value, contribution(xsvExt, ysvExt, dxExt, dyExt));
+
+				return S::mul(value, S::setf(RescaleMult2D));
+			}
 	};
 
 	struct OpenSimplexNoise : OpenSimplexNoiseGeneric<float32, int32> {};
@@ -3,6 +3,7 @@
 // Engine
 #include <Engine/Noise/Noise.hpp>
 #include <Engine/Engine.hpp>
+#include <Engine/CPU/SIMD.hpp>
 
 
 namespace Engine::Noise {
@@ -16,6 +17,9 @@ namespace Engine::Noise {
 			static_assert(Size <= 256, "Values are currently stored as uint8.");
 			Stored perm[Size];
 
+			/** A copy of `perm` widened to 32 bits for use with SIMD gathers. */
+			alignas(32) int32 wide[Size];
+
 			constexpr static bool isPowerOfTwo = Size && !(Size & (Size - 1));
 
 		public:
@@ -49,6 +53,10 @@ namespace Engine::Noise {
 					// Since we will never visit source[i] again, move the value of source[i] into source[r] so we dont miss any values. (because range is limited to [0, i] where i is decreasing)
 					source[r] = source[i];
 				}
+
+				for (Int i = 0; i < Size; ++i) {
+					wide[i] = perm[i];
+				}
 			}
 
 			template<class... Args>
@@ -71,5 +79,25 @@ namespace Engine::Noise {
 			ENGINE_INLINE Int value(Int x, Int y, Int z) const {
 				return value(value(x, y) + z);
 			}
+
+			/**
+			 * Vectorized versions of `value`.
+			 * @tparam SIMD The instruction set to use. @see Engine::CPU::AVX2
+			 */
+			template<class SIMD>
+			ENGINE_INLINE auto valueSIMD(typename SIMD::IntV x) const {
+				static_assert(isPowerOfTwo, "Vectorized lookups are only supported for power of two sizes.");
+				return SIMD::gather(wide, SIMD::bitAnd(x, SIMD::seti(Size - 1)));
+			}
+
+			template<class SIMD>
+			ENGINE_INLINE auto valueSIMD(typename SIMD::IntV x, typename SIMD::IntV y) const {
+				return valueSIMD<SIMD>(SIMD::add(valueSIMD<SIMD>(x), y));
+			}
+
+			template<class SIMD>
+			ENGINE_INLINE auto valueSIMD(typename SIMD::IntV x, typename SIMD::IntV y, typename SIMD::IntV z) const {
+				return valueSIMD<SIMD>(SIMD::add(valueSIMD<SIMD>(x, y), z));
+			}
 	};
 }
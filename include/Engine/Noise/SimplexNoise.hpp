@@ -1,7 +1,12 @@
 #pragma once
 
+// STD
+#include <algorithm>
+
 // Engine
 #include <Engine/Engine.hpp>
+#include <Engine/CPU/CPU.hpp>
+#include <Engine/CPU/SIMD.hpp>
 #include <Engine/Noise/RangePermutation.hpp>
 
 
@@ -35,6 +40,8 @@ namespace Engine::Noise {
 				//-10.00000000f, // Really would be -inf
 			};
 
+			constexpr static Float scale = 2.0f / *std::max_element(std::cbegin(grads), std::cend(grads));
+
 
 		public:
 			SimplexNoise(uint64 seed) : perm{seed} {}
@@ -55,11 +62,28 @@ namespace Engine::Noise {
 				p = ((6*p - 15)*p + 10)*p*p*p; // 5th order smoothstep
 
 				// TODO: Shouldnt this be 1/xyz ? why two
-				constexpr auto scale = 2.0f / *std::max_element(std::cbegin(grads), std::cend(grads));
 				//constexpr auto scale = 2.0f / 7.0f; // if using generated grad instead of lookup
 				return (dot1 + p * (dot2 - dot1)) * scale;
 			}
 
+			/**
+			 * Evaluates `value1D(xs[i])` for @p n points.
+			 * Uses AVX2 or SSE4.1 if available. The results are bit identical to the scalar version.
+			 */
+			void value1DN(const Float* xs, Float* out, const size_t n) const noexcept {
+				size_t i = 0;
+
+				if (CPU::hasAVX2()) {
+					i = value1DN<CPU::AVX2>(xs, out, n);
+				} else if (CPU::hasSSE41()) {
+					i = value1DN<CPU::SSE41>(xs, out, n);
+				}
+
+				for (; i < n; ++i) {
+					out[i] = value1D(xs[i]);
+				}
+			}
+
 			// TODO: 2D - look into opensimplex2
 			// TODO: 3D - look into opensimplex2
 			// TODO: 4D - look into opensimplex2
@@ -74,5 +98,43 @@ namespace Engine::Noise {
 				//return grads[perm.value(i) % std::size(grads)];
 				return grads[perm.value(i) & 0b0111];
 			}
+
+			/**
+			 * @return The number of points evaluated. Always a multiple of the SIMD width.
+			 */
+			template<class SIMD>
+			size_t value1DN(const Float* xs, Float* out, const size_t n) const noexcept {
+				size_t i = 0;
+				for (; i + SIMD::width <= n; i += SIMD::width) {
+					SIMD::store(out + i, value1DSIMD<SIMD>(SIMD::load(xs + i)));
+				}
+				return i;
+			}
+
+			/**
+			 * Vectorized version of `value1D`.
+			 * Each operation mirrors the scalar version so that the results are bit identical.
+			 */
+			template<class SIMD>
+			typename SIMD::FloatV value1DSIMD(const typename SIMD::FloatV x) const noexcept {
+				using S = SIMD;
+				static_assert(std::size(grads) == 8);
+
+				const auto grad = [&](const auto i) ENGINE_INLINE {
+					return S::lookup8(grads, S::bitAnd(perm.template valueSIMD<S>(i), S::seti(0b0111)));
+				};
+
+				const auto prev = CPU::floorToInt<S>(x);
+				const auto next = S::add(prev, S::seti(1));
+				const auto prevf = S::toFloat(prev);
+
+				const auto dot1 = S::mul(grad(prev), S::sub(prevf, x));
+				const auto dot2 = S::mul(grad(next), S::sub(S::toFloat(next), x));
+
+				auto p = S::sub(x, prevf);
+				p = S::mul(S::mul(S::mul(S::add(S::mul(S::sub(S::mul(S::setf(6), p), S::setf(15)), p), S::setf(10)), p), p), p);
+
+				return S::mul(S::add(dot1, S::mul(p, S::sub(dot2, dot1))), S::setf(scale));
+			}
 	};
 }
@@ -3,6 +3,7 @@
 // STD
 #include <mutex>
 #include <queue>
+#include <vector>
 
 
 namespace Engine {
@@ -56,6 +57,17 @@ namespace Engine {
 				return true;
 			}
 
+			/**
+			 * Moves all elements to the end of @p out.
+			 */
+			void popAll(std::vector<T>& out) {
+				std::scoped_lock lock{mutex};
+				while (!storage.empty()) {
+					out.push_back(std::move(storage.front()));
+					storage.pop();
+				}
+			}
+
 			bool popOrWait(T& ret) {
 				std::unique_lock lock{mutex};
 
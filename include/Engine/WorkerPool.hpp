@@ -0,0 +1,129 @@
+#pragma once
+
+// STD
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Engine
+#include <Engine/Engine.hpp>
+
+
+namespace Engine {
+	/**
+	 * A fixed set of threads for fork-join style parallel work.
+	 *
+	 * Work is given as a count and a callable that is invoked once for each index.
+	 * The calling thread also takes work and does not return until all indices are complete.
+	 * Only one thread should submit work at a time.
+	 */
+	class WorkerPool {
+		private:
+			std::vector<std::thread> threads;
+			std::mutex mutex;
+			std::condition_variable wake;
+			std::condition_variable done;
+
+			/** The current work. Only modified while no workers are active. */
+			void* context = nullptr;
+			void (*invoke)(void* context, int32 i) = nullptr;
+			int32 count = 0;
+
+			/** The next index to be taken. */
+			std::atomic<int32> next = 0;
+
+			/** The number of workers that have not finished the current work. */
+			int32 active = 0;
+
+			/** Incremented each time work is submitted. */
+			uint64 generation = 0;
+			bool shouldExit = false;
+
+		public:
+			/**
+			 * @param threadCount The number of threads in addition to the calling thread.
+			 */
+			explicit WorkerPool(const int32 threadCount) {
+				threads.reserve(threadCount);
+				for (int32 i = 0; i < threadCount; ++i) {
+					threads.emplace_back(&WorkerPool::workerLoop, this);
+				}
+			}
+
+			WorkerPool(const WorkerPool&) = delete;
+
+			~WorkerPool() {
+				{
+					std::lock_guard lock{mutex};
+					shouldExit = true;
+				}
+
+				wake.notify_all();
+				for (auto& thread : threads) {
+					thread.join();
+				}
+			}
+
+			/**
+			 * Calls `func(i)` for each `i` in `[0, n)` spread over the pool and the calling thread.
+			 * Blocks until all calls have returned. The order of calls is unspecified.
+			 */
+			template<class Func>
+			void forEach(const int32 n, Func&& func) {
+				if (n <= 0) { return; }
+
+				if (n == 1 || threads.empty()) {
+					for (int32 i = 0; i < n; ++i) { func(i); }
+					return;
+				}
+
+				{
+					std::lock_guard lock{mutex};
+					context = &func;
+					invoke = [](void* ctx, int32 i){ (*static_cast<std::remove_reference_t<Func>*>(ctx))(i); };
+					count = n;
+					next.store(0, std::memory_order_relaxed);
+					active = static_cast<int32>(threads.size());
+					++generation;
+				}
+
+				wake.notify_all();
+				work();
+
+				std::unique_lock lock{mutex};
+				done.wait(lock, [&]{ return active == 0; });
+			}
+
+			[[nodiscard]]
+			ENGINE_INLINE int32 size() const noexcept { return static_cast<int32>(threads.size()) + 1; }
+
+		private:
+			void work() {
+				for (int32 i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;) {
+					invoke(context, i);
+				}
+			}
+
+			void workerLoop() {
+				uint64 seen = 0;
+				while (true) {
+					{
+						std::unique_lock lock{mutex};
+						wake.wait(lock, [&]{ return shouldExit || generation != seen; });
+						if (shouldExit) { return; }
+						seen = generation;
+					}
+
+					work();
+
+					{
+						std::lock_guard lock{mutex};
+						if (--active == 0) { done.notify_one(); }
+					}
+				}
+			}
+	};
+}
@@ -105,4 +105,22 @@ namespace Game {
 			glm::ivec2 pos;
 			BlockEntityData data;
 	};
+
+	/**
+	 * The parts of building a block entity that don't depend on the world.
+	 * Computed from a BlockEntityDesc on the chunk loading threads so that only
+	 * entity, component and body creation is left for the main thread.
+	 * @see MapSystem::prepareBlockEntity
+	 */
+	class PreparedBlockEntity {
+		public:
+			/** The index of the sprite texture for the type. */
+			uint8 texture = 0;
+
+			/** Half the size of the fixture box in meters. */
+			glm::vec2 halfSize = {};
+
+			/** The center of the fixture box in meters relative to the block. */
+			glm::vec2 center = {};
+	};
 }
@@ -0,0 +1,50 @@
+#pragma once
+
+// STD
+#include <vector>
+
+// Game
+#include <Game/Common.hpp>
+#include <Game/MapChunk.hpp>
+
+
+namespace Game {
+	/**
+	 * The formats a chunk can be encoded in for network transfer or storage.
+	 * New codecs should be added to the end so existing values stay the same.
+	 */
+	enum class ChunkCodec : uint8 {
+		/** Runs of blocks in x-major order. The format used by MapChunk::toRLE. */
+		RLE,
+
+		/**
+		 * Runs of blocks in y-major order.
+		 * Generally larger than RLE since caves and ores break up rows more than columns.
+		 */
+		RowRLE,
+
+		/** The runs from RLE entropy coded with rANS using per chunk frequencies. */
+		RANS,
+
+		_COUNT,
+	};
+
+	/**
+	 * Appends the encoding of @p blocks to @p encoding.
+	 * The codec is not included in the output.
+	 */
+	void encodeChunk(const ChunkCodec codec, const MapChunk::DenseData& blocks, std::vector<byte>& encoding);
+
+	/**
+	 * Decodes the output of encodeChunk into @p blocks.
+	 * @return False if the data is malformed. In which case the content of @p blocks is unspecified.
+	 */
+	[[nodiscard]]
+	bool decodeChunk(const ChunkCodec codec, const byte* begin, const byte* end, MapChunk::DenseData& blocks);
+
+	/**
+	 * Gets the name of a codec for display.
+	 */
+	[[nodiscard]]
+	const char* getChunkCodecName(const ChunkCodec codec) noexcept;
+}
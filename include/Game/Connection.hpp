@@ -26,7 +26,8 @@ namespace Game {
 		MessageType::CONNECT_CONFIRM,
 		MessageType::PING,
 		MessageType::PLAYER_DATA,
-		MessageType::SPELL
+		MessageType::SPELL,
+		MessageType::MAP_CHUNK_REQUEST
 	> {};
 
 	struct Channel_ECS : Engine::Net::Channel_ReliableOrdered<
@@ -39,8 +40,11 @@ namespace Game {
 		MessageType::ECS_FLAG
 	> {};
 
+	// Edits must be on the same channel as chunks so they are applied after the chunk they modify
 	struct Channel_Map_Blob : Engine::Net::Channel_LargeReliableOrdered<
-		MessageType::MAP_CHUNK
+		MessageType::MAP_CHUNK,
+		MessageType::MAP_EDIT,
+		MessageType::MAP_CHUNK_CACHED
 	> {};
 
 	using Connection = Engine::Net::Connection<
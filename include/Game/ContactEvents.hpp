@@ -0,0 +1,129 @@
+#pragma once
+
+// STD
+#include <algorithm>
+#include <functional>
+#include <span>
+#include <vector>
+
+// Engine
+#include <Engine/ECS/Entity.hpp>
+
+// Game
+#include <Game/Common.hpp>
+
+
+namespace Game {
+	/**
+	 * One side of a contact between two entities.
+	 * Each contact is stored twice, once from the view of each entity.
+	 */
+	struct ContactEvent {
+		Engine::ECS::Entity ent;
+		Engine::ECS::Entity other;
+
+		/** The user data of the fixture belonging to `ent`. */
+		void* fixtureData;
+
+		/** The user data of the fixture belonging to `other`. */
+		void* otherFixtureData;
+
+		ENGINE_INLINE friend bool operator==(const ContactEvent& a, const ContactEvent& b) noexcept {
+			return a.ent == b.ent && a.other == b.other && a.fixtureData == b.fixtureData && a.otherFixtureData == b.otherFixtureData;
+		}
+	};
+
+	/**
+	 * A flat buffer of the contacts that began and ended during a tick.
+	 * Events are recorded in any order then sorted by entity and deduplicated once by build so that consumers
+	 * can look up the contacts for an entity as a span instead of filtering every event.
+	 *
+	 * If a contact both begins and ends in the same tick it is in both lists.
+	 */
+	class ContactEvents {
+		public:
+			enum class Type : uint8 {
+				Begin,
+				End,
+				_count,
+			};
+
+		private:
+			std::vector<ContactEvent> events[static_cast<int32>(Type::_count)];
+
+		public:
+			ENGINE_INLINE void clear() noexcept {
+				for (auto& list : events) { list.clear(); }
+			}
+
+			[[nodiscard]]
+			ENGINE_INLINE bool empty() const noexcept {
+				return std::ranges::all_of(events, [](const auto& list){ return list.empty(); });
+			}
+
+			/**
+			 * Records a contact between two fixtures.
+			 */
+			void add(const Type type, const Engine::ECS::Entity entA, const Engine::ECS::Entity entB, void* fixtureDataA, void* fixtureDataB) {
+				auto& list = getList(type);
+				list.push_back({entA, entB, fixtureDataA, fixtureDataB});
+				list.push_back({entB, entA, fixtureDataB, fixtureDataA});
+			}
+
+			/**
+			 * Adds all events from @p other. The result is unsorted until build is called.
+			 */
+			void append(const ContactEvents& other) {
+				for (int32 i = 0; i < static_cast<int32>(Type::_count); ++i) {
+					events[i].insert(events[i].end(), other.events[i].cbegin(), other.events[i].cend());
+				}
+			}
+
+			/**
+			 * Sorts and removes duplicate events.
+			 * Must be called after adding events and before getting them.
+			 */
+			void build() {
+				for (auto& list : events) {
+					std::sort(list.begin(), list.end(), less);
+					list.erase(std::unique(list.begin(), list.end()), list.end());
+				}
+			}
+
+			/**
+			 * Gets all events of a type sorted by entity.
+			 */
+			[[nodiscard]]
+			ENGINE_INLINE std::span<const ContactEvent> get(const Type type) const noexcept {
+				return events[static_cast<int32>(type)];
+			}
+
+			/**
+			 * Gets the events of a type where `ContactEvent::ent` is @p ent.
+			 */
+			[[nodiscard]]
+			std::span<const ContactEvent> get(const Type type, const Engine::ECS::Entity ent) const {
+				const auto& list = events[static_cast<int32>(type)];
+				const auto first = std::lower_bound(list.cbegin(), list.cend(), ent, [](const ContactEvent& event, const Engine::ECS::Entity ent){
+					return event.ent < ent;
+				});
+				const auto last = std::upper_bound(first, list.cend(), ent, [](const Engine::ECS::Entity ent, const ContactEvent& event){
+					return ent < event.ent;
+				});
+				return {first, last};
+			}
+
+		private:
+			ENGINE_INLINE std::vector<ContactEvent>& getList(const Type type) noexcept {
+				return events[static_cast<int32>(type)];
+			}
+
+			ENGINE_INLINE static bool less(const ContactEvent& a, const ContactEvent& b) noexcept {
+				constexpr std::less<void*> cmp;
+				if (a.ent != b.ent) { return a.ent < b.ent; }
+				if (a.other != b.other) { return a.other < b.other; }
+				if (a.fixtureData != b.fixtureData) { return cmp(a.fixtureData, b.fixtureData); }
+				return cmp(a.otherFixtureData, b.otherFixtureData);
+			}
+	};
+}
@@ -2,17 +2,30 @@
 
 // STD
 #include <type_traits>
+#include <vector>
+#include <bit>
 
 // GLM
 #include <glm/glm.hpp>
 
 // Game
+#include <Game/Common.hpp>
 #include <Game/BlockMeta.hpp>
-#include <Game/systems/PhysicsSystem.hpp>
 
 
-// TODO: Doc
 namespace Game {
+	class MapChunkEdit;
+
+	/**
+	 * A fixed size area of blocks.
+	 *
+	 * Blocks are stored as indices into a small per chunk palette bit packed into
+	 * 64 bit words. The number of bits per block grows (0, 1, 2, 4, 8) as new block
+	 * types are added. If the palette overflows 8 bits, block ids are stored directly.
+	 *
+	 * Each column of blocks is stored in `bitsPerBlock` consecutive words so that a whole
+	 * column can be compared against a palette index with a few bitwise operations.
+	 */
 	class MapChunk {
 		public:
 			constexpr static glm::ivec2 size = {64, 64};
@@ -25,100 +38,210 @@ namespace Game {
 			};
 			static_assert(sizeof(RLEPair) == 4); // Ensure tight packing
 
+			/** A bitmask of a single column. Bit `y` corresponds to the block at `{x, y}`. */
+			using ColumnMask = uint64;
+			static_assert(sizeof(ColumnMask) * 8 == size.y, "Each column must fit in a single ColumnMask.");
+
+			/** A dense (unpacked) array of blocks. */
+			using DenseData = BlockId[size.x][size.y];
+
+			/** The number of bits per block used when block ids are stored directly instead of in a palette. */
+			constexpr static uint8 directBits = sizeof(BlockId) * 8;
+
+		private:
+			using Word = uint64;
+			constexpr static int32 wordBits = sizeof(Word) * 8;
+
+			/** The number of bits used for each block. Zero if the chunk is a single block type. */
+			uint8 bits = 0;
+
+			/** The block ids referenced by `packed`. Unused when `bits == directBits`. */
+			std::vector<BlockId> palette = {BlockId::None};
+
+			/** The bit packed palette indices. Column `x` occupies the words `[x * bits, (x + 1) * bits)`. */
+			std::vector<Word> packed;
+
 		public:
-			BlockId data[size.x][size.y] = {};
-			
-			bool apply(const MapChunk& edit) {
-				bool editMade = false;
+			/**
+			 * Solid blocks in each column.
+			 * Derived from the block data and updated on modification.
+			 */
+			ColumnMask solidMask[size.x] = {};
+
+			/**
+			 * Renderable (not None or Air) blocks in each column.
+			 * Derived from the block data and updated on modification.
+			 */
+			ColumnMask renderMask[size.x] = {};
 
-				for (int x = 0; x < size.x; ++x) {
-					for (int y = 0; y < size.y; ++y) {
-						const auto& ed = edit.data[x][y];
-						if (ed == BlockId::None) { continue; }
+		public:
+			/**
+			 * Gets the block at a position.
+			 */
+			[[nodiscard]]
+			ENGINE_INLINE BlockId getBlock(const glm::ivec2 pos) const noexcept {
+				if (bits == 0) { return palette[0]; }
+				const auto v = getRaw(pos);
+				return bits == directBits ? static_cast<BlockId>(v) : palette[v];
+			}
 
-						auto& cd = data[x][y];
-						if (cd == ed) { continue; }
+			/**
+			 * Sets the block at a position and updates the derived masks.
+			 */
+			void setBlock(const glm::ivec2 pos, const BlockId bid) noexcept;
+
+			/**
+			 * Replaces all blocks in this chunk. Rebuilds the palette from only the used blocks.
+			 */
+			void assign(const DenseData& blocks) noexcept;
+
+			/**
+			 * Copies all blocks in this chunk into @p blocks.
+			 */
+			void toDense(DenseData& blocks) const noexcept;
+
+			/**
+			 * Gets a 64 bit hash of the blocks in this chunk.
+			 * Independent of the palette and storage so equal blocks always have equal hashes.
+			 */
+			[[nodiscard]]
+			uint64 hash() const noexcept;
+
+			/**
+			 * Removes unused palette entries and shrinks the storage if possible.
+			 */
+			void compact() noexcept;
+
+			/**
+			 * Gets a mask of the blocks in column @p x equal to @p bid.
+			 */
+			[[nodiscard]]
+			ColumnMask columnMask(const int32 x, const BlockId bid) const noexcept;
+
+			/**
+			 * Applies all blocks from @p edit to this chunk.
+			 * @return True if any block was changed.
+			 */
+			bool apply(const MapChunkEdit& edit) noexcept;
+
+			/**
+			 * The number of bits currently used per block.
+			 */
+			[[nodiscard]]
+			ENGINE_INLINE uint8 bitsPerBlock() const noexcept { return bits; }
+
+			/**
+			 * Gets the approximate number of bytes used by this chunk including heap allocations.
+			 */
+			[[nodiscard]]
+			ENGINE_INLINE size_t memoryUsage() const noexcept {
+				return sizeof(*this)
+					+ palette.capacity() * sizeof(palette[0])
+					+ packed.capacity() * sizeof(packed[0]);
+			}
 
-						editMade = true;
-						cd = ed;
-					}
-				}
+			/**
+			 * Greedily merges renderable blocks of the same type into rectangles.
+			 * @param submitArea Called as `submitArea(begin, end)` for each half open rectangle.
+			 */
+			template<class SubmitArea>
+			ENGINE_INLINE void forEachRenderArea(SubmitArea&& submitArea) const {
+				greedyExpand(renderMask, [&](const int32 x, const BlockId bid) ENGINE_INLINE {
+					return columnMask(x, bid);
+				}, std::forward<SubmitArea>(submitArea));
+			}
 
-				return editMade;
+			/**
+			 * Greedily merges solid blocks into rectangles.
+			 * @param submitArea Called as `submitArea(begin, end)` for each half open rectangle.
+			 */
+			template<class SubmitArea>
+			ENGINE_INLINE void forEachSolidArea(SubmitArea&& submitArea) const {
+				greedyExpand(solidMask, [&](const int32 x, const BlockId bid) ENGINE_INLINE {
+					return solidMask[x];
+				}, std::forward<SubmitArea>(submitArea));
 			}
 
-			// TODO: move RLE data to active chunk data instead on MapChunk. we only need it if it is active.
-			void toRLE(std::vector<byte>& encoding) const {
-				encoding.clear();
-
-				// Reserve space for position data
-				encoding.insert(encoding.end(), sizeof(size), 0);
-
-				constexpr auto sz = size.x * size.y;
-				const BlockId* linear = &data[0][0];
-
-				RLEPair pair = {
-					.bid = linear[0],
-					.count = 1,
-				};
-
-				 auto&& insert = [&]{
-					if (pair.count == 1) {
-						BlockId bid = pair.bid | RLE_COUNT_BIT;
-						const byte* start = reinterpret_cast<const byte*>(&bid);
-						const byte* stop = start + sizeof(bid);
-						encoding.insert(encoding.cend(), start, stop);
-					} else {
-						const byte* start = reinterpret_cast<const byte*>(&pair);
-						const byte* stop = start + sizeof(pair);
-						encoding.insert(encoding.cend(), start, stop);
-					}
-				};
-
-				for (int i = 1; i < sz; ++i) {
-					const auto& bid = linear[i];
-					if (bid == pair.bid) {
-						++pair.count;
-					} else {
-						insert();
-						pair.bid = bid;
-						pair.count = 1;
-					}
-				}
-				insert();
+			/**
+			 * Encodes this chunk using ChunkCodec::RLE.
+			 * Space is reserved at the start of @p encoding for the chunk position.
+			 */
+			void toRLE(std::vector<byte>& encoding) const;
+
+			/**
+			 * Sets the blocks from the output of toRLE, excluding the chunk position.
+			 * None blocks in the encoding are skipped.
+			 * @return True if any block was changed.
+			 */
+			bool fromRLE(const byte* begin, const byte* end);
+
+		private:
+			ENGINE_INLINE constexpr static bool isRenderable(const BlockId bid) noexcept {
+				return bid != BlockId::None && bid != BlockId::Air;
 			}
-			
-			bool fromRLE(const byte* begin, const byte* end) {
-				bool editMade = false;
-				constexpr auto sz = size.x * size.y;
-				BlockId* linear = &data[0][0];
-				RLEPair pair;
-
-				int i = 0;
-				while (begin != end) {
-					pair.bid = *reinterpret_cast<const decltype(pair.bid)*>(begin);
-					begin += sizeof(pair.bid);
-
-					if (pair.bid & RLE_COUNT_BIT) {
-						pair.bid ^= RLE_COUNT_BIT;
-						pair.count = 1;
-					} else {
-						pair.count = *reinterpret_cast<const decltype(pair.count)*>(begin);
-						begin += sizeof(pair.count);
-					}
 
-					while (pair.count) {
-						if (pair.bid != BlockId::None) {
-							editMade = editMade || (linear[i] == pair.bid);
-							linear[i] = pair.bid;
+			ENGINE_INLINE uint32 getRaw(const glm::ivec2 pos) const noexcept {
+				const auto bit = pos.y * bits;
+				const auto word = packed[pos.x * bits + bit / wordBits];
+				return static_cast<uint32>((word >> (bit % wordBits)) & ((Word{1} << bits) - 1));
+			}
+
+			ENGINE_INLINE void setRaw(const glm::ivec2 pos, const uint32 value) noexcept {
+				const auto bit = pos.y * bits;
+				auto& word = packed[pos.x * bits + bit / wordBits];
+				const auto shift = bit % wordBits;
+				const auto mask = ((Word{1} << bits) - 1) << shift;
+				word = (word & ~mask) | (Word{value} << shift);
+			}
+
+			/**
+			 * Gets the index of @p bid in the palette or -1 if it is not present.
+			 */
+			[[nodiscard]]
+			int32 paletteIndex(const BlockId bid) const noexcept;
+
+			/**
+			 * Repacks the storage to use @p newBits bits per block.
+			 */
+			void repack(const uint8 newBits) noexcept;
+
+			/**
+			 * Rebuilds the derived masks for a single column.
+			 */
+			void updateMasks(const int32 x) noexcept;
+
+			/**
+			 * Greedily merges the set bits of @p usable into rectangles. Each rectangle
+			 * is grown first along y and then along x, matching the order of a per
+			 * block scan, but operates on whole columns at a time.
+			 *
+			 * @param usable The blocks that may be part of a rectangle.
+			 * @param matchMask Called as `matchMask(x, bid)` to get the blocks in column `x` which may be merged with `bid`.
+			 * @param submitArea Called as `submitArea(begin, end)` for each half open rectangle.
+			 */
+			template<class MatchMask, class SubmitArea>
+			ENGINE_INLINE void greedyExpand(const ColumnMask (&usable)[size.x], MatchMask&& matchMask, SubmitArea&& submitArea) const {
+				ColumnMask remaining[size.x];
+				std::copy(std::begin(usable), std::end(usable), std::begin(remaining));
+
+				for (int32 x = 0; x < size.x; ++x) {
+					while (remaining[x]) {
+						const int32 y = std::countr_zero(remaining[x]);
+						const auto bid = getBlock({x, y});
+						const int32 len = std::countr_one((remaining[x] & matchMask(x, bid)) >> y);
+						const auto run = (len == size.y ? ~ColumnMask{0} : ((ColumnMask{1} << len) - 1)) << y;
+						remaining[x] &= ~run;
+
+						int32 end = x + 1;
+						for (; end < size.x; ++end) {
+							if ((remaining[end] & run) != run) { break; }
+							if ((matchMask(end, bid) & run) != run) { break; }
+							remaining[end] &= ~run;
 						}
 
-						++i;
-						--pair.count;
+						submitArea(glm::ivec2{x, y}, glm::ivec2{end, y + len});
 					}
 				}
-
-				return editMade;
 			}
 	};
 }
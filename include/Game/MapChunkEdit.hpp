@@ -0,0 +1,91 @@
+#pragma once
+
+// STD
+#include <vector>
+
+// GLM
+#include <glm/glm.hpp>
+
+// Game
+#include <Game/Common.hpp>
+#include <Game/MapChunk.hpp>
+
+
+namespace Game {
+	/**
+	 * A sparse set of block changes to a single chunk.
+	 *
+	 * Edits are stored as a list of (index, block) entries so that applying,
+	 * encoding, and clearing are proportional to the number of edited blocks
+	 * instead of the size of the chunk. Setting the same block multiple times
+	 * keeps only the latest value.
+	 */
+	class MapChunkEdit {
+		public:
+			struct Entry {
+				/** The linear index of the block. @see toIndex */
+				uint16 index;
+				BlockId bid;
+			};
+			static_assert(sizeof(Entry) == 4); // Ensure tight packing
+			static_assert(MapChunk::size.x * MapChunk::size.y <= 0xFFFF + 1, "Block index does not fit in Entry::index.");
+
+		private:
+			std::vector<Entry> edits;
+
+			/** The blocks that have an entry in `edits`. */
+			MapChunk::ColumnMask touched[MapChunk::size.x] = {};
+
+		public:
+			/**
+			 * Converts a block position to the linear index used by entries.
+			 * Matches the order of MapChunk::DenseData.
+			 */
+			ENGINE_INLINE constexpr static uint16 toIndex(const glm::ivec2 pos) noexcept {
+				return static_cast<uint16>(pos.x * MapChunk::size.y + pos.y);
+			}
+
+			/**
+			 * Converts a linear index from an entry back to a block position.
+			 */
+			ENGINE_INLINE constexpr static glm::ivec2 toPos(const uint16 index) noexcept {
+				return {index / MapChunk::size.y, index % MapChunk::size.y};
+			}
+
+			/**
+			 * Sets the block at a position, replacing any previous edit to that block.
+			 */
+			void set(const glm::ivec2 pos, const BlockId bid) noexcept;
+
+			/**
+			 * Removes all edits. Keeps the allocated storage for reuse.
+			 */
+			void clear() noexcept;
+
+			/**
+			 * Encodes the edits for network transfer as runs of consecutive blocks with the same value.
+			 * Like MapChunk::toRLE space is reserved at the start for the chunk position.
+			 */
+			void encode(std::vector<byte>& encoding) const;
+
+			/**
+			 * Adds edits from the output of encode, excluding the chunk position.
+			 * @return False if the data is malformed. Any entries before the malformed data are kept.
+			 */
+			bool decode(const byte* begin, const byte* end);
+
+			/**
+			 * Adds an edit for each non-None block in @p blocks.
+			 */
+			void fromDense(const MapChunk::DenseData& blocks);
+
+			[[nodiscard]]
+			ENGINE_INLINE const std::vector<Entry>& entries() const noexcept { return edits; }
+
+			[[nodiscard]]
+			ENGINE_INLINE bool empty() const noexcept { return edits.empty(); }
+
+			[[nodiscard]]
+			ENGINE_INLINE size_t size() const noexcept { return edits.size(); }
+	};
+}
@@ -100,6 +100,26 @@ namespace Game {
 				BlockId block;
 			};
 
+			/**
+			 * Noise samples that are evaluated for a whole column at once.
+			 * @see sample
+			 */
+			enum class Sample : uint8 {
+				BasisDefault,
+				BasisForest,
+				BasisJungle,
+				ResourceGold,
+				ResourceIron,
+				BlockStrength1,
+				BlockStrength2,
+				_COUNT,
+			};
+
+			/**
+			 * Values shared by a vertical run of blocks. Defined in MapGenerator2.cpp.
+			 */
+			struct Column;
+
 			/** Variance in underlying terrain height */
 			constexpr static Float heightVar = 5000.0; // 
 			constexpr static Float biomeScales[] = { // Must be divisible by the previous depth
@@ -134,33 +154,68 @@ namespace Game {
 
 
 			/**
+			 * Generates a whole chunk. Gives the same results as calling value for each
+			 * block but shares work between blocks in the same column.
 			 * @param pos The position of the chunk in block coordinates.
 			 * @param chunk The chunk to store the data in.
 			 */
 			void init(const IVec2 pos, MapChunk& chunk, std::vector<BlockEntityDesc>& entData) const noexcept;
 
+			/**
+			 * Gets the biome at a position in block coordinates.
+			 */
+			[[nodiscard]]
+			Biome biome(const IVec2 pos) const noexcept;
+
 		private:
 			// TODO: doc stages
+
+			/**
+			 * Computes the values shared by the blocks `[y, y + count)` in column @p x.
+			 */
+			void initColumn(Column& col, const Int x, const Int y, const Int count) const noexcept;
+
+			/**
+			 * Gets the block at height @p y in a column initialized with initColumn.
+			 */
+			BlockId value(Column& col, const Int y, BlockGenData& bgd) const noexcept;
+
+			/**
+			 * Gets a noise sample for the current block in a column.
+			 * The first use of each sample evaluates it for the whole column at once.
+			 */
+			[[nodiscard]]
+			Float sample(Column& col, const Sample s) const noexcept;
 			
 			template<Biome B>
-			ENGINE_INLINE BlockId calc(const IVec2 ipos, const FVec2 pos, const Float h0, const FVec2 posBiome, const BiomeBounds bounds, BlockGenData& bgd) const noexcept;
+			ENGINE_INLINE BlockId calc(Column& col, const IVec2 ipos, const FVec2 pos, const FVec2 posBiome, const BiomeBounds bounds, BlockGenData& bgd) const noexcept;
 			
 			[[nodiscard]]
-			BlockId resource(const FVec2 pos) const noexcept;
+			BlockId resource(Column& col, const FVec2 pos) const noexcept;
 			
 			[[nodiscard]]
 			ENGINE_INLINE BiomeBounds biomeAt(const FVec2 pos) const noexcept;
 
+			[[nodiscard]]
+			ENGINE_INLINE Biome biomeFor(const BiomeBounds bounds) const noexcept;
+
 			[[nodiscard]]
 			ENGINE_INLINE Float height0(const Float x) const noexcept;
 			
 			template<Biome B>
 			[[nodiscard]]
-			Int height(const Float x, const BiomeBounds bounds, const Float h0) const noexcept;
+			Int height(Column& col, const BiomeBounds bounds) const noexcept;
+
+			/**
+			 * Cached version of biomeHeightOffset.
+			 */
+			template<Biome B>
+			[[nodiscard]]
+			ENGINE_INLINE Float heightOffset(Column& col) const noexcept;
 			
 			template<Biome B>
 			[[nodiscard]]
-			ENGINE_INLINE LandmarkSample landmark(const FVec2 pos, const IVec2 ipos, const Int h, BlockGenData& bgd) const noexcept;
+			ENGINE_INLINE LandmarkSample landmark(const Column& col, const FVec2 pos, const IVec2 ipos, const Int h, BlockGenData& bgd) const noexcept;
 
 			template<Biome B>
 			[[nodiscard]]
@@ -168,11 +223,11 @@ namespace Game {
 
 			template<Biome B>
 			[[nodiscard]]
-			ENGINE_INLINE Float basis(const FVec2 pos, const Int h, const Float bstr) const noexcept;
+			ENGINE_INLINE Float basis(Column& col, const FVec2 pos, const Int h, const Float bstr) const noexcept;
 
 			template<Biome B>
 			[[nodiscard]]
-			ENGINE_INLINE BlockId block(const FVec2 pos, const FVec2 ipos, const Int h, const Float h0, const BiomeBounds bounds, const Float bstr) const noexcept;
+			ENGINE_INLINE BlockId block(Column& col, const FVec2 pos, const FVec2 ipos, const Int h, const BiomeBounds bounds, const Float bstr) const noexcept;
 
 			/*
 			[[nodiscard]]
@@ -188,6 +243,12 @@ namespace Game {
 				static_assert(L != L, "Missing specialization.");
 			}
 
+			/**
+			 * Checks if a boss portal exists in the given boss portal grid cell.
+			 */
+			[[nodiscard]]
+			ENGINE_INLINE bool bossPortalCell(const IVec2 cell) const noexcept;
+
 			////////////////////////////////////////////////////////////////////////////////
 			// Biome specialization functions
 			////////////////////////////////////////////////////////////////////////////////
@@ -199,7 +260,7 @@ namespace Game {
 			ENGINE_INLINE Float genericBiomeBasisStrength(const FVec2 posBiome, const BiomeBounds bounds) const noexcept;
 
 			[[nodiscard]]
-			ENGINE_INLINE bool genericBiomeBlockStrength(const FVec2 pos, const Float basisStrength) const noexcept;
+			ENGINE_INLINE bool genericBiomeBlockStrength(Column& col, const FVec2 pos, const Float basisStrength) const noexcept;
 
 			/**
 			 * Gets the offset from the base height curve at the location.
@@ -226,7 +287,7 @@ namespace Game {
 			 */
 			template<Biome B>
 			[[nodiscard]]
-			ENGINE_INLINE Float biomeBasis(const FVec2 pos, const Int h) const noexcept {
+			ENGINE_INLINE Float biomeBasis(Column& col, const FVec2 pos, const Int h) const noexcept {
 				static_assert(B != B, "Missing specialization for biome.");
 			}
 
@@ -245,7 +306,7 @@ namespace Game {
 			 */
 			template<Biome B>
 			[[nodiscard]]
-			ENGINE_INLINE BlockId biomeBlock(const FVec2 pos, const IVec2 ipos, const Int h, const Float h0, const BiomeBounds bounds) const noexcept {
+			ENGINE_INLINE BlockId biomeBlock(Column& col, const FVec2 pos, const IVec2 ipos, const Int h, const BiomeBounds bounds) const noexcept {
 				static_assert(B != B, "Missing specialization for biome.");
 			}
 
@@ -254,7 +315,7 @@ namespace Game {
 			 */
 			template<Biome B>
 			[[nodiscard]]
-			ENGINE_INLINE bool biomeBlockStrength(const FVec2 pos, const Float basisStrength) const noexcept {
+			ENGINE_INLINE bool biomeBlockStrength(Column& col, const FVec2 pos, const Float basisStrength) const noexcept {
 				static_assert(B != B, "Missing specialization for biome.");
 			}
 	};
@@ -0,0 +1,163 @@
+#pragma once
+
+// STD
+#include <atomic>
+#include <string>
+#include <vector>
+
+// GLM
+#include <glm/vec2.hpp>
+
+// Engine
+#include <Engine/Clock.hpp>
+
+// Game
+#include <Game/Common.hpp>
+#include <Game/MapChunk.hpp>
+#include <Game/BlockEntityData.hpp>
+
+
+namespace Game {
+	/**
+	 * A grouping of chunks. Used for saving/loading.
+	 *
+	 * Region files are little endian and consist of a header followed by the
+	 * RLE encoded blocks of each chunk in x major order and then the block entities
+	 * of the whole region. @see MapRegion::save @see MapRegion::writeBlockEntities
+	 */
+	class MapRegion {
+		public:
+			struct ChunkInfo {
+				MapChunk chunk;
+				std::vector<BlockEntityDesc> entData;
+
+				/** The prepared form of each entry in entData. Not saved. @see MapSystem::prepareBlockEntities */
+				std::vector<PreparedBlockEntity> prepared;
+			};
+
+			constexpr static glm::ivec2 size = {16, 16};
+
+			/** The version of the region file format. Increment when the layout changes. */
+			constexpr static uint32 fileVersion = 2;
+
+			/** The directory pre-generated and saved regions are stored in. */
+			constexpr static const char* bakeDirectory = "regions";
+
+			ChunkInfo data[size.x][size.y];
+			Engine::Clock::TimePoint lastUsed;
+
+			/**
+			 * If any blocks or block entities have changed since this region was loaded.
+			 * Only modified regions are saved when unloaded. @see MapSystem::unloadRegion
+			 */
+			bool modified = false;
+
+			/**
+			 * The number of chunks taken from the completion queue.
+			 * Only used on the main thread. @see MapSystem::completedChunks
+			 */
+			int32 completedCount = 0;
+
+		private:
+			/**
+			 * Set by the loading thread once the ChunkInfo of a chunk has been written.
+			 * Stored with release and loaded with acquire so the data is visible to the reader.
+			 */
+			std::atomic<bool> ready[size.x][size.y];
+			static_assert(std::atomic<bool>::is_always_lock_free);
+
+		public:
+			/**
+			 * Marks a chunk as done loading. Called by the thread that loaded it after writing its ChunkInfo.
+			 */
+			ENGINE_INLINE void setReady(const glm::ivec2 chunkIndex) noexcept {
+				ready[chunkIndex.x][chunkIndex.y].store(true, std::memory_order_release);
+			}
+
+			/**
+			 * Marks all chunks as done loading.
+			 */
+			void setAllReady() noexcept {
+				for (auto& col : ready) {
+					for (auto& r : col) { r.store(true, std::memory_order_release); }
+				}
+			}
+
+			/**
+			 * Checks if a chunk is done loading. The ChunkInfo of a chunk must not be accessed before this is true.
+			 */
+			[[nodiscard]]
+			ENGINE_INLINE bool isReady(const glm::ivec2 chunkIndex) const noexcept {
+				if constexpr (ENGINE_CLIENT) {
+					return true;
+				}
+
+				return ready[chunkIndex.x][chunkIndex.y].load(std::memory_order_acquire);
+			}
+
+			/**
+			 * Checks if any chunks have not yet been taken from the completion queue.
+			 * Once this is false no loading job references this region.
+			 */
+			[[nodiscard]]
+			bool loading() const noexcept {
+				if constexpr (ENGINE_CLIENT) {
+					return false;
+				}
+
+				return completedCount != size.x * size.y;
+			}
+
+			/**
+			 * Gets the approximate number of bytes used by this region including heap allocations.
+			 */
+			size_t memoryUsage() const noexcept {
+				size_t total = sizeof(*this);
+				for (const auto& col : data) {
+					for (const auto& info : col) {
+						total += info.chunk.memoryUsage() - sizeof(info.chunk);
+						total += info.entData.capacity() * sizeof(info.entData[0]);
+						total += info.prepared.capacity() * sizeof(info.prepared[0]);
+					}
+				}
+				return total;
+			}
+
+			/**
+			 * Gets the path of the file for the region at @p regionPos in @p dir.
+			 */
+			[[nodiscard]]
+			static std::string filePath(const std::string& dir, const glm::ivec2 regionPos);
+
+			/**
+			 * Writes all chunks in this region to a file.
+			 * @param seed The seed of the generator used. Stored so stale files can be detected.
+			 * @return True on success.
+			 */
+			bool save(const std::string& path, const glm::ivec2 regionPos, const int64 seed) const;
+
+			/**
+			 * Reads all chunks in this region from a file written by save.
+			 * Chunks are not marked as ready. @see setAllReady
+			 * @return False if the file could not be read or is for a different region, seed, or version.
+			 */
+			bool load(const std::string& path, const glm::ivec2 regionPos, const int64 seed);
+
+			/**
+			 * Appends the block entities of all chunks to @p out.
+			 *
+			 * The layout is a uint32 byte size of the rest of the section, a uint16 entity
+			 * count for each chunk in x major order, and then each entity. An entity is its
+			 * int16 block offset from the chunk origin, its uint8 type, and its type data.
+			 * Entities more than an int16 away from their chunk are skipped.
+			 */
+			void writeBlockEntities(std::vector<byte>& out, const glm::ivec2 regionPos) const;
+
+			/**
+			 * Reads the block entities of all chunks from the output of writeBlockEntities.
+			 * Replaces the existing ChunkInfo::entData.
+			 * @return The end of the section or nullptr if the data is malformed.
+			 */
+			const byte* readBlockEntities(const byte* begin, const byte* end, const glm::ivec2 regionPos);
+	};
+}
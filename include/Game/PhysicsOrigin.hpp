@@ -0,0 +1,24 @@
+#pragma once
+
+// Box2D
+#include <Box2D/Box2D.h>
+
+
+namespace Game {
+	/**
+	 * Moves the snapshot history and interpolation states of @p world to match a shift of the physics origin.
+	 * Split from PhysicsSystem::shiftOrigin so that it can be tested without a full World.
+	 * @tparam Body A snapshot relevant component with a `SnapshotData::trans` relative to the main world. @see PhysicsBodyComponent
+	 * @tparam Interp A component with `shiftOrigin(const b2Vec2&)`. @see PhysicsInterpComponent
+	 */
+	template<class Body, class Interp, class World>
+	void shiftComponentOrigin(World& world, const b2Vec2& newOrigin) {
+		world.template forEachComponentState<Body>([&](auto, auto& state){
+			state.trans.p -= newOrigin;
+		});
+
+		for (const auto ent : world.template getFilter<Interp>()) {
+			world.template getComponent<Interp>(ent).shiftOrigin(newOrigin);
+		}
+	}
+}
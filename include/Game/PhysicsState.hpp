@@ -0,0 +1,157 @@
+#pragma once
+
+// STD
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// Box2D
+#include <Box2D/Box2D.h>
+
+// Game
+#include <Game/Common.hpp>
+
+
+namespace Game {
+	/**
+	 * The state of the non-static bodies in a b2World along with the contacts involving them.
+	 *
+	 * Box2D warm starts its solver from the impulses of the previous step which are stored on each contact.
+	 * Restoring those along with the bodies allows a replay to reproduce the original simulation
+	 * where restoring only transforms and velocities would not.
+	 *
+	 * Box2D does not expose a body's sleep timer or a contact's touching flag so those are not restored.
+	 * Contacts that were created or destroyed after the state was stored are handled by Box2D on the next step as usual.
+	 * A replay is exact as long as the set of contacts is the same.
+	 *
+	 * Bodies are referenced by pointer so bodies must be removed with `remove` before they are destroyed.
+	 * Contacts are referenced by fixture pointers which Box2D reuses so they must be removed with `removeContacts`
+	 * before a body's fixtures are destroyed. Otherwise a stale manifold could be restored into an unrelated contact.
+	 */
+	class PhysicsState {
+		public:
+			class BodyState {
+				public:
+					b2Body* body;
+					b2Vec2 pos;
+					float32 angle;
+					b2Vec2 vel;
+					float32 angVel;
+					bool awake;
+			};
+
+			class ContactState {
+				public:
+					// These are only used to identify the contact and are never dereferenced.
+					const b2Fixture* fixtureA;
+					const b2Fixture* fixtureB;
+					const b2Body* bodyA;
+					const b2Body* bodyB;
+					int32 childA;
+					int32 childB;
+					b2Manifold manifold;
+			};
+
+		private:
+			std::vector<BodyState> bodies;
+
+			/** Sorted by fixtures and children. @see less */
+			std::vector<ContactState> contacts;
+
+		public:
+			/**
+			 * Stores the state of @p world.
+			 */
+			void store(b2World& world);
+
+			/**
+			 * Stores the state of @p world in addition to any already stored worlds.
+			 */
+			void add(b2World& world);
+
+			/**
+			 * Restores the state of the bodies in @p world for which `shouldLoad(const b2Body&)` is true.
+			 * Transforms are only set for bodies that have moved so unchanged and sleeping bodies do not touch the broad-phase.
+			 * Contact impulses are restored for contacts involving at least one restored body.
+			 * @return The number of bodies that needed their transform set.
+			 */
+			template<class Pred>
+			int32 load(b2World& world, Pred&& shouldLoad) const {
+				int32 moved = 0;
+
+				for (const auto& state : bodies) {
+					auto& body = *state.body;
+					if (body.GetWorld() != &world || !shouldLoad(std::as_const(body))) { continue; }
+
+					if (body.GetPosition() != state.pos || body.GetAngle() != state.angle) {
+						body.SetTransform(state.pos, state.angle);
+						++moved;
+					}
+
+					if (state.awake) {
+						body.SetAwake(true);
+						body.SetLinearVelocity(state.vel);
+						body.SetAngularVelocity(state.angVel);
+					} else if (body.IsAwake()) {
+						body.SetAwake(false);
+					}
+				}
+
+				if (contacts.empty()) { return moved; }
+
+				for (auto* contact = world.GetContactList(); contact; contact = contact->GetNext()) {
+					const auto* fixtureA = contact->GetFixtureA();
+					const auto* fixtureB = contact->GetFixtureB();
+					const ContactState key = {
+						.fixtureA = fixtureA,
+						.fixtureB = fixtureB,
+						.childA = contact->GetChildIndexA(),
+						.childB = contact->GetChildIndexB(),
+					};
+
+					const auto found = std::lower_bound(contacts.cbegin(), contacts.cend(), key, less);
+					if (found == contacts.cend() || less(key, *found)) { continue; }
+					if (!shouldLoad(*fixtureA->GetBody()) && !shouldLoad(*fixtureB->GetBody())) { continue; }
+
+					*contact->GetManifold() = found->manifold;
+				}
+
+				return moved;
+			}
+
+			/**
+			 * Restores the state of all bodies in @p world.
+			 * @see load
+			 */
+			ENGINE_INLINE int32 load(b2World& world) const {
+				return load(world, [](const b2Body&){ return true; });
+			}
+
+			/**
+			 * Moves the stored bodies from @p world to match `b2World::ShiftOrigin(newOrigin)`.
+			 * Contacts are stored in body space so are unaffected.
+			 */
+			void shiftOrigin(const b2World& world, const b2Vec2& newOrigin) noexcept;
+
+			/**
+			 * Removes a body and its contacts.
+			 */
+			void remove(const b2Body* body);
+
+			/**
+			 * Removes the contacts involving a body without removing the body.
+			 */
+			void removeContacts(const b2Body* body);
+
+			void clear() noexcept;
+
+			[[nodiscard]]
+			ENGINE_INLINE const auto& getBodies() const noexcept { return bodies; }
+
+			[[nodiscard]]
+			ENGINE_INLINE const auto& getContacts() const noexcept { return contacts; }
+
+		private:
+			static bool less(const ContactState& a, const ContactState& b) noexcept;
+	};
+}
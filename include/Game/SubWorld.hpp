@@ -0,0 +1,103 @@
+#pragma once
+
+// STD
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Box2D
+#include <Box2D/Box2D.h>
+
+// Engine
+#include <Engine/ECS/Entity.hpp>
+
+// Game
+#include <Game/Common.hpp>
+
+
+namespace Game {
+	/**
+	 * Groups players by proximity for SubWorldSystem.
+	 * Players in different worlds are merged within mergeRange and players in the same world are split beyond splitRange.
+	 * All positions are relative to the main world.
+	 */
+	class PlayerGroups {
+		public:
+			/**
+			 * Players in different worlds within this distance of each other are merged into the same world.
+			 * Must be larger than any range players interact over.
+			 */
+			constexpr static float32 mergeRange = 48.0f;
+
+			/**
+			 * Players in the same world are only split once they are this far apart.
+			 * Larger than mergeRange so that groups near the boundary are not constantly moving between worlds.
+			 * At least twice SubWorldSystem::bodyRange so that no body is near two groups.
+			 */
+			constexpr static float32 splitRange = 64.0f;
+
+			static_assert(mergeRange < splitRange);
+
+			struct Player {
+				Engine::ECS::Entity ent;
+
+				/** The world the player's body is in when grouped. */
+				b2World* physWorld;
+
+				/** The origin of `physWorld`. */
+				b2Vec2 origin;
+
+				b2Vec2 pos;
+
+				/** The index of the player's group. Set by build. */
+				int32 group = -1;
+			};
+
+			struct Group {
+				/** Indices into `players` */
+				std::vector<int32> players;
+				b2AABB bounds;
+
+				/** The world and origin assigned to this group by SubWorldSystem. */
+				b2World* physWorld = nullptr;
+				b2Vec2 origin = b2Vec2_zero;
+			};
+
+			std::vector<Player> players;
+			std::vector<Group> groups;
+
+		private:
+			/** Union-find parents used to group players. */
+			std::vector<int32> parents;
+
+		public:
+			/**
+			 * Groups `players` by proximity and sorts them by position on the x axis.
+			 * The first player of each group has the lowest index in that group. Groups are in the order of their first player.
+			 */
+			void build();
+
+			/**
+			 * Calls `func(const Player&)` for each player within @p range of @p pos on both axes.
+			 * Only valid after build.
+			 */
+			template<class Func>
+			void forEachNear(const b2Vec2 pos, const float32 range, Func&& func) const {
+				auto it = std::lower_bound(players.begin(), players.end(), pos.x - range, [](const Player& ply, const float32 x){
+					return ply.pos.x < x;
+				});
+
+				for (; it != players.end() && it->pos.x <= pos.x + range; ++it) {
+					if (std::abs(it->pos.y - pos.y) <= range) { func(*it); }
+				}
+			}
+	};
+
+	/**
+	 * Creates a copy of @p body in @p world with the same position relative to the main world.
+	 * Contacts and joints are not copied so the copy is not warm started on its first step.
+	 * @param fromOrigin The origin of the world @p body is in.
+	 * @param toOrigin The origin of @p world.
+	 */
+	b2Body* copyBodyToWorld(const b2Body& body, b2Vec2 fromOrigin, b2World& world, b2Vec2 toOrigin);
+}
@@ -41,6 +41,10 @@ namespace Game {
 			ENGINE_INLINE void render(const RenderLayer layer) {}
 
 			ENGINE_INLINE void preStoreSnapshot() {}
+			ENGINE_INLINE void preLoadSnapshot() {}
 			ENGINE_INLINE void postLoadSnapshot() {}
+
+			ENGINE_INLINE void preRollback() {}
+			ENGINE_INLINE void postRollback() {}
 	};
 }
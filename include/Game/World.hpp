@@ -16,6 +16,8 @@
 #include <Game/systems/PhysicsOriginShiftSystem.hpp>
 #include <Game/systems/PhysicsSystem.hpp>
 #include <Game/systems/PhysicsInterpSystem.hpp>
+#include <Game/systems/SpatialSystem.hpp>
+#include <Game/systems/LagCompensationSystem.hpp>
 #include <Game/systems/CharacterSpellSystem.hpp>
 #include <Game/systems/CameraTrackingSystem.hpp>
 #include <Game/systems/SubWorldSystem.hpp>
@@ -52,10 +54,12 @@ namespace Game {
 		// Game Logic
 		CharacterMovementSystem,
 		PhysicsOriginShiftSystem,
+		SubWorldSystem,
 		PhysicsSystem,
+		LagCompensationSystem,
 		CharacterSpellSystem,
-		//SubWorldSystem,
 		PhysicsInterpSystem,
+		SpatialSystem,
 		CameraTrackingSystem,
 		MapSystem,
 
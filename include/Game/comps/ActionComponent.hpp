@@ -39,6 +39,12 @@ namespace Game {
 			glm::vec2 screenTarget; // TODO: client only
 			glm::vec2 target;
 
+			/**
+			 * How many ticks behind this input's tick the client was displaying other entities.
+			 * @see LagCompensationSystem
+			 */
+			uint8 viewDelay = 0;
+
 			void netRead(Connection& conn) {
 				for (auto& b : buttons) {
 					// TODO: better interface for reading bits.
@@ -51,6 +57,8 @@ namespace Game {
 				const auto y = conn.read<32>();
 				target.x = reinterpret_cast<const float32&>(x);
 				target.y = reinterpret_cast<const float32&>(y);
+
+				viewDelay = static_cast<decltype(viewDelay)>(conn.read<8>());
 			}
 
 			friend std::ostream& operator<<(std::ostream& os, const ActionState& s) {
@@ -90,5 +98,9 @@ namespace Game {
 			ENGINE_INLINE const auto& getTarget() const {
 				return state->target;
 			}
+
+			ENGINE_INLINE auto getViewDelay() const {
+				return state->viewDelay;
+			}
 	};
 }
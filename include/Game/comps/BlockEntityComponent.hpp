@@ -8,6 +8,11 @@ namespace Game {
 	class BlockEntityComponent {
 		public:
 			glm::ivec2 block;
-			BlockEntityType type;
+
+			/**
+			 * The data the entity was built from.
+			 * Stored back into the chunk when it is deactivated. @see MapSystem::storeBlockEntity
+			 */
+			BlockEntityData data;
 	};
 }
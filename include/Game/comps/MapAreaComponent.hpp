@@ -1,16 +1,152 @@
 #pragma once
 
+// STD
+#include <vector>
+#include <bit>
+
 // Engine
-#include <Engine/FlatHashMap.hpp>
+#include <Engine/LRUMap.hpp>
 
 namespace Game {
+	/**
+	 * Tracks which chunks a client is subscribed to and what has been sent to it.
+	 *
+	 * Subscriptions are stored in a fixed size window of chunks centered on the player.
+	 * Chunks are indexed by their position modulo the window size so the window can
+	 * move without moving any data. Only chunks within `windowSize / 2` of `center`
+	 * are valid. Everything outside the window is unsubscribed.
+	 *
+	 * @see MapSystem::updateSubscriptions
+	 */
 	class MapAreaComponent {
 		public:
-			struct ChunkMeta {
-				Engine::ECS::Tick tick;
-				Engine::ECS::Tick last;
-			};
+			/** The width and height of the subscription window in chunks. */
+			constexpr static int32 windowSize = 32;
+
+			/** A bitmask of a single row of the window. */
+			using Row = uint32;
+			static_assert(sizeof(Row) * 8 == windowSize);
+			static_assert(std::has_single_bit(static_cast<uint32>(windowSize)), "Must be power of two");
+
+			/** The chunk the window is centered on. Only valid if `centered` is set. */
+			glm::ivec2 center = {};
+			bool centered = false;
+
+			/** The subscribed chunks. Bit x of row y. */
+			Row subscribed[windowSize] = {};
+
+			/** The chunks in `queue`. Bit x of row y. */
+			Row queued[windowSize] = {};
+
+			/** The last update sent for each subscribed chunk. Zero if a full chunk needs to be sent. */
+			Engine::ECS::Tick last[windowSize][windowSize] = {};
+
+			/** Subscribed chunks that may need an update sent. */
+			std::vector<glm::ivec2> queue;
+
+			/**
+			 * The number of chunks each client caches.
+			 * The server mirrors the cache of each client so both sides must agree.
+			 */
+			constexpr static int32 chunkCacheSize = 1024;
+
+			/**
+			 * The hash of each chunk the client has cached.
+			 * Updated in the same order as the client's cache so that both evict the same chunks.
+			 * @see MapSystem::chunkCache
+			 */
+			Engine::LRUMap<glm::ivec2, uint64> cached{chunkCacheSize};
+
+		public:
+			[[nodiscard]]
+			ENGINE_INLINE bool inWindow(const glm::ivec2 chunkPos) const noexcept {
+				const auto off = glm::abs(chunkPos - center);
+				return centered && off.x < windowSize / 2 && off.y < windowSize / 2;
+			}
+
+			[[nodiscard]]
+			ENGINE_INLINE bool isSubscribed(const glm::ivec2 chunkPos) const noexcept {
+				return inWindow(chunkPos) && (subscribed[wrap(chunkPos.y)] & bit(chunkPos));
+			}
+
+			[[nodiscard]]
+			ENGINE_INLINE bool isQueued(const glm::ivec2 chunkPos) const noexcept {
+				return inWindow(chunkPos) && (queued[wrap(chunkPos.y)] & bit(chunkPos));
+			}
+
+			/**
+			 * Gets the last update sent for a chunk. Only meaningful for subscribed chunks.
+			 */
+			[[nodiscard]]
+			ENGINE_INLINE Engine::ECS::Tick& lastAt(const glm::ivec2 chunkPos) noexcept {
+				return last[wrap(chunkPos.y)][wrap(chunkPos.x)];
+			}
+
+			/**
+			 * Subscribes to a chunk and queues it to be sent in full.
+			 * The chunk must be in the window.
+			 */
+			ENGINE_INLINE void subscribe(const glm::ivec2 chunkPos) {
+				ENGINE_DEBUG_ASSERT(inWindow(chunkPos), "Attempting to subscribe to chunk outside of the window.");
+				subscribed[wrap(chunkPos.y)] |= bit(chunkPos);
+				lastAt(chunkPos) = {};
+				enqueue(chunkPos);
+			}
+
+			ENGINE_INLINE void unsubscribe(const glm::ivec2 chunkPos) noexcept {
+				subscribed[wrap(chunkPos.y)] &= ~bit(chunkPos);
+				queued[wrap(chunkPos.y)] &= ~bit(chunkPos);
+			}
+
+			/**
+			 * Queues a subscribed chunk to be checked for updates.
+			 */
+			ENGINE_INLINE void enqueue(const glm::ivec2 chunkPos) {
+				auto& row = queued[wrap(chunkPos.y)];
+				if (row & bit(chunkPos)) { return; }
+				row |= bit(chunkPos);
+				queue.push_back(chunkPos);
+			}
+
+			ENGINE_INLINE void dequeue(const glm::ivec2 chunkPos) noexcept {
+				queued[wrap(chunkPos.y)] &= ~bit(chunkPos);
+			}
+
+			/**
+			 * Marks a chunk as queued without adding it to the queue.
+			 * Used to keep an existing entry in the queue after it has been dequeued.
+			 */
+			ENGINE_INLINE void markQueued(const glm::ivec2 chunkPos) noexcept {
+				queued[wrap(chunkPos.y)] |= bit(chunkPos);
+			}
+
+			/**
+			 * Calls `func(chunkPos)` for each subscribed chunk.
+			 */
+			template<class Func>
+			void forEachSubscribed(Func&& func) const {
+				if (!centered) { return; }
+				constexpr auto half = windowSize / 2;
+
+				for (int32 y = 0; y < windowSize; ++y) {
+					for (auto row = subscribed[y]; row; row &= row - 1) {
+						const int32 x = std::countr_zero(row);
+
+						// Find the position in the window with this index
+						const auto base = center - half + 1;
+						const glm::ivec2 chunkPos = base + glm::ivec2{wrap(x - base.x), wrap(y - base.y)};
+						func(chunkPos);
+					}
+				}
+			}
+
+		private:
+			ENGINE_INLINE constexpr static int32 wrap(const int32 v) noexcept {
+				return v & (windowSize - 1);
+			}
 
-			Engine::FlatHashMap<glm::ivec2, ChunkMeta> updates;
+			ENGINE_INLINE constexpr static Row bit(const glm::ivec2 chunkPos) noexcept {
+				return Row{1} << wrap(chunkPos.x);
+			}
 	};
 }
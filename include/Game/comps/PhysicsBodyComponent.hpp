@@ -1,5 +1,8 @@
 #pragma once
 
+// GLM
+#include <glm/vec2.hpp>
+
 // Box2D
 #include <Box2D/Box2D.h>
 
@@ -27,6 +30,13 @@ namespace Game {
 
 			// Hello! Did you modify/add/remove a member variable of this class? Make sure to update the move/copy/assignment functions.
 			b2Body* body = nullptr;
+
+			/**
+			 * The origin of the body's world relative to the main physics world.
+			 * Positions passed to and returned from this component are always relative to the main world.
+			 * @see SubWorldSystem
+			 */
+			b2Vec2 origin = b2Vec2_zero;
 			// TODO: rm - int* count = nullptr; // TODO: is this actually used? since we dont do rollback for this?
 
 			//PhysicsShape shape;
@@ -37,14 +47,46 @@ namespace Game {
 			bool snap = false; // TODO: this should probably be on the interp component?
 			bool rollbackOverride = false; // TODO: there is probably a better way to handle this.
 
+			/**
+			 * A transform relative to the map origin as sent over the network.
+			 * The position is float64 so that precision does not depend on distance from the map origin. @see PhysicsOriginShiftSystem
+			 */
+			struct NetTransform {
+				glm::dvec2 pos;
+				b2Rot q;
+
+				/**
+				 * @param origin The origin @p trans is relative to.
+				 */
+				[[nodiscard]]
+				ENGINE_INLINE static NetTransform from(const b2Transform& trans, const glm::dvec2 origin) noexcept {
+					return {origin + glm::dvec2{trans.p.x, trans.p.y}, trans.q};
+				}
+
+				/**
+				 * @param origin The origin the result should be relative to.
+				 */
+				[[nodiscard]]
+				ENGINE_INLINE b2Transform to(const glm::dvec2 origin) const noexcept {
+					const auto rel = pos - origin;
+					b2Transform trans;
+					trans.p = {static_cast<float32>(rel.x), static_cast<float32>(rel.y)};
+					trans.q = q;
+					return trans;
+				}
+			};
+
 			struct SnapshotData {
 				b2Transform trans = {};
 				b2Vec2 vel = {};
 				float32 angVel = {};
 				bool rollbackOverride = false; // TODO: there is probably a better way to handle this.
 
-				void netFrom(Connection& conn) { // TODO: not sure how to handle this and keep in sync with phys comp. There is probably a better solution
-					trans = *conn.read<b2Transform>();
+				/**
+				 * @param origin The current physics origin. @see PhysicsOriginShiftSystem::getOrigin
+				 */
+				void netFrom(Connection& conn, const glm::dvec2 origin) { // TODO: not sure how to handle this and keep in sync with phys comp. There is probably a better solution
+					trans = conn.read<NetTransform>()->to(origin);
 					vel = *conn.read<b2Vec2>();
 					rollbackOverride = true;
 				}
@@ -52,7 +94,7 @@ namespace Game {
 
 			operator SnapshotData() const noexcept {
 				return {
-					.trans = body->GetTransform(),
+					.trans = getTransform(),
 					.vel = body->GetLinearVelocity(),
 					.angVel = body->GetAngularVelocity(),
 					.rollbackOverride = rollbackOverride,
@@ -62,14 +104,22 @@ namespace Game {
 		public:
 			PhysicsBodyComponent() = default;
 			PhysicsBodyComponent& operator=(const SnapshotData& other) noexcept {
-				setTransform(other.trans.p, other.trans.q.GetAngle());
+				// Setting the transform updates the broad-phase so skip it if PhysicsSystem has already restored the body.
+				const auto& trans = getTransform();
+				if (trans.p != other.trans.p || trans.q.s != other.trans.q.s || trans.q.c != other.trans.q.c) {
+					setTransform(other.trans.p, other.trans.q.GetAngle());
+				}
+
 				setVelocity(other.vel);
 				setAngularVelocity(other.angVel);
 				rollbackOverride = other.rollbackOverride;
 				return *this;
 			}
 
-			void setBody(b2Body* body);
+			/**
+			 * @param origin The origin of the body's world. @see origin
+			 */
+			void setBody(b2Body* body, b2Vec2 origin = b2Vec2_zero);
 
 			// TODO: why does one return pointer and the other ref. Make both ref or pointer.
 			// TODO: we should get rid of these. Should write wrappers for any funcs we want.
@@ -79,10 +129,30 @@ namespace Game {
 			b2World* getWorld() { return body->GetWorld(); }
 			const b2World* getWorld() const { return body->GetWorld(); }
 
-			ENGINE_INLINE const auto& getTransform() const noexcept { return body->GetTransform(); }
-			ENGINE_INLINE void setTransform(const b2Vec2& pos, const float32 ang) { body->SetTransform(pos, ang); }
+			ENGINE_INLINE const b2Vec2& getOrigin() const noexcept { return origin; }
+
+			/**
+			 * Gets the transform relative to the map origin for sending over the network.
+			 * The server never shifts its main world so the origin of the body's world is also its offset from the map origin.
+			 */
+			ENGINE_INLINE NetTransform getNetTransform() const noexcept {
+				return NetTransform::from(body->GetTransform(), {origin.x, origin.y});
+			}
+
+			/**
+			 * Gets the transform relative to the main world.
+			 * On the server this is `body position + origin` as float32 so it loses precision far from the map origin
+			 * even though the body's own simulation does not. Use getNetTransform where that matters.
+			 */
+			ENGINE_INLINE b2Transform getTransform() const noexcept {
+				auto trans = body->GetTransform();
+				trans.p += origin;
+				return trans;
+			}
+			ENGINE_INLINE void setTransform(const b2Vec2& pos, const float32 ang) { body->SetTransform(pos - origin, ang); }
 
-			ENGINE_INLINE auto getPosition() const noexcept { return body->GetPosition(); };
+			/** @see getTransform */
+			ENGINE_INLINE auto getPosition() const noexcept { return body->GetPosition() + origin; };
 			ENGINE_INLINE void setPosition(const b2Vec2 p) noexcept { setTransform(p, getAngle()); };
 
 			ENGINE_INLINE float32 getAngle() const noexcept { return body->GetAngle(); };
@@ -115,7 +185,10 @@ namespace Game {
 
 			void netToInit(Engine::EngineInstance& engine, World& world, Engine::ECS::Entity ent, Engine::Net::BufferWriter& buff) const;
 
-			void netFrom(Connection& conn);
+			/**
+			 * @param origin The current physics origin. @see PhysicsOriginShiftSystem::getOrigin
+			 */
+			void netFrom(Connection& conn, glm::dvec2 origin);
 
 			void netFromInit(Engine::EngineInstance& engine, World& world, Engine::ECS::Entity ent, Connection& conn);
 	};
@@ -1,13 +1,19 @@
 #pragma once
 
+// STD
+#include <algorithm>
+
 // Box2D
 #include <box2d/b2_body.h>
 
 // Engine
+#include <Engine/SequenceBuffer.hpp>
+#include <Engine/StaticVector.hpp>
 #include <Engine/Net/Connection.hpp>
 #include <Engine/Net/Replication.hpp>
 
 // Game
+#include <Game/Common.hpp>
 #include <Game/Connection.hpp>
 
 
@@ -27,6 +33,58 @@ namespace Game {
 				return (t - prevTime).count() / static_cast<float64>(diff.count());
 			}
 
+			/** A state confirmed by the server. */
+			class ConfirmedState {
+				public:
+					Engine::ECS::Tick tick;
+					b2Transform trans;
+			};
+
+			/**
+			 * The states confirmed by the server ordered by tick.
+			 * Kept contiguous per entity so that interpolation can binary search it instead of walking the snapshot history.
+			 * @see PhysicsSystem::tick
+			 */
+			Engine::StaticVector<ConfirmedState, tickrate> confirmed;
+
+			/**
+			 * Records a state confirmed by the server.
+			 * If full the oldest state is dropped.
+			 */
+			void confirm(const Engine::ECS::Tick tick, const b2Transform& trans) noexcept {
+				const auto less = [](const ConfirmedState& state, Engine::ECS::Tick t){ return Engine::seqLess(state.tick, t); };
+				auto found = std::lower_bound(confirmed.begin(), confirmed.end(), tick, less);
+
+				if (found != confirmed.end() && found->tick == tick) {
+					found->trans = trans;
+					return;
+				}
+
+				if (confirmed.size() == confirmed.capacity()) {
+					if (found == confirmed.begin()) { return; }
+					std::move(confirmed.begin() + 1, found, confirmed.begin());
+					--found;
+				} else {
+					confirmed.resize(confirmed.size() + 1);
+					std::move_backward(found, confirmed.end() - 1, confirmed.end());
+				}
+
+				*found = {tick, trans};
+			}
+
+			/**
+			 * Moves all stored transforms to match a shift of the physics origin.
+			 * @see PhysicsSystem::shiftOrigin
+			 */
+			void shiftOrigin(const b2Vec2& newOrigin) noexcept {
+				trans.p -= newOrigin;
+				nextTrans.p -= newOrigin;
+				prevTrans.p -= newOrigin;
+				for (auto& state : confirmed) {
+					state.trans.p -= newOrigin;
+				}
+			}
+
 		public:
 			bool onlyUserVerified = false;
 			const auto& getPosition() const { return trans.p; }
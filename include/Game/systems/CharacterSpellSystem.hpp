@@ -5,33 +5,57 @@
 
 // Engine
 #include <Engine/EngineInstance.hpp>
+#include <Engine/ECS/SpatialIndex.hpp>
 
 // Game
 #include <Game/System.hpp>
-#include <Game/PhysicsListener.hpp>
 
 
 namespace Game {
-	class CharacterSpellSystem : public System, public PhysicsListener {
+	class CharacterSpellSystem : public System {
 		public:
+			/** The radius of a missile's sensor. */
+			constexpr static float32 missileRadius = 0.5f;
+
 			CharacterSpellSystem(SystemArg arg);
 			void setup();
 			void tick();
-			void queueMissile(const b2Vec2& pos, const b2Vec2& dir);
+
+			/**
+			 * @param hit If the missile should detonate as soon as it is fired. Set by the server for validated hits.
+			 */
+			void queueMissile(const b2Vec2& pos, const b2Vec2& dir, bool hit = false);
 
 		private:
 			struct FireEvent {
 				Engine::ECS::Entity ent;
 				b2Vec2 pos;
 				b2Vec2 dir;
+
+				/** If the missile hit another player as the firing player saw them. @see LagCompensationSystem */
+				bool hit = false;
 			};
 
-			void fireMissile(const b2Vec2& pos, const b2Vec2& dir);
-			void beginContact(const Engine::ECS::Entity& entA, const Engine::ECS::Entity& entB) override;
+			/** The velocity of a missile fired in @p dir. */
+			ENGINE_INLINE static b2Vec2 missileVelocity(const b2Vec2& dir) noexcept { return 4.0f * dir; }
+
+			/**
+			 * Activates the next missile from the pool.
+			 * On the server the missile is first moved into the world of @p ent, the player firing it. @see SubWorldSystem
+			 */
+			Engine::ECS::Entity fireMissile(Engine::ECS::Entity ent, const b2Vec2& pos, const b2Vec2& dir);
+
+			/**
+			 * Checks if a missile fired by @p ent hits another player as @p ent saw them.
+			 * The missile is moved along its path for each tick between the tick @p ent was viewing and the current tick
+			 * and checked against the other players at that tick. Later hits are left to the server's own simulation.
+			 */
+			bool validateHit(Engine::ECS::Entity ent, const b2Vec2& pos, const b2Vec2& vel);
+
 			void detonateMissile(Engine::ECS::Entity ent);
 			std::vector<Engine::ECS::Entity> missiles;
-			std::vector<Engine::ECS::Entity> toDestroy;
 			std::vector<FireEvent> events;
 			size_t currentMissile = 0;
+			Engine::ECS::SpatialIndex::Results hitResults;
 	};
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+// Engine
+#include <Engine/ECS/SpatialIndex.hpp>
+
 // Game
 #include <Game/System.hpp>
 #include <Game/comps/ECSNetworkingComponent.hpp>
@@ -15,6 +18,9 @@ namespace Game {
 
 			Engine::Clock::TimePoint nextUpdate = {};
 
+			/** Reused between neighbor queries. */
+			Engine::ECS::SpatialIndex::Results neighborResults;
+
 		public:
 			using System::System;
 			void run(float32 dt);
@@ -0,0 +1,93 @@
+#pragma once
+
+// STD
+#include <array>
+#include <span>
+
+// Engine
+#include <Engine/Clock.hpp>
+#include <Engine/ECS/SpatialIndex.hpp>
+
+// Game
+#include <Game/System.hpp>
+
+
+namespace Game {
+	/**
+	 * Evaluates spatial queries against entity positions as a client saw them when they sent an input.
+	 *
+	 * Only positions are rewound. Nothing is rolled back and no physics is simulated, the positions are read from the
+	 * PhysicsBodyComponent states in the snapshot history and put in a spatial index. Indexes are built on first use
+	 * and cached by tick so that players viewing the same tick share one index.
+	 *
+	 * Building indexes is limited to a fixed budget per tick. Once the budget is spent queries use the nearest cached
+	 * tick instead, or the current positions if there is none.
+	 *
+	 * Component filters use each entity's current components. Results may contain entities that have since been destroyed.
+	 * Only runs on the server.
+	 *
+	 * @see ActionComponent::getViewDelay
+	 */
+	class LagCompensationSystem : public System {
+		public:
+			/** The furthest back, in ticks, a client's view is rewound. Larger delays are clamped. */
+			constexpr static int32 maxRewind = tickrate / 2;
+
+			/** The time that may be spent building indexes each tick. */
+			constexpr static auto budget = std::chrono::microseconds{1000};
+
+		private:
+			struct Frame {
+				/** The snapshot tick this index was built from. */
+				Engine::ECS::Tick tick = {};
+				bool valid = false;
+				Engine::ECS::SpatialIndex index;
+			};
+
+			std::array<Frame, maxRewind + 1> frames;
+
+			/** Time spent building indexes this tick. */
+			Engine::Clock::Duration spent = {};
+
+			/** Number of queries this tick that could not use the requested tick. */
+			int32 fallbacks = 0;
+
+		public:
+			LagCompensationSystem(SystemArg arg);
+
+			void preTick();
+
+			/**
+			 * Gets the tick an entity was viewing other entities at for its current input.
+			 * The positions viewed are those at the end of that tick.
+			 */
+			[[nodiscard]]
+			Engine::ECS::Tick getViewTick(Engine::ECS::Entity ent) const;
+
+			/**
+			 * Finds the entities within @p radius of @p center at the end of @p viewTick that have at least the components in @p with.
+			 * @return The entities found. Only valid until the next query using @p out.
+			 * @see Engine::ECS::SpatialIndex::queryRadius
+			 */
+			std::span<const Engine::ECS::Entity> queryRadius(
+				const Engine::ECS::Tick viewTick,
+				const glm::vec2 center,
+				const float32 radius,
+				const Engine::ECS::ComponentBitset& with,
+				Engine::ECS::SpatialIndex::Results& out
+			);
+
+			/**
+			 * Gets an index of the entity positions at the end of @p viewTick.
+			 * @return The requested index or the closest one available. Valid until the next tick.
+			 */
+			const Engine::ECS::SpatialIndex& getIndex(const Engine::ECS::Tick viewTick);
+
+		private:
+			/**
+			 * Builds the index for a snapshot tick.
+			 * @return False if the tick is not in the snapshot history.
+			 */
+			bool build(Frame& frame, const Engine::ECS::Tick snapTick);
+	};
+}
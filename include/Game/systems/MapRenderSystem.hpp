@@ -10,6 +10,7 @@
 
 // Game
 #include <Game/Common.hpp>
+#include <Game/System.hpp>
 #include <Game/MapChunk.hpp>
 
 
@@ -18,12 +18,18 @@
 #include <Engine/Clock.hpp>
 #include <Engine/ECS/Common.hpp>
 #include <Engine/ThreadSafeQueue.hpp>
+#include <Engine/LRUMap.hpp>
 
 // Game
 #include <Game/Common.hpp>
 #include <Game/MapChunk.hpp>
+#include <Game/MapChunkEdit.hpp>
+#include <Game/ChunkCodec.hpp>
 #include <Game/MapGenerator2.hpp>
+#include <Game/MapRegion.hpp>
+#include <Game/systems/PhysicsSystem.hpp>
 #include <Game/Connection.hpp>
+#include <Game/comps/MapAreaComponent.hpp>
 
 // TODO: Document the different coordinate systems and terms used here.
 // TODO: convert to use sized types - int32, float32, etc.
@@ -31,7 +37,7 @@
 // TODO: Standardize terms to be `xyzOffset`, `xyzPosition`, `xyzIndex`
 /**
  * World Coordinates - Always relative to Box2D origin. When mapOffset is changed
- * Region - A grouping of chunks. Used for saving/loading.
+ * Region - A grouping of chunks. Used for saving/loading. @see MapRegion
  *
  * xyzOffset - The position of xyz relative to the current origin shift.
  * xyzPos - The position of xyz in absolute terms. Always the same regardless of the origin shift.
@@ -39,29 +45,6 @@
  *
  */
 namespace Game {
-	class MapRegion {
-		public:
-			struct ChunkInfo {
-				MapChunk chunk;
-				std::vector<BlockEntityDesc> entData;
-			};
-
-			constexpr static glm::ivec2 size = {16, 16};
-			ChunkInfo data[size.x][size.y];
-			std::atomic<int32> loadedChunks = 0;
-			Engine::Clock::TimePoint lastUsed;
-
-			bool loading() const {
-				// TODO: look into which memory order is needed
-				if constexpr (ENGINE_CLIENT) {
-					return false;
-				}
-
-				return loadedChunks.load() != size.x * size.y;
-			}
-			static_assert(decltype(loadedChunks)::is_always_lock_free);
-	};
-
 	// TODO: move
 	class MapEditComponent {
 		public:
@@ -85,6 +68,35 @@ namespace Game {
 			static_assert(!(activeAreaSize.x & (activeAreaSize.x - 1)), "Must be power of two");
 			static_assert(!(activeAreaSize.y & (activeAreaSize.y - 1)), "Must be power of two");
 
+			/** The codec used to send full chunks to clients. @see ChunkCodec */
+			constexpr static ChunkCodec chunkCodec = ChunkCodec::RANS;
+
+			/** How many chunks around the player's chunk to load and subscribe to. */
+			constexpr static glm::ivec2 playAreaSize = {5, 5};
+
+			/**
+			 * How many chunks beyond playAreaSize to keep loaded and subscribed before unloading.
+			 * We want a larger unload area so that we arent constantly loading/unloading
+			 * when a player is near a chunk border.
+			 */
+			constexpr static glm::ivec2 playBufferSize = {7, 7};
+			static_assert(glm::all(glm::lessThan(playAreaSize + playBufferSize, glm::ivec2{MapAreaComponent::windowSize / 2})),
+				"Subscribed area does not fit in the MapAreaComponent window."
+			);
+
+			/**
+			 * How many deactivated chunks to keep built so they can be reactivated without rebuilding.
+			 * Past this the least recently used are released to the pool.
+			 * @see warmChunks
+			 */
+			constexpr static size_t warmChunkLimit = 128;
+
+			/**
+			 * The max number of block entities to build each tick.
+			 * Chunks with more than this are built over multiple ticks.
+			 */
+			constexpr static int32 blockEntityBuildBudget = 32;
+
 		public:
 			MapSystem(SystemArg arg);
 			~MapSystem();
@@ -95,6 +107,11 @@ namespace Game {
 			void ensurePlayAreaLoaded(Engine::ECS::Entity ply);
 
 			void chunkFromNet(Connection& from, const Engine::Net::MessageHeader& head);
+			void chunkEditFromNet(Connection& from, const Engine::Net::MessageHeader& head);
+			void chunkCachedFromNet(Connection& from, const Engine::Net::MessageHeader& head);
+			void chunkRequestFromNet(Connection& from, const Engine::Net::MessageHeader& head, Engine::ECS::Entity ply);
+
+			void onComponentRemoved(const Engine::ECS::Entity ent, MapAreaComponent& comp);
 
 			// TODO: Name? this isnt consistent with our other usage of offset
 			// TODO: Doc. Gets the size of the current offset in blocks coordinates
@@ -172,34 +189,89 @@ namespace Game {
 			Engine::TextureArray2D texArr;
 
 			struct TestData { // TODO: rename
-				b2Body* body;
+				b2Body* body = nullptr;
 				Engine::Graphics::Mesh mesh;
 				Engine::Clock::TimePoint lastUsed;
 				Engine::ECS::Tick updated = {};
-				std::vector<byte> rle;
 
-				// TODO: need to serialize for unloaded/inactive chunks. Just a vector<byte> should work?
+				/** The encoded edits from the last update. @see MapChunkEdit::encode */
+				std::vector<byte> edits;
+
+				/** The hash of the chunk as of `hashed`. @see MapChunk::hash */
+				uint64 hash = 0;
+				Engine::ECS::Tick hashed = {};
+
+				/**
+				 * The MAP_CHUNK message for the chunk as of `encodedTick`.
+				 * Built on demand and shared by every client that needs a full copy of this chunk.
+				 * Replaced instead of modified since it may still be referenced by unacknowledged messages.
+				 */
+				std::shared_ptr<const std::vector<byte>> encoded;
+				Engine::ECS::Tick encodedTick = {};
+
+				/** The block entities built for this chunk. Stored back into the chunk's entData on deactivation. @see deactivateChunk */
 				std::vector<Engine::ECS::Entity> blockEntities;
+
+				/** The number of entries in the chunk's entData that have been built. */
+				size_t entDataBuilt = 0;
 			};
 
 			Engine::FlatHashMap<glm::ivec2, TestData> activeChunks;
-			Engine::FlatHashMap<glm::ivec2, MapChunk> chunkEdits;
+
+			/**
+			 * Recently deactivated chunks that still have their body and mesh built.
+			 * Their body is disabled and block entities have been stored.
+			 * Dropped if the chunk is edited while inactive.
+			 */
+			Engine::FlatHashMap<glm::ivec2, TestData> warmChunks;
+
+			Engine::FlatHashMap<glm::ivec2, MapChunkEdit> chunkEdits;
+
+			struct CachedChunk {
+				uint64 hash;
+				ChunkCodec codec;
+
+				/** The encoded blocks. @see encodeChunk */
+				std::vector<byte> data;
+			};
+
+			/**
+			 * Full chunks received from the server so they don't need to be sent
+			 * again when they become active. Mirrored on the server by MapAreaComponent::cached.
+			 */
+			Engine::LRUMap<glm::ivec2, CachedChunk> chunkCache{MapAreaComponent::chunkCacheSize};
 
 		private:
 			std::thread threads[ENGINE_DEBUG ? 8 : 2]; // TODO: Some kind of worker thread pooling in EngineInstance?
 
-			/** Used for sending full RLE chunk updates */
-			std::vector<byte> rleTemp;
-
 			// TODO: C++20: use atomic_flag since it now has a `test` member function.
 			std::atomic<bool> threadsShouldExit = false;
 			static_assert(decltype(threadsShouldExit)::is_always_lock_free);
 
 			using Job = std::function<void()>;
 			Engine::ThreadSafeQueue<Job> chunkQueue;
+
+			/**
+			 * Chunks that have finished loading. Pushed by the loading threads after MapRegion::setReady.
+			 * Drained once per tick to track which regions still have loading jobs.
+			 */
+			Engine::ThreadSafeQueue<glm::ivec2> completedChunks;
+			std::vector<glm::ivec2> completedTemp;
 			Engine::FlatHashMap<glm::ivec2, std::unique_ptr<MapRegion>> regions;
 			Engine::ECS::Entity mapEntity;
 
+			/** The players subscribed to each chunk. The reverse of MapAreaComponent::subscribed. */
+			Engine::FlatHashMap<glm::ivec2, std::vector<Engine::ECS::Entity>> subscribers;
+
+			/** Released chunk data. Reused on activation so bodies, meshes and buffers aren't recreated. */
+			std::vector<TestData> chunkDataPool;
+
+			/** Active chunks that have block entities left to build. @see buildQueuedBlockEntities */
+			std::vector<glm::ivec2> blockEntityQueue;
+
+			/** The textures used by trees. Indexed by PreparedBlockEntity::texture. */
+			Engine::TextureRef treeTextures[3];
+
 			struct Vertex {
 				glm::vec2 pos;
 				GLfloat tex;
@@ -209,9 +281,9 @@ namespace Game {
 			std::vector<Vertex> buildVBOData;
 			std::vector<GLushort> buildEBOData;
 
-			MapGenerator2 mgen{12345};
+			constexpr static int64 seed = 12345;
+			MapGenerator2 mgen{seed};
 
-			// TODO: recycle old bodies?
 			b2Body* createBody();
 
 			void setupMesh(Engine::Graphics::Mesh& mesh) const;
@@ -219,20 +291,95 @@ namespace Game {
 			// TODO: Doc
 			void buildActiveChunkData(TestData& data, glm::ivec2 chunkPos);
 
+			/**
+			 * Gets chunk data from the pool or creates new data if the pool is empty.
+			 * The body is disabled and has no fixtures.
+			 */
+			TestData acquireChunkData();
+
+			/**
+			 * Clears chunk data and returns it to the pool.
+			 * Block entities must already have been stored.
+			 */
+			void releaseChunkData(TestData& data);
+
+			/**
+			 * Moves an active chunk to warmChunks. Evicts the least recently used warm chunk if over warmChunkLimit.
+			 */
+			void deactivateChunk(glm::ivec2 chunkPos, TestData& data);
+
+			/**
+			 * Decodes a full chunk from the server into chunkEdits.
+			 * @return False if the data is malformed.
+			 */
+			bool applyChunkFromNet(glm::ivec2 chunkPos, const CachedChunk& cached);
+
+			/**
+			 * Updates the hash and MAP_CHUNK message of an active chunk if it has changed since they were last built.
+			 * @param full Also build the MAP_CHUNK message.
+			 */
+			void updateChunkEncoding(TestData& data, glm::ivec2 chunkPos, const MapChunk& chunk, bool full);
+
+			/**
+			 * Sets the updated tick of an active chunk and queues it for all subscribers.
+			 */
+			void markChunkUpdated(glm::ivec2 chunkPos, TestData& data, Engine::ECS::Tick tick);
+
+			/**
+			 * Queues a reactivated warm chunk for all subscribers.
+			 * Subscribers that did not receive the latest update are sent the full chunk.
+			 */
+			void queueReactivatedChunk(glm::ivec2 chunkPos, const TestData& data);
+
+			/**
+			 * Moves the subscription window of a player to be centered on @p center.
+			 * Only the chunks entering or leaving the play and buffer areas are visited.
+			 */
+			void updateSubscriptions(Engine::ECS::Entity ply, MapAreaComponent& mapAreaComp, glm::ivec2 center);
+
+			void subscribe(Engine::ECS::Entity ply, MapAreaComponent& mapAreaComp, glm::ivec2 chunkPos);
+			void unsubscribe(Engine::ECS::Entity ply, MapAreaComponent& mapAreaComp, glm::ivec2 chunkPos);
+
 			// TODO: Doc
 			void loadChunk(const glm::ivec2 chunkPos, MapRegion::ChunkInfo& chunkInfo) const noexcept;
 
+			/**
+			 * Fills ChunkInfo::prepared from ChunkInfo::entData.
+			 * Doesn't access the world so it is safe to call from the loading threads.
+			 */
+			static void prepareBlockEntities(MapRegion::ChunkInfo& chunkInfo);
+
+			/**
+			 * Builds block entities for the chunks in blockEntityQueue up to blockEntityBuildBudget.
+			 */
+			void buildQueuedBlockEntities();
+
 			// TODO: Doc
 			void loadChunkAsyncWorker();
 
+			/**
+			 * Saves a region to MapRegion::bakeDirectory if it has been modified. Called before the region is removed.
+			 * Server only. Regions still loaded at shutdown are not saved.
+			 */
+			void unloadRegion(const glm::ivec2 regionPos, const MapRegion& region);
+
 			// TODO: Doc
 			void queueRegionToLoad(glm::ivec2 regionPos, MapRegion& region);
 
 			template<BlockEntityType Type>
-			Engine::ECS::Entity buildBlockEntity(const BlockEntityDesc& data) {
+			static void prepareBlockEntity(const BlockEntityDesc& desc, PreparedBlockEntity& prep) {
+				static_assert(Type != Type, "Missing specialization.");
+			}
+
+			template<BlockEntityType Type>
+			Engine::ECS::Entity buildBlockEntity(const BlockEntityDesc& data, const PreparedBlockEntity& prep) {
 				static_assert(Type != Type, "Missing specialization.");
 			}
 
+			/**
+			 * Updates @p data with any state of @p ent that has changed since it was built.
+			 * @p data starts as a copy of BlockEntityComponent::data.
+			 */
 			template<BlockEntityType Type>
 			void storeBlockEntity(BlockEntityTypeData<Type>& data, const Engine::ECS::Entity ent) {
 				static_assert(Type != Type, "Missing specialization.");
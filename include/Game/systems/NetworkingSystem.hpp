@@ -1,5 +1,8 @@
 #pragma once
 
+// STD
+#include <vector>
+
 // PCG
 #include <pcg_random.hpp>
 
@@ -58,6 +61,21 @@ namespace Game {
 			// TODO: at some point we probably want to shrink this
 			Engine::FlatHashMap<Engine::ECS::Entity, Engine::ECS::Entity> entToLocal;
 
+			/** A packet received while a rollback was being replayed. */
+			struct BufferedPacket {
+				Engine::Net::IPv4Address address;
+				Engine::Clock::TimePoint time;
+				int32 size;
+				Engine::Net::Packet packet;
+			};
+
+			/**
+			 * Packets received while a rollback replay spread over multiple frames is in progress.
+			 * Messages create and destroy entities, change components and write corrections to the history, none of which
+			 * can be applied to the past state being replayed. Processed in order once the replay is complete.
+			 */
+			std::vector<BufferedPacket> bufferedPackets;
+
 		public:
 			NetworkingSystem(SystemArg arg);
 			void run(float32 dt);
@@ -77,6 +95,11 @@ namespace Game {
 			void addPlayer(const Engine::ECS::Entity ent);
 			AddConnRes getOrCreateConnection(const Engine::Net::IPv4Address& addr);
 
+			/**
+			 * Reads and dispatches the messages in a packet.
+			 * @param time The time the packet was received.
+			 */
+			void recvPacket(const Engine::Net::IPv4Address& addr, const Engine::Net::Packet& pkt, int32 sz, Engine::Clock::TimePoint time);
 			void dispatchMessage(ConnInfo& info, Connection& from, const Engine::Net::MessageHeader* hdr);
 			void runClient();
 
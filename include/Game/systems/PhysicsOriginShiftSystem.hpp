@@ -8,11 +8,20 @@
 
 
 namespace Game {
+	/**
+	 * Keeps the client's physics origin near the camera so that precision does not degrade far from the map origin.
+	 * The server instead gives each group of players its own world and origin. @see SubWorldSystem
+	 *
+	 * Positions are sent over the network relative to the map origin as float64 and converted using getOrigin. @see PhysicsBodyComponent::NetTransform
+	 */
 	class PhysicsOriginShiftSystem : public System {
 		public:
-			// Somewhat arbitrary. Small enough to not loose precision. Large enough to not be constantly shifting.
-			//constexpr static float32 range = 8000.0f; // Gives us .0005 precision (values < 8192)
-			constexpr static float32 range = 32.0f; // TODO: rm - temp for testing. use above
+			/**
+			 * The distance from the origin at which the origin is shifted.
+			 * Positions within twice this have better than 0.0001 precision which is the tolerance used for PLAYER_DATA.
+			 * Must be a whole number of chunks so that block and chunk positions stay exact.
+			 */
+			constexpr static float32 range = 256.0f;
 
 		private:
 			/** Current number of times offset in each direction */
@@ -24,5 +33,11 @@ namespace Game {
 			void run(float32 dt);
 
 			glm::ivec2 getOffset() const;
+
+			/**
+			 * Gets the position of the current origin relative to the map origin.
+			 */
+			[[nodiscard]]
+			ENGINE_INLINE glm::dvec2 getOrigin() const noexcept { return glm::dvec2{offset} * static_cast<float64>(range); }
 	};
 }
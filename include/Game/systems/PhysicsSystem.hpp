@@ -1,14 +1,22 @@
 #pragma once
 
+// STD
+#include <memory>
+#include <vector>
+
 // Box2D
 #include <Box2D/Box2D.h>
 
 // Engine
+#include <Engine/Clock.hpp>
 #include <Engine/Debug/DebugDrawBox2D.hpp>
+#include <Engine/SequenceBuffer.hpp>
+#include <Engine/WorkerPool.hpp>
 
 // Game
 #include <Game/System.hpp>
-#include <Game/PhysicsListener.hpp>
+#include <Game/PhysicsState.hpp>
+#include <Game/ContactEvents.hpp>
 
 
 namespace Game {
@@ -16,9 +24,21 @@ namespace Game {
 		public:
 			PhysicsSystem(SystemArg arg);
 
+			/**
+			 * During a selective rollback moves the bodies not being resimulated along their recorded path for this tick.
+			 */
+			void preTick();
 			void tick();
 			void render(const RenderLayer layer);
 			void preStoreSnapshot();
+			void preLoadSnapshot();
+			void postLoadSnapshot();
+
+			/**
+			 * Extends the entities affected by a selective rollback to those near or in contact with the corrected entities.
+			 */
+			void preRollback();
+			void postRollback();
 
 			void onComponentAdded(const Engine::ECS::Entity ent, class PhysicsBodyComponent& comp);
 			void onComponentRemoved(const Engine::ECS::Entity ent, class PhysicsBodyComponent& comp);
@@ -31,24 +51,76 @@ namespace Game {
 			 */
 			b2Body* createBody(Engine::ECS::Entity ent, b2BodyDef& bodyDef);
 
+			/**
+			 * Creates a box2d body in a specific world.
+			 * @see createBody
+			 * @see createWorld
+			 */
+			b2Body* createBody(Engine::ECS::Entity ent, b2BodyDef& bodyDef, b2World& zoneWorld);
+
 			/**
 			 * Destroys a box2d body.
+			 * Bodies should not be destroyed directly so they can be removed from the stored states.
 			 * @param[in] body The body to destroy.
 			 */
 			void destroyBody(b2Body* body);
 
 			/**
-			 * Adds a physics listener.
-			 * @param[in] listener The listener.
+			 * Destroys all fixtures on a box2d body.
+			 * Fixtures should not be destroyed directly so their contacts can be removed from the stored states.
+			 * @param[in] body The body to destroy the fixtures of.
+			 */
+			void destroyFixtures(b2Body& body);
+
+			/**
+			 * Creates an additional box2d world.
+			 * Bodies in different worlds never interact and all worlds are stepped in parallel.
+			 * Contact events from all worlds are combined after the step. @see getContacts
+			 * @return The new world. Valid until destroyed with destroyWorld.
 			 */
-			void addListener(PhysicsListener* listener);
+			b2World& createWorld();
 
 			/**
-			 * Changes the origin of the physics world.
+			 * Destroys a world created with createWorld.
+			 * All bodies in the world must have already been destroyed or moved.
+			 */
+			void destroyWorld(b2World& zoneWorld);
+
+			/**
+			 * Gets the main world. Bodies created without a world are put here.
+			 */
+			ENGINE_INLINE b2World& getWorld() noexcept { return physWorld; }
+
+			/**
+			 * Gets the contacts that began and ended during the last step, including any from bodies destroyed since the step before.
+			 * Should be used by systems that run after PhysicsSystem in the same tick.
+			 */
+			[[nodiscard]]
+			ENGINE_INLINE const ContactEvents& getContacts() const noexcept { return contacts; }
+
+			/**
+			 * Gets how far behind the current tick remote entities are displayed.
+			 * Only valid on the client. @see ActionComponent::getViewDelay
+			 */
+			[[nodiscard]]
+			ENGINE_INLINE Engine::Clock::Duration getRemoteDelay() const noexcept { return remoteDelay; }
+
+			/**
+			 * Changes the origin of the main physics world.
+			 * Everything relative to the main world moves by `-newOrigin`. The snapshot history, stored physics states,
+			 * and interpolation states are rebased in the same call so rollback and interpolation are unaffected.
+			 * Must not be called during a rollback. Only the client shifts the main world. @see PhysicsOriginShiftSystem
 			 * @param[in] newOrigin The new origin relative to the current origin.
 			 */
 			void shiftOrigin(const b2Vec2& newOrigin);
 
+			/**
+			 * Changes the origin of a world created with createWorld.
+			 * Positions relative to the main world do not change, only the bodies' origins. @see PhysicsBodyComponent::getOrigin
+			 * @param[in] newOrigin The new origin relative to the current origin of that world.
+			 */
+			void shiftOrigin(b2World& zoneWorld, const b2Vec2& newOrigin);
+
 			#if defined(DEBUG_PHYSICS)
 				Engine::Debug::DebugDrawBox2D& getDebugDraw();
 			#endif
@@ -82,19 +154,94 @@ namespace Game {
 		private:
 			class ContactListener : public b2ContactListener {
 				public:
-					ContactListener(PhysicsSystem& physSys);
 					virtual void BeginContact(b2Contact* contact) override;
 					virtual void EndContact(b2Contact* contact) override;
 					// virtual void PreSolve(b2Contact* contact, const b2Manifold* oldManifold) override;
 					// virtual void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override;
 
-					void addListener(PhysicsListener* listener);
+					/** The unsorted events recorded since they were last collected. @see collectContacts */
+					ContactEvents events;
+
+					/** Ignores contacts destroyed while bodies change type for a selective rollback. @see setBodyTypes */
+					bool paused = false;
+			};
+
+			/** An additional world along with its own contact listener since contacts are recorded from multiple threads at once. */
+			class Zone {
+				public:
+					Zone(PhysicsSystem& physSys);
+					Zone(const Zone&) = delete;
+					b2World physWorld;
+					ContactListener contactListener;
+			};
+
+			/** The maximum number of threads to step worlds with, including the simulation thread. */
+			constexpr static int32 maxStepThreads = 8;
+
+			/**
+			 * Steps all worlds in parallel.
+			 * Only used when there are additional worlds.
+			 */
+			void stepZones(float32 dt);
+
+			/**
+			 * Calls `func(PhysicsState&)` for each stored state.
+			 */
+			template<class Func>
+			void forEachState(Func&& func);
+
+			/**
+			 * Sets the type of each unaffected body without recording the contacts that are destroyed as a result.
+			 * @param replay If the bodies are being set up for the replay or restored afterward.
+			 */
+			void setBodyTypes(bool replay);
+
+			/**
+			 * Moves the events recorded by each world's contact listener into `contacts`.
+			 */
+			void collectContacts();
+
+			template<class Func>
+			void forEachWorld(Func&& func) {
+				func(physWorld);
+				for (auto& zone : zones) { func(zone->physWorld); }
+			}
 
-				private:
-					PhysicsSystem& physSys;
-					std::vector<PhysicsListener*> listeners;
+
+			/**
+			 * The distance in blocks around the path of a corrected entity that other bodies are resimulated in a selective rollback.
+			 * @see preRollback
+			 */
+			constexpr static float32 rollbackMargin = 4.0f;
+
+			/**
+			 * The state before a selective rollback of a body that is not resimulated. Restored once the replay completes.
+			 * During the replay the body is kinematic so it is not solved and has no contacts with terrain or other unaffected bodies.
+			 */
+			struct UnaffectedBody {
+				Engine::ECS::Entity ent;
+				b2Transform trans;
+				b2Vec2 vel;
+				float32 angVel;
+				b2BodyType type;
+				bool awake;
+
+				/** If the body has been moved onto its recorded path. */
+				bool tracking = false;
 			};
 
+			/** The areas covered by the corrected entities in a selective rollback. */
+			std::vector<b2AABB> rollbackAreas;
+
+			/** Bodies not affected by the current selective rollback. */
+			std::vector<UnaffectedBody> unaffectedBodies;
+
+			/**
+			 * The state of the physics world at the start of each tick.
+			 * Restored in bulk on rollback so that contact impulses are kept.
+			 * The snapshot components are still authoritative and applied afterward.
+			 */
+			Engine::SequenceBuffer<Engine::ECS::Tick, PhysicsState, tickrate> states;
 
 			/** The box2d world */
 			b2World physWorld;
@@ -102,6 +249,18 @@ namespace Game {
 			/** The box2d contact listener */
 			ContactListener contactListener;
 
+			/** Additional worlds. @see createWorld */
+			std::vector<std::unique_ptr<Zone>> zones;
+
+			/** Used to step the worlds in parallel. */
+			Engine::WorkerPool pool;
+
+			/** @see getContacts */
+			ContactEvents contacts;
+
+			/** @see getRemoteDelay */
+			Engine::Clock::Duration remoteDelay = {};
+
 			#if defined(DEBUG_PHYSICS)
 				Engine::Debug::DebugDrawBox2D debugDraw;
 			#endif
@@ -0,0 +1,45 @@
+#pragma once
+
+// Engine
+#include <Engine/ECS/SpatialIndex.hpp>
+
+// Game
+#include <Game/System.hpp>
+
+
+namespace Game {
+	/**
+	 * Maintains spatial indexes of entity positions for gameplay, replication, and rendering queries.
+	 * Unlike querying a b2World the results only contain entities, are not affected by terrain fixtures,
+	 * and cover all physics worlds. @see SubWorldSystem
+	 */
+	class SpatialSystem : public System {
+		public:
+			/** Similar to the ranges used for neighbor queries in EntityNetworkingSystem. */
+			constexpr static float32 cellSize = 8.0f;
+
+		private:
+			Engine::ECS::SpatialIndex bodyIndex{cellSize};
+			Engine::ECS::SpatialIndex interpIndex{cellSize};
+
+		public:
+			SpatialSystem(SystemArg arg);
+
+			void postTick();
+			void run(float32 dt);
+
+			/**
+			 * Gets an index of the simulated positions from PhysicsBodyComponent as of the end of the last tick.
+			 * Entities also have the bounds of their fixtures for use with `queryOverlap`.
+			 */
+			[[nodiscard]]
+			ENGINE_INLINE const Engine::ECS::SpatialIndex& getBodyIndex() const noexcept { return bodyIndex; }
+
+			/**
+			 * Gets an index of the displayed positions from PhysicsInterpComponent as of this frame.
+			 * Only maintained on the client.
+			 */
+			[[nodiscard]]
+			ENGINE_INLINE const Engine::ECS::SpatialIndex& getInterpIndex() const noexcept { return interpIndex; }
+	};
+}
@@ -1,58 +1,141 @@
 #pragma once
 
+// STD
+#include <vector>
+
 // GLM
 #include <glm/glm.hpp>
 
 // Box2D
-#include <box2d/b2_math.h>
+#include <Box2D/Box2D.h>
+
+// Engine
+#include <Engine/FlatHashMap.hpp>
 
 // Game
 #include <Game/System.hpp>
+#include <Game/SubWorld.hpp>
 #include <Game/comps/PhysicsBodyComponent.hpp>
 #include <Game/systems/MapSystem.hpp>
 
 
 namespace Game {
+	/**
+	 * Simulates groups of nearby players in separate physics worlds so that they can be stepped in parallel.
+	 *
+	 * Each group is given its own world with an origin near the group. Bodies near the group's players are
+	 * moved into that world and copies of the nearby terrain are kept in sync with MapSystem.
+	 * Bodies migrate between worlds as groups merge and split. Bodies that are not near any group are kept in the main world.
+	 *
+	 * The server never shifts the main world's origin. Instead a zone's origin is moved to follow its group once the group
+	 * is more than PhysicsOriginShiftSystem::range away so that players keep full precision anywhere on the map.
+	 *
+	 * Positions from PhysicsBodyComponent are always relative to the main world regardless of which world a body is in.
+	 * Only runs on the server.
+	 *
+	 * @see PhysicsSystem::createWorld
+	 */
 	class SubWorldSystem : public System {
 		public:
-			// Somewhat arbitrary. Small enough to not loose precision. Large enough to not be constantly shifting.
-			//constexpr static float32 range = 8000.0f; // Gives us .0005 precision (values < 8192)
+			/**
+			 * Bodies within this distance of a player are moved to that player's world.
+			 * Must be larger than any range players interact with bodies over.
+			 */
+			constexpr static float32 bodyRange = 24.0f;
+
+			/**
+			 * Bodies in a zone are moved back to the main world once they are this far from all of the zone's players.
+			 * Larger than bodyRange so that bodies near the edge are not constantly moving between worlds.
+			 */
+			constexpr static float32 releaseRange = 32.0f;
+
+			/** World origins are kept on chunk boundaries so terrain copies have exact positions. */
+			constexpr static float32 originStep = MapChunk::size.x * MapChunk::blockSize;
 
-			constexpr static float32 minRange = 16.0f; // TODO: rm - temp for testing. use above
-			constexpr static float32 maxRange = 32.0f; // TODO: rm - temp for testing. use above
-			constexpr static auto minRangeSquared = minRange * minRange;
-			constexpr static auto maxRangeSquared = maxRange * maxRange;
+			static_assert(bodyRange < releaseRange);
+			static_assert(2 * bodyRange <= PlayerGroups::splitRange);
 
 		private:
-			// TODO: reprecent this data with ecs
-			struct Group {
-				b2World* world;
-				Engine::FlatHashMap<b2World*, int> worlds;
+			struct ChunkCopy {
+				b2Body* body = nullptr;
+
+				/** The tick this copy was made. The copy is remade if the chunk is updated on or after this tick. */
+				Engine::ECS::Tick synced = {};
+
+				/** The last tick this chunk was near the zone's group. */
+				Engine::ECS::Tick used = {};
 			};
 
-			struct PlayerData {
-				Engine::ECS::Entity ent;
-				PhysicsBodyComponent* physComp;
-				b2Vec2 pos;
-				Group* group = nullptr;
-				bool shouldSplit = false;
+			/** A world created by this system for a group of players. */
+			struct Zone {
+				b2World* physWorld = nullptr;
+				b2Vec2 origin = b2Vec2_zero;
+				Engine::FlatHashMap<glm::ivec2, ChunkCopy> chunks;
+				bool claimed = false;
 			};
-			std::vector<PlayerData> playerData;
-			std::vector<std::unique_ptr<b2World>> worlds; // TODO: who should own worlds? physics sys?
-			std::vector<b2World*> freeWorlds;
 
-			std::vector<Group> groups;
-			robin_hood::unordered_flat_set<b2Body*> bodies; // TODO: add engine type
+			PlayerGroups playerGroups;
+			std::vector<Zone> zones;
+
+			/** Scratch storage for bodies being migrated. */
+			std::vector<Engine::ECS::Entity> moving;
 
 		public:
 			SubWorldSystem(SystemArg arg);
 
 			void tick();
 
+			/**
+			 * Gets the number of worlds in use in addition to the main world.
+			 */
+			[[nodiscard]]
+			ENGINE_INLINE int32 getZoneCount() const noexcept { return static_cast<int32>(zones.size()); }
+
+			/**
+			 * Moves an entity's body into another world.
+			 * @param origin The origin of @p physWorld.
+			 */
+			void migrate(Engine::ECS::Entity ent, b2World& physWorld, b2Vec2 origin);
+
 		private:
-			void mergePlayer(PlayerData& ply, b2World* world);
-			void splitFromWorld(PlayerData& ply);
+			/**
+			 * Groups players by proximity. @see PlayerGroups
+			 */
+			void buildGroups();
+
+			/**
+			 * Picks a zone for each group, preferring the zone most of its players are already in.
+			 * Creates zones and shifts their origins as needed.
+			 */
+			void assignWorlds();
+
+			/**
+			 * Moves each player and the bodies near them into their group's world.
+			 */
+			void migrateGroups();
+
+			/**
+			 * Moves bodies in a zone that are no longer near its group to the world of the group they are near.
+			 * Bodies not near any group are moved to the main world.
+			 */
+			void releaseBodies(const Zone& zone);
+
+			/**
+			 * Updates the terrain copies in a zone for the chunks near its group.
+			 */
+			void syncTerrain(Zone& zone, const PlayerGroups::Group& group);
+
+			/**
+			 * Adds the entities with bodies in @p physWorld within bodyRange of @p pos to `moving`.
+			 * Players and bodies without a PhysicsBodyComponent, such as terrain, are skipped.
+			 */
+			void findNearby(b2World& physWorld, b2Vec2 origin, b2Vec2 pos);
+
+			/**
+			 * Moves all entity bodies back to the main world and destroys the zone's world.
+			 */
+			void releaseZone(Zone& zone);
 
-			b2World* getFreeWorld();
+			Zone* findZone(const b2World* physWorld);
 	};
 }
@@ -0,0 +1,349 @@
+// STD
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Engine
+#include <Engine/Clock.hpp>
+#include <Engine/CommandLine/Parser.hpp>
+
+// Game
+#include <Game/MapChunk.hpp>
+#include <Game/MapGenerator2.hpp>
+#include <Game/MapRegion.hpp>
+
+// MapTool
+#include "png.hpp"
+
+
+namespace {
+	using namespace Engine::Types;
+	using Game::BlockId;
+	using Game::BlockEntityDesc;
+	using Game::BlockEntityType;
+	using Game::MapChunk;
+	using Game::MapGenerator2;
+	using Game::MapRegion;
+	using Biome = MapGenerator2::Biome;
+	using Seconds = std::chrono::duration<long double, std::ratio<1, 1>>;
+
+	constexpr const char* biomeNames[] = {
+		"Default",
+		"Forest",
+		"Jungle",
+		"Taiga",
+		"Desert",
+		"Savanna",
+		"Ocean",
+	};
+	static_assert(std::size(biomeNames) == static_cast<size_t>(Biome::Ocean) + 1, "Missing biome name.");
+
+	constexpr const char* blockEntityNames[] = {
+		#define X(Name) #Name,
+		#include <Game/BlockEntityType.xpp>
+	};
+
+	/** The same colors as the map test in the client. */
+	constexpr auto blockColors = []{
+		std::array<std::array<uint8, 3>, BlockId::_COUNT> res = {};
+		res[BlockId::Entity]	= {0, 120, 189};
+		res[BlockId::Debug]		= {255, 0, 0};
+		res[BlockId::Debug2]	= {200, 26, 226};
+		res[BlockId::Debug3]	= {226, 26, 162};
+		res[BlockId::Debug4]	= {226, 26, 111};
+		res[BlockId::Dirt]		= {158, 98, 33};
+		res[BlockId::Grass]		= {67, 226, 71};
+		res[BlockId::Iron]		= {144, 144, 144};
+		res[BlockId::Gold]		= {255, 235, 65};
+		return res;
+	}();
+
+	ENGINE_INLINE constexpr int32 floorDiv(const int32 a, const int32 b) noexcept {
+		return (a >= 0 ? a : a - (b - 1)) / b;
+	}
+
+	struct Stats {
+		int64 chunks = 0;
+		Engine::Clock::Duration time = {};
+
+		void add(const Engine::Clock::Duration t) noexcept {
+			++chunks;
+			time += t;
+		}
+
+		Stats& operator+=(const Stats& other) noexcept {
+			chunks += other.chunks;
+			time += other.time;
+			return *this;
+		}
+	};
+
+	/**
+	 * Generation time grouped by biome and landmark.
+	 * Time is summed across threads so the rates are per core.
+	 */
+	struct Profile {
+		Stats total;
+
+		/** The last entry is for chunks that contain more than one biome. */
+		Stats byBiome[std::size(biomeNames) + 1];
+
+		/** Chunks are counted once for each type of block entity they contain. None is chunks without any. */
+		constexpr static size_t landmarkCount = static_cast<size_t>(BlockEntityType::_COUNT);
+		Stats byLandmark[landmarkCount];
+
+		void add(const MapGenerator2& mgen, const glm::ivec2 blockPos, const std::vector<BlockEntityDesc>& entData, const Engine::Clock::Duration time) {
+			total.add(time);
+
+			// Biome cells are much larger than a chunk so checking the corners is close enough
+			const auto b = mgen.biome(blockPos);
+			const bool mixed = b != mgen.biome(blockPos + glm::ivec2{MapChunk::size.x - 1, 0})
+				|| b != mgen.biome(blockPos + glm::ivec2{0, MapChunk::size.y - 1})
+				|| b != mgen.biome(blockPos + MapChunk::size - 1);
+			byBiome[mixed ? std::size(biomeNames) : static_cast<size_t>(b)].add(time);
+
+			bool found[landmarkCount] = {};
+			for (const auto& desc : entData) {
+				found[static_cast<size_t>(desc.data.type)] = true;
+			}
+
+			found[static_cast<size_t>(BlockEntityType::None)] = entData.empty();
+			for (size_t i = 0; i < landmarkCount; ++i) {
+				if (found[i]) { byLandmark[i].add(time); }
+			}
+		}
+
+		Profile& operator+=(const Profile& other) noexcept {
+			total += other.total;
+			for (size_t i = 0; i < std::size(byBiome); ++i) { byBiome[i] += other.byBiome[i]; }
+			for (size_t i = 0; i < landmarkCount; ++i) { byLandmark[i] += other.byLandmark[i]; }
+			return *this;
+		}
+
+		void print(std::ostream& out, const Engine::Clock::Duration wall) const {
+			constexpr auto blocksPerChunk = MapChunk::size.x * MapChunk::size.y;
+			const auto row = [&](const char* name, const Stats& stats) {
+				if (!stats.chunks) { return; }
+				const auto secs = Seconds{stats.time}.count();
+				out << "  " << std::left << std::setw(12) << name
+					<< std::right << std::setw(10) << stats.chunks
+					<< std::setw(16) << std::fixed << std::setprecision(0) << (stats.chunks * blocksPerChunk / secs)
+					<< "\n";
+			};
+
+			const auto header = [&](const char* name) {
+				out << "  " << std::left << std::setw(12) << name << std::right << std::setw(10) << "Chunks" << std::setw(16) << "Blocks/s" << "\n";
+			};
+
+			const auto wallSecs = Seconds{wall}.count();
+			out << "Generated " << total.chunks << " chunks in " << std::setprecision(3) << wallSecs << "s"
+				<< " (" << std::setprecision(0) << std::fixed << (total.chunks * blocksPerChunk / wallSecs) << " blocks/s)\n";
+
+			out << "\nPer core throughput by biome:\n";
+			header("Biome");
+			for (size_t i = 0; i < std::size(biomeNames); ++i) { row(biomeNames[i], byBiome[i]); }
+			row("Mixed", byBiome[std::size(biomeNames)]);
+
+			out << "\nPer core throughput by landmark:\n";
+			header("Landmark");
+			for (size_t i = 0; i < landmarkCount; ++i) { row(blockEntityNames[i], byLandmark[i]); }
+			row("All", total);
+			out << std::defaultfloat;
+		}
+	};
+
+	/**
+	 * Generates @p chunks across @p threadCount threads.
+	 * @param func Called as `func(chunkPos, chunk, entData)` from the worker threads after each chunk is generated.
+	 */
+	template<class Func>
+	Profile generate(const MapGenerator2& mgen, const std::vector<glm::ivec2>& chunks, const int32 threadCount, Func&& func) {
+		std::atomic<size_t> next = 0;
+		std::vector<Profile> profiles(threadCount);
+		std::vector<std::thread> threads;
+
+		for (int32 t = 0; t < threadCount; ++t) {
+			threads.emplace_back([&, t]{
+				auto& profile = profiles[t];
+				MapChunk chunk;
+				std::vector<BlockEntityDesc> entData;
+
+				for (size_t i; (i = next++) < chunks.size();) {
+					const auto blockPos = chunks[i] * MapChunk::size;
+					entData.clear();
+
+					const auto start = Engine::Clock::now();
+					mgen.init(blockPos, chunk, entData);
+					const auto time = Engine::Clock::now() - start;
+
+					profile.add(mgen, blockPos, entData, time);
+					func(chunks[i], chunk, entData);
+				}
+			});
+		}
+
+		Profile res;
+		for (int32 t = 0; t < threadCount; ++t) {
+			threads[t].join();
+			res += profiles[t];
+		}
+		return res;
+	}
+
+	/**
+	 * Writes the blocks in an area as an image or raw block ids depending on the extension of @p path.
+	 * Both are row major with the highest y first.
+	 */
+	bool writePreview(const std::string& path, const glm::ivec2 size, const std::vector<BlockId>& blocks) {
+		if (std::filesystem::path{path}.extension() == ".raw") {
+			std::ofstream file{path, std::ios::binary | std::ios::out | std::ios::trunc};
+			file.write(reinterpret_cast<const char*>(blocks.data()), blocks.size() * sizeof(blocks[0]));
+			return static_cast<bool>(file);
+		}
+
+		std::vector<uint8> rgb(blocks.size() * 3);
+		for (size_t i = 0; i < blocks.size(); ++i) {
+			const auto bid = blocks[i] < BlockId::_COUNT ? blocks[i] : BlockId::None;
+			std::copy(blockColors[bid].begin(), blockColors[bid].end(), &rgb[i * 3]);
+		}
+		return MapTool::writePNG(path, size.x, size.y, rgb.data());
+	}
+
+	void usage() {
+		std::cout <<
+			"Usage: MapTool [options]\n"
+			"Generates the block area [x, x + width) x [y, y + height) and reports generation throughput.\n"
+			"\n"
+			"  --seed <int>     The generator seed. (default: 12345, the same as MapSystem)\n"
+			"  --threads <int>  The number of threads to use. (default: hardware concurrency)\n"
+			"  --x, --y <int>   The block position of the bottom left of the area. (default: -512, -512)\n"
+			"  --width, --height <int>\n"
+			"                   The size of the area in blocks. (default: 1024, 1024)\n"
+			"  --out <path>     Writes the area to a .png image or .raw file of 16 bit block ids.\n"
+			"  --bake <dir>     Writes all regions overlapping the area to region files in <dir>.\n"
+			"                   The server loads regions from \"" << MapRegion::bakeDirectory << "\".\n";
+	}
+}
+
+int main(int argc, char* argv[]) {
+	Engine::CommandLine::Parser parser;
+	parser
+		.add<bool>("help", 'h', false, "Show usage.")
+		.add<int64>("seed", 0, 12345, "The generator seed.")
+		.add<int32>("threads", 0, static_cast<int32>(std::max(1u, std::thread::hardware_concurrency())), "The number of threads to use.")
+		.add<int32>("x", 0, -512, "The block x position of the area.")
+		.add<int32>("y", 0, -512, "The block y position of the area.")
+		.add<int32>("width", 0, 1024, "The width of the area in blocks.")
+		.add<int32>("height", 0, 1024, "The height of the area in blocks.")
+		.add<std::string>("out", "The preview file to write.")
+		.add<std::string>("bake", "The directory to write region files to.")
+	;
+	parser.parse(argc - 1, argv + 1);
+
+	if (*parser.get<bool>("help")) {
+		usage();
+		return 0;
+	}
+
+	const auto seed = *parser.get<int64>("seed");
+	const auto threadCount = std::max(1, *parser.get<int32>("threads"));
+	const glm::ivec2 pos = {*parser.get<int32>("x"), *parser.get<int32>("y")};
+	const glm::ivec2 size = {*parser.get<int32>("width"), *parser.get<int32>("height")};
+	const auto* out = parser.get<std::string>("out");
+	const auto* bake = parser.get<std::string>("bake");
+
+	if (size.x <= 0 || size.y <= 0) {
+		std::cerr << "Area size must be positive.\n";
+		usage();
+		return 1;
+	}
+
+	const MapGenerator2 mgen{seed};
+	const glm::ivec2 chunkMin = {floorDiv(pos.x, MapChunk::size.x), floorDiv(pos.y, MapChunk::size.y)};
+	const glm::ivec2 chunkMax = {floorDiv(pos.x + size.x - 1, MapChunk::size.x), floorDiv(pos.y + size.y - 1, MapChunk::size.y)};
+	Profile profile;
+	Engine::Clock::Duration wall = {};
+
+	if (bake) {
+		const glm::ivec2 regionMin = {floorDiv(chunkMin.x, MapRegion::size.x), floorDiv(chunkMin.y, MapRegion::size.y)};
+		const glm::ivec2 regionMax = {floorDiv(chunkMax.x, MapRegion::size.x), floorDiv(chunkMax.y, MapRegion::size.y)};
+		std::cout << "Baking regions (" << regionMin.x << ", " << regionMin.y << ") to (" << regionMax.x << ", " << regionMax.y << ") into " << *bake << "\n";
+
+		std::error_code err;
+		std::filesystem::create_directories(*bake, err);
+		if (err) {
+			std::cerr << "Unable to create directory " << *bake << ": " << err.message() << "\n";
+			return 1;
+		}
+
+		auto region = std::make_unique<MapRegion>();
+		std::vector<glm::ivec2> chunks;
+		for (auto regionPos = regionMin; regionPos.x <= regionMax.x; ++regionPos.x) {
+			for (regionPos.y = regionMin.y; regionPos.y <= regionMax.y; ++regionPos.y) {
+				const auto regionStart = regionPos * MapRegion::size;
+				chunks.clear();
+				for (int32 x = 0; x < MapRegion::size.x; ++x) {
+					for (int32 y = 0; y < MapRegion::size.y; ++y) {
+						chunks.push_back(regionStart + glm::ivec2{x, y});
+					}
+				}
+
+				const auto start = Engine::Clock::now();
+				profile += generate(mgen, chunks, threadCount, [&](const glm::ivec2 chunkPos, const MapChunk& chunk, const std::vector<BlockEntityDesc>& entData) {
+					const auto idx = chunkPos - regionStart;
+					auto& info = region->data[idx.x][idx.y];
+					info.chunk = chunk;
+					info.entData = entData;
+				});
+				wall += Engine::Clock::now() - start;
+
+				const auto path = MapRegion::filePath(*bake, regionPos);
+				if (!region->save(path, regionPos, seed)) {
+					std::cerr << "Unable to write region file " << path << "\n";
+					return 1;
+				}
+			}
+		}
+	}
+
+	if (out || !bake) {
+		std::vector<glm::ivec2> chunks;
+		for (auto chunkPos = chunkMin; chunkPos.x <= chunkMax.x; ++chunkPos.x) {
+			for (chunkPos.y = chunkMin.y; chunkPos.y <= chunkMax.y; ++chunkPos.y) {
+				chunks.push_back(chunkPos);
+			}
+		}
+
+		std::vector<BlockId> blocks(out ? static_cast<size_t>(size.x) * size.y : 0, BlockId::None);
+		const auto start = Engine::Clock::now();
+		profile += generate(mgen, chunks, threadCount, [&](const glm::ivec2 chunkPos, const MapChunk& chunk, const std::vector<BlockEntityDesc>& entData) {
+			if (!out) { return; }
+			const auto chunkStart = chunkPos * MapChunk::size;
+			const auto min = glm::max(chunkStart, pos);
+			const auto max = glm::min(chunkStart + MapChunk::size, pos + size);
+
+			for (int32 x = min.x; x < max.x; ++x) {
+				for (int32 y = min.y; y < max.y; ++y) {
+					const auto row = static_cast<size_t>(pos.y + size.y - 1 - y);
+					blocks[row * size.x + (x - pos.x)] = chunk.getBlock({x - chunkStart.x, y - chunkStart.y});
+				}
+			}
+		});
+		wall += Engine::Clock::now() - start;
+
+		if (out && !writePreview(*out, size, blocks)) {
+			std::cerr << "Unable to write " << *out << "\n";
+			return 1;
+		}
+	}
+
+	profile.print(std::cout, wall);
+	return 0;
+}
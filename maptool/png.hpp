@@ -0,0 +1,110 @@
+#pragma once
+
+// STD
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Engine
+#include <Engine/Engine.hpp>
+
+
+namespace MapTool {
+	using namespace Engine::Types;
+
+	/**
+	 * Writes an 8 bit RGB PNG using uncompressed deflate blocks.
+	 * This avoids needing a compression library at the cost of larger files.
+	 * @param rgb Row major pixel data starting at the top row. Width and height must be non-zero.
+	 */
+	inline bool writePNG(const std::string& path, const int32 w, const int32 h, const uint8* rgb) {
+		constexpr auto crcTable = []{
+			std::array<uint32, 256> table = {};
+			for (uint32 i = 0; i < 256; ++i) {
+				uint32 c = i;
+				for (int32 k = 0; k < 8; ++k) {
+					c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+				}
+				table[i] = c;
+			}
+			return table;
+		}();
+
+		std::vector<uint8> out;
+		const auto put32 = [&](const uint32 v) {
+			out.push_back(static_cast<uint8>(v >> 24));
+			out.push_back(static_cast<uint8>(v >> 16));
+			out.push_back(static_cast<uint8>(v >> 8));
+			out.push_back(static_cast<uint8>(v));
+		};
+
+		const auto chunk = [&](const char (&type)[5], const std::vector<uint8>& data) {
+			put32(static_cast<uint32>(data.size()));
+			const auto start = out.size();
+			out.insert(out.end(), type, type + 4);
+			out.insert(out.end(), data.begin(), data.end());
+
+			uint32 crc = 0xFFFFFFFFu;
+			for (auto i = start; i < out.size(); ++i) {
+				crc = crcTable[(crc ^ out[i]) & 0xFF] ^ (crc >> 8);
+			}
+			put32(crc ^ 0xFFFFFFFFu);
+		};
+
+		constexpr uint8 signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+		out.insert(out.end(), std::begin(signature), std::end(signature));
+
+		{ // Header
+			std::vector<uint8> ihdr;
+			const auto be32 = [&](const uint32 v) {
+				for (int32 s = 24; s >= 0; s -= 8) { ihdr.push_back(static_cast<uint8>(v >> s)); }
+			};
+			be32(w);
+			be32(h);
+			ihdr.insert(ihdr.end(), {8, 2, 0, 0, 0}); // 8 bit, RGB, deflate, no filter, no interlace
+			chunk("IHDR", ihdr);
+		}
+
+		{ // Image data
+			const size_t stride = 3 * static_cast<size_t>(w);
+			std::vector<uint8> raw;
+			raw.reserve((stride + 1) * h);
+			for (int32 y = 0; y < h; ++y) {
+				raw.push_back(0); // Filter: none
+				raw.insert(raw.end(), rgb + y * stride, rgb + (y + 1) * stride);
+			}
+
+			std::vector<uint8> zlib = {0x78, 0x01};
+			zlib.reserve(raw.size() + raw.size() / 0xFFFF * 5 + 16);
+			for (size_t i = 0; i < raw.size(); i += 0xFFFF) {
+				const auto len = static_cast<uint16>(std::min<size_t>(0xFFFF, raw.size() - i));
+				const auto nlen = static_cast<uint16>(~len);
+				zlib.push_back(i + len == raw.size() ? 1 : 0); // Final block flag, stored
+				zlib.push_back(static_cast<uint8>(len));
+				zlib.push_back(static_cast<uint8>(len >> 8));
+				zlib.push_back(static_cast<uint8>(nlen));
+				zlib.push_back(static_cast<uint8>(nlen >> 8));
+				zlib.insert(zlib.end(), raw.begin() + i, raw.begin() + i + len);
+			}
+
+			uint32 a = 1;
+			uint32 b = 0;
+			for (const auto v : raw) {
+				a = (a + v) % 65521;
+				b = (b + a) % 65521;
+			}
+			for (int32 s = 24; s >= 0; s -= 8) { zlib.push_back(static_cast<uint8>(((b << 16) | a) >> s)); }
+
+			chunk("IDAT", zlib);
+		}
+
+		chunk("IEND", {});
+
+		std::ofstream file{path, std::ios::binary | std::ios::out | std::ios::trunc};
+		if (!file) { return false; }
+		file.write(reinterpret_cast<const char*>(out.data()), out.size());
+		return static_cast<bool>(file);
+	}
+}
@@ -273,38 +273,82 @@ project("Bench")
 	flags { "ExcludeFromBuild" }
 	files {
 		"bench/**",
+		"src/Game/ChunkCodec.cpp",
+		"src/Game/MapChunk.cpp",
+		"src/Game/MapChunkEdit.cpp",
+		"src/Game/MapGenerator2.cpp",
+		"src/Game/PhysicsState.cpp",
 	}
 
 	defines {
 		"ENGINE_SIDE=ENGINE_SIDE_SERVER",
 	}
 --------------------------------------------------------------------------------
+-- MapTool
+--------------------------------------------------------------------------------
+project("MapTool")
+	uuid "CC98FE2F-0847-4F2A-91A7-F872C23843EB"
+	kind "ConsoleApp"
+	flags { "ExcludeFromBuild" }
+	files {
+		"maptool/**",
+		"src/Game/ChunkCodec.cpp",
+		"src/Game/MapChunk.cpp",
+		"src/Game/MapGenerator2.cpp",
+		"src/Game/MapRegion.cpp",
+	}
+
+	defines {
+		"ENGINE_SIDE=ENGINE_SIDE_SERVER",
+	}
+
+--------------------------------------------------------------------------------
 -- Test
 --------------------------------------------------------------------------------
---project("Test")
---	defines {"RUNNING_TESTS"}
---
---	files {
---		"./test/**",
---	}
---
---	includedirs {
---		"./deps/googletest/googlemock/include",
---		"./deps/googletest/googletest/include",
---	}
---
---	libdirs {
---		"./deps/googletest/lib/".. CONFIG_TYPE_STR,
---	}
---
---	filter {"platforms:Windows_x64", "configurations:Debug*"}
---		links {
---			"gtestd.lib",
---			"gmockd.lib",
---		}
---
---	filter {"platforms:Windows_x64", "configurations:Release*"}
---		links {
---			"gtest.lib",
---			"gmock.lib",
---		}
+project("Test")
+	uuid "3F2A8C61-5B7E-4D0A-9E4C-8A1D2B6F7C35"
+	kind "ConsoleApp"
+	flags { "ExcludeFromBuild" }
+	defines {
+		"RUNNING_TESTS",
+		"ENGINE_SIDE=ENGINE_SIDE_SERVER",
+	}
+
+	files {
+		"./test/**",
+		"src/Game/ChunkCodec.cpp",
+		"src/Game/MapChunk.cpp",
+		"src/Game/MapChunkEdit.cpp",
+		"src/Game/MapGenerator2.cpp",
+		"src/Game/MapRegion.cpp",
+		"src/Game/PhysicsState.cpp",
+		"src/Game/SubWorld.cpp",
+	}
+
+	-- Tests for the ECS managers that were replaced by World. Kept for reference until World covers the same cases.
+	removefiles {
+		"./test/Engine/ECS/ComponentManager.cpp",
+		"./test/Engine/ECS/EntityManager.cpp",
+		"./test/Engine/ECS/SystemManager.cpp",
+	}
+
+	includedirs {
+		"./deps/googletest/googlemock/include",
+		"./deps/googletest/googletest/include",
+	}
+
+	libdirs {
+		"./deps/googletest/lib/".. CONFIG_TYPE_STR,
+	}
+
+	filter {"platforms:Windows_x64", "configurations:Debug*"}
+		links {
+			"gtestd.lib",
+			"gmockd.lib",
+		}
+
+	filter {"platforms:Windows_x64", "configurations:Release*"}
+		links {
+			"gtest.lib",
+			"gmock.lib",
+		}
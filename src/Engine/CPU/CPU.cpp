@@ -0,0 +1,40 @@
+// STD
+#include <intrin.h>
+
+// Engine
+#include <Engine/CPU/CPU.hpp>
+
+
+namespace {
+	Engine::CPU::Features detectFeatures() noexcept {
+		Engine::CPU::Features result;
+		int regs[4] = {}; // eax, ebx, ecx, edx
+
+		__cpuid(regs, 0);
+		const int maxLeaf = regs[0];
+
+		if (maxLeaf >= 1) {
+			__cpuid(regs, 1);
+			result.sse41 = regs[2] & (1 << 19);
+
+			// AVX state must be enabled by the OS (OSXSAVE + XCR0 bits 1 and 2)
+			const bool osxsave = regs[2] & (1 << 27);
+			const bool avx = regs[2] & (1 << 28);
+			const bool osAVX = osxsave && avx && ((_xgetbv(0) & 0b110) == 0b110);
+
+			if (osAVX && maxLeaf >= 7) {
+				__cpuidex(regs, 7, 0);
+				result.avx2 = regs[1] & (1 << 5);
+			}
+		}
+
+		return result;
+	}
+}
+
+namespace Engine::CPU {
+	const Features& features() noexcept {
+		static const Features feats = detectFeatures();
+		return feats;
+	}
+}
@@ -1,7 +1,19 @@
+// STD
+#include <cctype>
+
 // Engine
 #include <Engine/Engine.hpp>
 #include <Engine/CommandLine/Parser.hpp>
 
+namespace {
+	/**
+	 * Checks if an argument is a negative number instead of an abbreviated argument.
+	 */
+	bool isNegativeNumber(const std::string& arg) {
+		return arg.size() > 1 && arg[0] == '-' && (std::isdigit(static_cast<unsigned char>(arg[1])) || arg[1] == '.');
+	}
+}
+
 namespace Engine::CommandLine {
 	// TODO: positional arg types?
 	void Parser::parse(int argc, char* argv[]) {
@@ -19,7 +31,7 @@ namespace Engine::CommandLine {
 
 			auto found = arg.find('=');
 			if (found == std::string::npos) {
-				if (arg.size() > 1 && arg[0] == '-' && arg[1] != '-') {
+				if (arg.size() > 1 && arg[0] == '-' && arg[1] != '-' && !isNegativeNumber(arg)) {
 					for (int j = 1; j < arg.size(); ++j) {
 						args.emplace_back("-") += arg[j];
 					}
@@ -53,7 +65,7 @@ namespace Engine::CommandLine {
 					found = params.emplace(full, std::make_unique<Argument<std::string>>(0, "", "<invalid argument>", true)).first;
 				}
 				ptr = found->second.get();
-			} else if (arg.starts_with("-")) { // Abrev aguments
+			} else if (arg.starts_with("-") && !isNegativeNumber(arg)) { // Abrev aguments
 				auto found = abbrToFull.find(arg[1]);
 				if (found == abbrToFull.end()) {
 					ENGINE_WARN("Unkown abbreviated command line argument: ", arg);
@@ -67,7 +79,7 @@ namespace Engine::CommandLine {
 			}
 
 			// Store the value if there is one. I there isnt one assume it is a boolean flag argument.
-			if ((i < last) && !args[i+1].starts_with("-")) {
+			if ((i < last) && (!args[i+1].starts_with("-") || isNegativeNumber(args[i+1]))) {
 				if (!ptr->store(args[++i])) {
 					ENGINE_ERROR("Unable to convert command line argument: ", arg, "=", args[i]);
 				}
@@ -0,0 +1,435 @@
+// STD
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+// Game
+#include <Game/ChunkCodec.hpp>
+
+
+namespace {
+	using namespace Game;
+	using RLEPair = MapChunk::RLEPair;
+
+	constexpr int32 blockCount = MapChunk::size.x * MapChunk::size.y;
+	static_assert(blockCount <= 0xFFFF, "Run length does not fit in RLEPair::count.");
+
+	/**
+	 * Calls `func(bid, count)` for each run of equal blocks.
+	 * @tparam YMajor Scan each row (y) before moving up instead of each column (x).
+	 */
+	template<bool YMajor, class Func>
+	ENGINE_INLINE void forEachRun(const MapChunk::DenseData& blocks, Func&& func) {
+		BlockId bid = blocks[0][0];
+		int32 count = 0;
+
+		const auto visit = [&](const BlockId curr) ENGINE_INLINE {
+			if (curr == bid) {
+				++count;
+			} else {
+				func(bid, count);
+				bid = curr;
+				count = 1;
+			}
+		};
+
+		if constexpr (YMajor) {
+			for (int32 y = 0; y < MapChunk::size.y; ++y) {
+				for (int32 x = 0; x < MapChunk::size.x; ++x) {
+					visit(blocks[x][y]);
+				}
+			}
+		} else {
+			const BlockId* linear = &blocks[0][0];
+			for (int32 i = 0; i < blockCount; ++i) {
+				visit(linear[i]);
+			}
+		}
+
+		func(bid, count);
+	}
+
+	/**
+	 * Sets @p count blocks starting at linear index @p i in scan order.
+	 * Bounds must already be checked.
+	 */
+	template<bool YMajor>
+	ENGINE_INLINE void fillRun(MapChunk::DenseData& blocks, const int32 i, const int32 count, const BlockId bid) noexcept {
+		if constexpr (YMajor) {
+			int32 x = i % MapChunk::size.x;
+			int32 y = i / MapChunk::size.x;
+			for (int32 n = 0; n < count; ++n) {
+				blocks[x][y] = bid;
+				if (++x == MapChunk::size.x) { x = 0; ++y; }
+			}
+		} else {
+			BlockId* linear = &blocks[0][0];
+			std::fill(linear + i, linear + i + count, bid);
+		}
+	}
+
+	/**
+	 * The run length encoding used by MapChunk::toRLE. Each run is stored as a RLEPair
+	 * or, if the run is a single block, just the block id with RLE_COUNT_BIT set.
+	 */
+	template<bool YMajor>
+	class RLECodec {
+		public:
+			static void encode(const MapChunk::DenseData& blocks, std::vector<byte>& encoding) {
+				// Worst case is every block in its own run
+				const auto offset = encoding.size();
+				encoding.resize(offset + blockCount * sizeof(BlockId));
+				byte* out = encoding.data() + offset;
+
+				forEachRun<YMajor>(blocks, [&](const BlockId bid, const int32 count) ENGINE_INLINE {
+					if (count == 1) {
+						const BlockId single = bid | MapChunk::RLE_COUNT_BIT;
+						memcpy(out, &single, sizeof(single));
+						out += sizeof(single);
+					} else {
+						const RLEPair pair = {.bid = bid, .count = static_cast<uint16>(count)};
+						memcpy(out, &pair, sizeof(pair));
+						out += sizeof(pair);
+					}
+				});
+
+				encoding.resize(out - encoding.data());
+			}
+
+			static bool decode(const byte* begin, const byte* end, MapChunk::DenseData& blocks) {
+				RLEPair pair;
+				int32 i = 0;
+
+				while (begin != end) {
+					if (end - begin < static_cast<ptrdiff_t>(sizeof(pair.bid))) { return false; }
+					memcpy(&pair.bid, begin, sizeof(pair.bid));
+					begin += sizeof(pair.bid);
+
+					if (pair.bid & MapChunk::RLE_COUNT_BIT) {
+						pair.bid = static_cast<BlockId>(pair.bid ^ MapChunk::RLE_COUNT_BIT);
+						pair.count = 1;
+					} else {
+						if (end - begin < static_cast<ptrdiff_t>(sizeof(pair.count))) { return false; }
+						memcpy(&pair.count, begin, sizeof(pair.count));
+						begin += sizeof(pair.count);
+					}
+
+					if (pair.bid >= BlockId::_COUNT || pair.count == 0 || i + pair.count > blockCount) { return false; }
+					fillRun<YMajor>(blocks, i, pair.count, pair.bid);
+					i += pair.count;
+				}
+
+				return i == blockCount;
+			}
+	};
+
+	void writeVarint(uint32 value, std::vector<byte>& out) {
+		while (value >= 0x80) {
+			out.push_back(static_cast<byte>(value | 0x80));
+			value >>= 7;
+		}
+		out.push_back(static_cast<byte>(value));
+	}
+
+	bool readVarint(const byte*& it, const byte* end, uint32& value) noexcept {
+		value = 0;
+		for (int32 shift = 0; shift < 32; shift += 7) {
+			if (it == end) { return false; }
+			const auto b = *it++;
+			value |= static_cast<uint32>(b & 0x7F) << shift;
+			if (!(b & 0x80)) { return true; }
+		}
+		return false;
+	}
+
+	/**
+	 * A byte-wise rANS coder with a 32 bit state.
+	 * @see https://github.com/rygorous/ryg_rans
+	 */
+	namespace RANS {
+		constexpr uint32 probBits = 12;
+		constexpr uint32 lowerBound = 1u << 23;
+
+		/**
+		 * Encodes a symbol. Symbols must be encoded in the reverse order they will be decoded.
+		 * Output is written backwards from @p out.
+		 */
+		ENGINE_INLINE void put(uint32& state, byte*& out, const uint32 start, const uint32 freq) noexcept {
+			const uint32 max = ((lowerBound >> probBits) << 8) * freq;
+			while (state >= max) {
+				*--out = static_cast<byte>(state & 0xFF);
+				state >>= 8;
+			}
+			state = ((state / freq) << probBits) + (state % freq) + start;
+		}
+
+		ENGINE_INLINE uint32 slot(const uint32 state) noexcept {
+			return state & ((1u << probBits) - 1);
+		}
+
+		/**
+		 * Removes a symbol from the state and refills it from the input.
+		 * @return False if the input ran out.
+		 */
+		ENGINE_INLINE bool advance(uint32& state, const byte*& it, const byte* end, const uint32 start, const uint32 freq) noexcept {
+			state = freq * (state >> probBits) + slot(state) - start;
+			while (state < lowerBound) {
+				if (it == end) { return false; }
+				state = (state << 8) | *it++;
+			}
+			return true;
+		}
+	}
+
+	/**
+	 * A static frequency table for a rANS coder over @p N symbols.
+	 */
+	template<int32 N>
+	class FreqTable {
+		public:
+			constexpr static uint32 probScale = 1 << RANS::probBits;
+			static_assert(N <= 256, "Symbols must fit in the uint8 lookup.");
+			static_assert(blockCount <= probScale, "Every run must be able to have a non-zero frequency.");
+
+			uint32 counts[N] = {};
+			uint16 freq[N] = {};
+			uint16 start[N] = {};
+
+			/** Maps each slot in [0, probScale) to its symbol. Only built when decoding. */
+			uint8 lookup[probScale];
+
+		public:
+			/**
+			 * Scales the counts so the frequencies sum to probScale.
+			 * The total count must be in [1, probScale] so that every used symbol gets a non-zero frequency.
+			 */
+			void normalize() noexcept {
+				uint32 total = 0;
+				int32 largest = 0;
+				for (int32 s = 0; s < N; ++s) {
+					total += counts[s];
+					if (counts[s] > counts[largest]) { largest = s; }
+				}
+				ENGINE_DEBUG_ASSERT(total > 0 && total <= probScale, "Invalid frequency table total.");
+
+				uint32 sum = 0;
+				for (int32 s = 0; s < N; ++s) {
+					freq[s] = static_cast<uint16>(uint64{counts[s]} * probScale / total);
+					sum += freq[s];
+				}
+
+				// Give the rounding error to the most common symbol since it costs the least there
+				freq[largest] = static_cast<uint16>(freq[largest] + probScale - sum);
+
+				uint16 curr = 0;
+				for (int32 s = 0; s < N; ++s) {
+					start[s] = curr;
+					curr += freq[s];
+				}
+			}
+
+			void buildLookup() noexcept {
+				for (int32 s = 0; s < N; ++s) {
+					memset(lookup + start[s], s, freq[s]);
+				}
+			}
+
+			void write(std::vector<byte>& out) const {
+				// A bitmask of the used symbols followed by the count of each
+				byte mask[(N + 7) / 8] = {};
+				for (int32 s = 0; s < N; ++s) {
+					if (counts[s]) { mask[s / 8] |= 1 << (s % 8); }
+				}
+
+				out.insert(out.end(), std::begin(mask), std::end(mask));
+				for (int32 s = 0; s < N; ++s) {
+					if (counts[s]) { writeVarint(counts[s], out); }
+				}
+			}
+
+			bool read(const byte*& it, const byte* end) noexcept {
+				byte mask[(N + 7) / 8];
+				if (end - it < static_cast<ptrdiff_t>(sizeof(mask))) { return false; }
+				memcpy(mask, it, sizeof(mask));
+				it += sizeof(mask);
+
+				for (int32 s = 0; s < N; ++s) {
+					counts[s] = 0;
+					if (mask[s / 8] & (1 << (s % 8))) {
+						if (!readVarint(it, end, counts[s]) || counts[s] == 0 || counts[s] > blockCount) { return false; }
+					}
+				}
+
+				for (int32 s = N; s < static_cast<int32>(sizeof(mask) * 8); ++s) {
+					if (mask[s / 8] & (1 << (s % 8))) { return false; }
+				}
+
+				return true;
+			}
+
+			[[nodiscard]]
+			uint32 total() const noexcept {
+				uint32 res = 0;
+				for (const auto c : counts) { res += c; }
+				return res;
+			}
+	};
+
+	/**
+	 * Run lengths are coded as a bucket (the bit width of `count - 1`) followed by the low bits.
+	 */
+	constexpr int32 lengthBuckets = std::bit_width(static_cast<uint32>(blockCount - 1)) + 1;
+
+	ENGINE_INLINE int32 lengthBucket(const int32 count) noexcept {
+		return std::bit_width(static_cast<uint32>(count - 1));
+	}
+
+	ENGINE_INLINE int32 lengthExtraBits(const int32 bucket) noexcept {
+		return bucket > 1 ? bucket - 1 : 0;
+	}
+
+	/**
+	 * The runs from RLE with the block ids and run lengths entropy coded using rANS.
+	 *
+	 * Layout: block frequencies, length bucket frequencies, final coder state, coder output.
+	 * The frequencies are the raw counts from this chunk. If the chunk is a single run only the
+	 * block frequencies are stored.
+	 */
+	class RANSCodec {
+		private:
+			constexpr static auto probBits = RANS::probBits;
+			using BlockTable = FreqTable<BlockId::_COUNT>;
+			using LengthTable = FreqTable<lengthBuckets>;
+			static_assert(lengthBuckets - 2 <= static_cast<int32>(probBits), "Extra bits must fit in the coder precision.");
+
+		public:
+			static void encode(const MapChunk::DenseData& blocks, std::vector<byte>& encoding) {
+				RLEPair runs[blockCount];
+				int32 runCount = 0;
+
+				// Only the counts and freq are used when encoding so the lookup can stay uninitialized
+				BlockTable blockTable;
+				LengthTable lengthTable;
+
+				forEachRun<false>(blocks, [&](const BlockId bid, const int32 count) ENGINE_INLINE {
+					runs[runCount++] = {.bid = bid, .count = static_cast<uint16>(count)};
+					++blockTable.counts[bid];
+					++lengthTable.counts[lengthBucket(count)];
+				});
+
+				blockTable.write(encoding);
+				if (runCount == 1) { return; }
+				lengthTable.write(encoding);
+
+				blockTable.normalize();
+				lengthTable.normalize();
+
+				// Worst case each symbol flushes two bytes. Three symbols per run plus the final state.
+				const auto offset = encoding.size();
+				const auto maxSize = runCount * 3 * 2 + sizeof(uint32);
+				encoding.resize(offset + maxSize);
+				byte* const stop = encoding.data() + encoding.size();
+				byte* out = stop;
+
+				uint32 state = RANS::lowerBound;
+				for (int32 r = runCount - 1; r >= 0; --r) {
+					const auto& run = runs[r];
+					const auto bucket = lengthBucket(run.count);
+
+					if (const auto extra = lengthExtraBits(bucket)) {
+						const uint32 value = (run.count - 1) & ((1u << extra) - 1);
+						RANS::put(state, out, value << (probBits - extra), 1u << (probBits - extra));
+					}
+
+					RANS::put(state, out, lengthTable.start[bucket], lengthTable.freq[bucket]);
+					RANS::put(state, out, blockTable.start[run.bid], blockTable.freq[run.bid]);
+				}
+
+				out -= sizeof(state);
+				memcpy(out, &state, sizeof(state));
+
+				const auto size = stop - out;
+				memmove(encoding.data() + offset, out, size);
+				encoding.resize(offset + size);
+			}
+
+			static bool decode(const byte* begin, const byte* end, MapChunk::DenseData& blocks) {
+				BlockTable blockTable;
+				if (!blockTable.read(begin, end)) { return false; }
+
+				const auto runCount = blockTable.total();
+				if (runCount == 0) { return false; }
+				if (runCount == 1) {
+					const auto found = std::find_if(std::begin(blockTable.counts), std::end(blockTable.counts), [](auto c){ return c != 0; });
+					const auto bid = static_cast<BlockId>(found - std::begin(blockTable.counts));
+					std::fill(&blocks[0][0], &blocks[0][0] + blockCount, bid);
+					return begin == end;
+				}
+
+				LengthTable lengthTable;
+				if (runCount > blockCount || !lengthTable.read(begin, end) || lengthTable.total() != runCount) { return false; }
+
+				blockTable.normalize();
+				blockTable.buildLookup();
+				lengthTable.normalize();
+				lengthTable.buildLookup();
+
+				uint32 state;
+				if (end - begin < static_cast<ptrdiff_t>(sizeof(state))) { return false; }
+				memcpy(&state, begin, sizeof(state));
+				begin += sizeof(state);
+
+				int32 i = 0;
+				for (uint32 r = 0; r < runCount; ++r) {
+					const auto bid = static_cast<BlockId>(blockTable.lookup[RANS::slot(state)]);
+					if (!RANS::advance(state, begin, end, blockTable.start[bid], blockTable.freq[bid])) { return false; }
+
+					const auto bucket = lengthTable.lookup[RANS::slot(state)];
+					if (!RANS::advance(state, begin, end, lengthTable.start[bucket], lengthTable.freq[bucket])) { return false; }
+
+					int32 count = bucket == 0 ? 1 : (1 << (bucket - 1)) + 1;
+					if (const auto extra = lengthExtraBits(bucket)) {
+						const auto value = RANS::slot(state) >> (probBits - extra);
+						if (!RANS::advance(state, begin, end, value << (probBits - extra), 1u << (probBits - extra))) { return false; }
+						count += value;
+					}
+
+					if (i + count > blockCount) { return false; }
+					fillRun<false>(blocks, i, count, bid);
+					i += count;
+				}
+
+				// The encoder starts at the lower bound so any corruption is very likely to end somewhere else
+				return i == blockCount && begin == end && state == RANS::lowerBound;
+			}
+	};
+}
+
+namespace Game {
+	void encodeChunk(const ChunkCodec codec, const MapChunk::DenseData& blocks, std::vector<byte>& encoding) {
+		switch (codec) {
+			case ChunkCodec::RLE: { return RLECodec<false>::encode(blocks, encoding); }
+			case ChunkCodec::RowRLE: { return RLECodec<true>::encode(blocks, encoding); }
+			case ChunkCodec::RANS: { return RANSCodec::encode(blocks, encoding); }
+		}
+		ENGINE_DEBUG_ASSERT(false, "Invalid chunk codec.");
+	}
+
+	bool decodeChunk(const ChunkCodec codec, const byte* begin, const byte* end, MapChunk::DenseData& blocks) {
+		switch (codec) {
+			case ChunkCodec::RLE: { return RLECodec<false>::decode(begin, end, blocks); }
+			case ChunkCodec::RowRLE: { return RLECodec<true>::decode(begin, end, blocks); }
+			case ChunkCodec::RANS: { return RANSCodec::decode(begin, end, blocks); }
+		}
+		return false;
+	}
+
+	const char* getChunkCodecName(const ChunkCodec codec) noexcept {
+		switch (codec) {
+			case ChunkCodec::RLE: { return "RLE"; }
+			case ChunkCodec::RowRLE: { return "RowRLE"; }
+			case ChunkCodec::RANS: { return "RANS"; }
+		}
+		return "Invalid";
+	}
+}
@@ -0,0 +1,401 @@
+// STD
+#include <array>
+#include <cstring>
+#include <immintrin.h>
+
+// Engine
+#include <Engine/CPU/CPU.hpp>
+
+// Game
+#include <Game/MapChunk.hpp>
+#include <Game/MapChunkEdit.hpp>
+#include <Game/ChunkCodec.hpp>
+
+
+namespace {
+	using namespace Game;
+	using ColumnMask = MapChunk::ColumnMask;
+	using Column = BlockId[MapChunk::size.y];
+
+	static_assert(sizeof(BlockId) == sizeof(int16), "SIMD paths assume 16 bit block ids.");
+	static_assert(sizeof(Column) == 4 * sizeof(__m256i));
+
+	constexpr auto solidLookup = []{
+		std::array<bool, BlockId::_COUNT> res = {};
+		for (int32 i = 0; i < BlockId::_COUNT; ++i) {
+			res[i] = getBlockMeta(static_cast<BlockId>(i)).solid;
+		}
+		return res;
+	}();
+
+	ENGINE_INLINE bool isSolid(const BlockId bid) noexcept {
+		return bid < BlockId::_COUNT && solidLookup[bid];
+	}
+
+	/**
+	 * Gets the smallest supported number of bits needed to store @p count palette entries.
+	 */
+	constexpr uint8 bitsFor(const size_t count) noexcept {
+		if (count <= 1) { return 0; }
+		if (count <= 2) { return 1; }
+		if (count <= 4) { return 2; }
+		if (count <= 16) { return 4; }
+		if (count <= 256) { return 8; }
+		return MapChunk::directBits;
+	}
+
+	/**
+	 * A word with the lowest bit of each @p Bits sized field set.
+	 */
+	template<int32 Bits>
+	constexpr uint64 fieldLowBits = [] {
+		uint64 res = 0;
+		for (int32 i = 0; i < 64; i += Bits) { res |= uint64{1} << i; }
+		return res;
+	}();
+
+	/**
+	 * Finds the @p Bits sized fields of @p word equal to @p value.
+	 * @return A mask with bit `i` set if field `i` is equal to @p value.
+	 */
+	template<int32 Bits>
+	ENGINE_INLINE uint64 matchFields(const uint64 word, const uint64 value) noexcept {
+		constexpr auto low = fieldLowBits<Bits>;
+		auto x = word ^ (value * low);
+
+		// Fold each field down into its lowest bit
+		for (int32 s = 1; s < Bits; s <<= 1) { x |= x >> s; }
+		x = ~x & low;
+
+		// Compact the lowest bit of each field into consecutive bits
+		if constexpr (Bits == 2) {
+			x = (x | (x >> 1)) & 0x3333333333333333;
+			x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0F;
+			x = (x | (x >> 4)) & 0x00FF00FF00FF00FF;
+			x = (x | (x >> 8)) & 0x0000FFFF0000FFFF;
+			x = (x | (x >> 16)) & 0x00000000FFFFFFFF;
+		} else if constexpr (Bits == 4) {
+			x = (x | (x >> 3)) & 0x0303030303030303;
+			x = (x | (x >> 6)) & 0x000F000F000F000F;
+			x = (x | (x >> 12)) & 0x000000FF000000FF;
+			x = (x | (x >> 24)) & 0x000000000000FFFF;
+		} else if constexpr (Bits == 8) {
+			x = (x | (x >> 7)) & 0x0003000300030003;
+			x = (x | (x >> 14)) & 0x0000000F0000000F;
+			x = (x | (x >> 28)) & 0x00000000000000FF;
+		} else {
+			static_assert(Bits == 1, "Unsupported field size.");
+		}
+
+		return x;
+	}
+
+	/**
+	 * Finds the blocks in a packed column with palette index @p value.
+	 */
+	template<int32 Bits>
+	ENGINE_INLINE ColumnMask matchColumn(const uint64* words, const uint64 value) noexcept {
+		constexpr int32 perWord = 64 / Bits;
+		ColumnMask res = 0;
+		for (int32 i = 0; i < Bits; ++i) {
+			res |= matchFields<Bits>(words[i], value) << (i * perWord);
+		}
+		return res;
+	}
+
+	/**
+	 * Packs two vectors of 16 bit compare results into a single 32 bit mask.
+	 */
+	ENGINE_INLINE uint32 packMaskAVX2(const __m256i a, const __m256i b) noexcept {
+		// packs interleaves the 128 bit lanes: [a0 b0 a1 b1] -> [a0 a1 b0 b1]
+		const auto packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(a, b), 0b11'01'10'00);
+		return static_cast<uint32>(_mm256_movemask_epi8(packed));
+	}
+
+	ENGINE_INLINE uint32 packMaskSSE2(const __m128i a, const __m128i b) noexcept {
+		return static_cast<uint32>(_mm_movemask_epi8(_mm_packs_epi16(a, b)));
+	}
+
+	ColumnMask columnMaskAVX2(const Column& col, const BlockId bid) noexcept {
+		const auto* vec = reinterpret_cast<const __m256i*>(col);
+		const auto val = _mm256_set1_epi16(static_cast<int16>(bid));
+		const auto lo = packMaskAVX2(
+			_mm256_cmpeq_epi16(_mm256_loadu_si256(vec + 0), val),
+			_mm256_cmpeq_epi16(_mm256_loadu_si256(vec + 1), val)
+		);
+		const auto hi = packMaskAVX2(
+			_mm256_cmpeq_epi16(_mm256_loadu_si256(vec + 2), val),
+			_mm256_cmpeq_epi16(_mm256_loadu_si256(vec + 3), val)
+		);
+		return ColumnMask{lo} | (ColumnMask{hi} << 32);
+	}
+
+	ColumnMask columnMaskSSE2(const Column& col, const BlockId bid) noexcept {
+		const auto* vec = reinterpret_cast<const __m128i*>(col);
+		const auto val = _mm_set1_epi16(static_cast<int16>(bid));
+		ColumnMask res = 0;
+		for (int32 i = 0; i < 4; ++i) {
+			const auto m = packMaskSSE2(
+				_mm_cmpeq_epi16(_mm_loadu_si128(vec + 2*i + 0), val),
+				_mm_cmpeq_epi16(_mm_loadu_si128(vec + 2*i + 1), val)
+			);
+			res |= ColumnMask{m} << (16 * i);
+		}
+		return res;
+	}
+}
+
+namespace Game {
+	void MapChunk::setBlock(const glm::ivec2 pos, const BlockId bid) noexcept {
+		if (bits == directBits) {
+			setRaw(pos, bid);
+		} else {
+			auto idx = paletteIndex(bid);
+			if (idx < 0) {
+				idx = static_cast<int32>(palette.size());
+				palette.push_back(bid);
+
+				if (palette.size() > (size_t{1} << bits)) {
+					repack(bitsFor(palette.size()));
+				}
+			}
+
+			if (bits == directBits) {
+				setRaw(pos, bid);
+			} else if (bits) {
+				setRaw(pos, idx);
+			}
+		}
+
+		const auto bit = ColumnMask{1} << pos.y;
+		solidMask[pos.x] = isSolid(bid) ? (solidMask[pos.x] | bit) : (solidMask[pos.x] & ~bit);
+		renderMask[pos.x] = isRenderable(bid) ? (renderMask[pos.x] | bit) : (renderMask[pos.x] & ~bit);
+	}
+
+	void MapChunk::assign(const DenseData& blocks) noexcept {
+		palette.clear();
+		int32 lastIdx = -1;
+		BlockId lastBid = {};
+
+		// Build the palette first so we only pack once
+		for (const auto& col : blocks) {
+			for (const auto bid : col) {
+				if (lastIdx >= 0 && bid == lastBid) { continue; }
+				lastBid = bid;
+				lastIdx = paletteIndex(bid);
+				if (lastIdx < 0) {
+					lastIdx = static_cast<int32>(palette.size());
+					palette.push_back(bid);
+				}
+			}
+		}
+
+		bits = bitsFor(palette.size());
+		packed.assign(size.x * bits, 0);
+
+		if (bits == directBits) {
+			palette.clear();
+			for (int32 x = 0; x < size.x; ++x) {
+				memcpy(&packed[x * bits], blocks[x], sizeof(blocks[x]));
+			}
+		} else if (bits) {
+			lastIdx = -1;
+			for (int32 x = 0; x < size.x; ++x) {
+				for (int32 y = 0; y < size.y; ++y) {
+					const auto bid = blocks[x][y];
+					if (lastIdx < 0 || bid != lastBid) {
+						lastBid = bid;
+						lastIdx = paletteIndex(bid);
+					}
+					setRaw({x, y}, lastIdx);
+				}
+			}
+		}
+
+		packed.shrink_to_fit();
+		palette.shrink_to_fit();
+
+		for (int32 x = 0; x < size.x; ++x) {
+			updateMasks(x);
+		}
+	}
+
+	void MapChunk::toDense(DenseData& blocks) const noexcept {
+		if (bits == 0) {
+			std::fill(&blocks[0][0], &blocks[0][0] + size.x * size.y, palette[0]);
+		} else if (bits == directBits) {
+			for (int32 x = 0; x < size.x; ++x) {
+				memcpy(blocks[x], &packed[x * bits], sizeof(blocks[x]));
+			}
+		} else {
+			for (int32 x = 0; x < size.x; ++x) {
+				for (int32 y = 0; y < size.y; ++y) {
+					blocks[x][y] = palette[getRaw({x, y})];
+				}
+			}
+		}
+	}
+
+	uint64 MapChunk::hash() const noexcept {
+		DenseData blocks;
+		toDense(blocks);
+
+		uint64 words[sizeof(blocks) / sizeof(uint64)];
+		memcpy(words, blocks, sizeof(blocks));
+
+		// Multiply-rotate mixing similar to xxHash with a final avalanche
+		uint64 h = 0x27D4EB2F165667C5;
+		for (const auto w : words) {
+			h ^= std::rotl(w * 0xC2B2AE3D27D4EB4F, 31) * 0x9E3779B185EBCA87;
+			h = std::rotl(h, 27) * 0x9E3779B185EBCA87 + 0x85EBCA77C2B2AE63;
+		}
+
+		h ^= h >> 33;
+		h *= 0xC2B2AE3D27D4EB4F;
+		h ^= h >> 29;
+		h *= 0x165667B19E3779F9;
+		h ^= h >> 32;
+		return h;
+	}
+
+	void MapChunk::toRLE(std::vector<byte>& encoding) const {
+		encoding.clear();
+
+		// Reserve space for position data
+		encoding.insert(encoding.end(), sizeof(size), 0);
+
+		DenseData blocks;
+		toDense(blocks);
+		encodeChunk(ChunkCodec::RLE, blocks, encoding);
+	}
+
+	bool MapChunk::fromRLE(const byte* begin, const byte* end) {
+		DenseData decoded;
+		if (!decodeChunk(ChunkCodec::RLE, begin, end, decoded)) {
+			ENGINE_WARN("Invalid chunk RLE data.");
+			return false;
+		}
+
+		DenseData blocks;
+		toDense(blocks);
+		bool editMade = false;
+
+		for (int32 x = 0; x < size.x; ++x) {
+			for (int32 y = 0; y < size.y; ++y) {
+				const auto bid = decoded[x][y];
+				if (bid == BlockId::None || bid == blocks[x][y]) { continue; }
+				blocks[x][y] = bid;
+				editMade = true;
+			}
+		}
+
+		if (editMade) { assign(blocks); }
+		return editMade;
+	}
+
+	void MapChunk::compact() noexcept {
+		DenseData blocks;
+		toDense(blocks);
+		assign(blocks);
+	}
+
+	auto MapChunk::columnMask(const int32 x, const BlockId bid) const noexcept -> ColumnMask {
+		if (bits == directBits) {
+			const auto& col = *reinterpret_cast<const Column*>(&packed[x * bits]);
+			if (Engine::CPU::hasAVX2()) {
+				return columnMaskAVX2(col, bid);
+			} else {
+				return columnMaskSSE2(col, bid);
+			}
+		}
+
+		const auto idx = paletteIndex(bid);
+		if (idx < 0) { return 0; }
+
+		const auto* words = packed.data() + x * bits;
+		switch (bits) {
+			case 0: { return ~ColumnMask{0}; }
+			case 1: { return matchColumn<1>(words, idx); }
+			case 2: { return matchColumn<2>(words, idx); }
+			case 4: { return matchColumn<4>(words, idx); }
+			case 8: { return matchColumn<8>(words, idx); }
+			default: {
+				ENGINE_WARN("Invalid bits per block ", bits);
+				return 0;
+			}
+		}
+	}
+
+	bool MapChunk::apply(const MapChunkEdit& edit) noexcept {
+		bool editMade = false;
+
+		for (const auto& entry : edit.entries()) {
+			const auto pos = MapChunkEdit::toPos(entry.index);
+			if (getBlock(pos) == entry.bid) { continue; }
+
+			editMade = true;
+			setBlock(pos, entry.bid);
+		}
+
+		return editMade;
+	}
+
+	int32 MapChunk::paletteIndex(const BlockId bid) const noexcept {
+		for (size_t i = 0; i < palette.size(); ++i) {
+			if (palette[i] == bid) { return static_cast<int32>(i); }
+		}
+		return -1;
+	}
+
+	void MapChunk::repack(const uint8 newBits) noexcept {
+		const auto oldBits = bits;
+		const auto old = std::move(packed);
+
+		bits = newBits;
+		packed.assign(size.x * bits, 0);
+
+		for (int32 x = 0; x < size.x; ++x) {
+			for (int32 y = 0; y < size.y; ++y) {
+				uint32 v = 0;
+				if (oldBits) {
+					const auto bit = y * oldBits;
+					const auto word = old[x * oldBits + bit / wordBits];
+					v = static_cast<uint32>((word >> (bit % wordBits)) & ((Word{1} << oldBits) - 1));
+				}
+				setRaw({x, y}, bits == directBits ? palette[v] : v);
+			}
+		}
+
+		if (bits == directBits) {
+			palette.clear();
+			palette.shrink_to_fit();
+		}
+	}
+
+	void MapChunk::updateMasks(const int32 x) noexcept {
+		ColumnMask solid = 0;
+		ColumnMask render = 0;
+
+		if (bits == directBits) {
+			const auto* col = reinterpret_cast<const BlockId*>(&packed[x * bits]);
+			for (int32 y = 0; y < size.y; ++y) {
+				const auto bid = col[y];
+				solid |= ColumnMask{isSolid(bid)} << y;
+				render |= ColumnMask{isRenderable(bid)} << y;
+			}
+		} else {
+			for (const auto bid : palette) {
+				const auto s = isSolid(bid);
+				const auto r = isRenderable(bid);
+				if (!s && !r) { continue; }
+
+				const auto m = columnMask(x, bid);
+				if (s) { solid |= m; }
+				if (r) { render |= m; }
+			}
+		}
+
+		solidMask[x] = solid;
+		renderMask[x] = render;
+	}
+}
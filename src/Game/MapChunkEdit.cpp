@@ -0,0 +1,102 @@
+// STD
+#include <cstring>
+
+// Game
+#include <Game/MapChunkEdit.hpp>
+
+
+namespace {
+	using namespace Game;
+
+	/**
+	 * A run of consecutive blocks set to the same value. Brushes edit
+	 * consecutive blocks in a column so this is much smaller than the raw entries.
+	 */
+	struct Run {
+		uint16 index;
+		uint16 count;
+		BlockId bid;
+	};
+	static_assert(sizeof(Run) == 6); // Ensure tight packing
+}
+
+namespace Game {
+	void MapChunkEdit::set(const glm::ivec2 pos, const BlockId bid) noexcept {
+		const auto index = toIndex(pos);
+		const auto bit = MapChunk::ColumnMask{1} << pos.y;
+		auto& col = touched[pos.x];
+
+		if (col & bit) {
+			// Repeated edits to a block are rare so a linear search is fine
+			for (auto& entry : edits) {
+				if (entry.index == index) {
+					entry.bid = bid;
+					return;
+				}
+			}
+			ENGINE_DEBUG_ASSERT(false, "Edited block is missing from the edit list.");
+		}
+
+		col |= bit;
+		edits.push_back({.index = index, .bid = bid});
+	}
+
+	void MapChunkEdit::clear() noexcept {
+		for (const auto& entry : edits) {
+			touched[entry.index / MapChunk::size.y] = 0;
+		}
+		edits.clear();
+	}
+
+	void MapChunkEdit::encode(std::vector<byte>& encoding) const {
+		encoding.clear();
+
+		// Reserve space for position data
+		encoding.insert(encoding.end(), sizeof(MapChunk::size), 0);
+
+		const auto insert = [&](const Run& run) ENGINE_INLINE {
+			const auto* start = reinterpret_cast<const byte*>(&run);
+			encoding.insert(encoding.end(), start, start + sizeof(run));
+		};
+
+		if (edits.empty()) { return; }
+		Run run = {.index = edits[0].index, .count = 1, .bid = edits[0].bid};
+
+		for (size_t i = 1; i < edits.size(); ++i) {
+			const auto& entry = edits[i];
+			if (entry.bid == run.bid && entry.index == run.index + run.count) {
+				++run.count;
+			} else {
+				insert(run);
+				run = {.index = entry.index, .count = 1, .bid = entry.bid};
+			}
+		}
+		insert(run);
+	}
+
+	bool MapChunkEdit::decode(const byte* begin, const byte* end) {
+		constexpr auto sz = MapChunk::size.x * MapChunk::size.y;
+		if ((end - begin) % sizeof(Run) != 0) { return false; }
+
+		for (; begin != end; begin += sizeof(Run)) {
+			Run run;
+			memcpy(&run, begin, sizeof(run));
+			if (run.index + run.count > sz || run.bid >= BlockId::_COUNT) { return false; }
+
+			for (int32 i = run.index; i < run.index + run.count; ++i) {
+				set(toPos(static_cast<uint16>(i)), run.bid);
+			}
+		}
+
+		return true;
+	}
+
+	void MapChunkEdit::fromDense(const MapChunk::DenseData& blocks) {
+		for (int32 x = 0; x < MapChunk::size.x; ++x) {
+			for (int32 y = 0; y < MapChunk::size.y; ++y) {
+				if (blocks[x][y] == BlockId::None) { continue; }
+				set({x, y}, blocks[x][y]);
+			}
+		}
+	}
+}
@@ -1,3 +1,6 @@
+// STD
+#include <algorithm>
+
 // GLM
 #include <glm/glm.hpp>
 
@@ -38,6 +41,44 @@ namespace {
 	ENGINE_INLINE constexpr Game::MapGenerator2::Float operator""_f(const long double v) noexcept {
 		return static_cast<Game::MapGenerator2::Float>(v);
 	}
+
+	// Tree heights are in the range `[h + treeMinHeight, h + treeMinHeight + treeHeightVar]`
+	constexpr Game::MapGenerator2::Int treeMinHeight = 25;
+	constexpr Game::MapGenerator2::Int treeHeightVar = 50;
+
+	// Spacing of the boss portal grid
+	constexpr Game::MapGenerator2::Int bossPortalSpacing = 50;
+	constexpr Game::MapGenerator2::Float bossPortalScale = 1.0_f / bossPortalSpacing;
+}
+
+namespace Game {
+	struct MapGenerator2::Column {
+		constexpr static Int maxCount = MapChunk::size.y;
+
+		Int x;
+		Int y;
+		Int count;
+
+		/** The index of the block currently being generated. Relative to `y`. */
+		Int row;
+
+		Float h0;
+
+		/** If every block in the column has the same biome. If set `biome`, `bounds`, and `h` are valid. */
+		bool uniform;
+		Biome biome;
+		BiomeBounds bounds;
+		Int h;
+
+		/** If any block in the column is in a boss portal grid cell that contains a boss portal. */
+		bool bossPortal;
+
+		uint32 heightOffsetReady;
+		Float heightOffsets[static_cast<int>(Biome::Jungle) + 1];
+
+		uint32 samplesReady;
+		Float samples[static_cast<int>(Sample::_COUNT)][maxCount];
+	};
 }
 
 #define DEF_BIOME_HEIGHT_OFFSET(B)\
@@ -53,7 +94,7 @@ namespace {
 #define DEF_BIOME_BASIS(B)\
 	template<>\
 	[[nodiscard]]\
-	ENGINE_INLINE auto MapGenerator2::biomeBasis<MapGenerator2::Biome:: B>(const FVec2 pos, const Int h) const noexcept -> Float
+	ENGINE_INLINE auto MapGenerator2::biomeBasis<MapGenerator2::Biome:: B>(Column& col, const FVec2 pos, const Int h) const noexcept -> Float
 
 #define DEF_BIOME_BASIS_STRENGTH(B)\
 	template<>\
@@ -63,12 +104,12 @@ namespace {
 #define DEF_BIOME_BLOCK(B)\
 	template<>\
 	[[nodiscard]]\
-	ENGINE_INLINE BlockId MapGenerator2::biomeBlock<MapGenerator2::Biome:: B>(const FVec2 pos, const IVec2 ipos, const Int h, const Float h0, const BiomeBounds bounds) const noexcept
+	ENGINE_INLINE BlockId MapGenerator2::biomeBlock<MapGenerator2::Biome:: B>(Column& col, const FVec2 pos, const IVec2 ipos, const Int h, const BiomeBounds bounds) const noexcept
 
 #define DEF_BIOME_BLOCK_STRENGTH(B)\
 	template<>\
 	[[nodiscard]]\
-	ENGINE_INLINE auto MapGenerator2::biomeBlockStrength<MapGenerator2::Biome:: B>(const FVec2 pos, const Float basisStrength) const noexcept -> bool
+	ENGINE_INLINE auto MapGenerator2::biomeBlockStrength<MapGenerator2::Biome:: B>(Column& col, const FVec2 pos, const Float basisStrength) const noexcept -> bool
 
 ////////////////////////////////////////////////////////////////////////////////
 // Biome 0
@@ -88,7 +129,7 @@ namespace Game {
 		// TODO: we really want this to be a very large gradient so caves get larger with depth
 		constexpr Float groundScale = 1.0_f / 100.0_f;
 		const Float groundGrad = std::max(0.0_f, 1.0_f - (h - pos.y) * groundScale);
-		return simplex.value(pos * 0.06_f) + groundGrad;
+		return sample(col, Sample::BasisDefault) + groundGrad;
 	}
 
 	DEF_BIOME_BASIS_STRENGTH(Default) {
@@ -108,7 +149,7 @@ namespace Game {
 			}
 		}
 
-		if (const auto r = resource(pos)) {
+		if (const auto r = resource(col, pos)) {
 			return r;
 		}
 
@@ -138,7 +179,7 @@ namespace Game {
 		// TODO: we really want this to be a very large gradient so caves get larger with depth
 		constexpr Float groundScale = 1.0_f / 100.0_f;
 		const Float groundGrad = std::max(0.0_f, 1.0_f - (h - pos.y) * groundScale);
-		return simplex.value(pos * 0.01_f) + groundGrad;
+		return sample(col, Sample::BasisForest) + groundGrad;
 	}
 
 	DEF_BIOME_BASIS_STRENGTH(Forest) {
@@ -150,7 +191,7 @@ namespace Game {
 	}
 
 	DEF_BIOME_BLOCK_STRENGTH(Forest) {
-		return genericBiomeBlockStrength(pos, basisStrength);
+		return genericBiomeBlockStrength(col, pos, basisStrength);
 	}
 }
 
@@ -172,7 +213,7 @@ namespace Game {
 		// TODO: we really want this to be a very large gradient so caves get larger with depth
 		constexpr Float groundScale = 1.0_f / 100.0_f;
 		const Float groundGrad = std::max(0.0_f, 1.0_f - (h - pos.y) * groundScale);
-		return simplex.value(pos * 0.005_f) + groundGrad;
+		return sample(col, Sample::BasisJungle) + groundGrad;
 	}
 
 	DEF_BIOME_BASIS_STRENGTH(Jungle) {
@@ -184,7 +225,7 @@ namespace Game {
 	}
 
 	DEF_BIOME_BLOCK_STRENGTH(Jungle) {
-		return genericBiomeBlockStrength(pos, basisStrength);
+		return genericBiomeBlockStrength(col, pos, basisStrength);
 	}
 }
 #undef DEF_BIOME_HEIGHT_OFFSET
@@ -210,7 +251,7 @@ namespace Game {
 		const auto left = Engine::Noise::floorTo<Int>(ipos.x * (1.0_f / treeSpacing)); // Use the left grid cell to determine trees
 
 		if (perm.value(left) < treeThresh) {
-			const Int treeH = h + 25 + static_cast<Int>(perm.value(left - 321) * (50.0_f/255.0_f));
+			const Int treeH = h + treeMinHeight + static_cast<Int>(perm.value(left - 321) * (treeHeightVar / 255.0_f));
 			if (ipos.y < treeH) {
 				constexpr Int trunkD = 3; // Trunk width // TODO: doesnt work correctly for even width.
 				constexpr Int trunkR = (trunkD / 2) + (trunkD / 2.0_f != trunkD / 2);
@@ -263,13 +304,9 @@ namespace Game {
 ////////////////////////////////////////////////////////////////////////////////
 namespace Game {
 	DEF_LANDMARK_SAMPLE(BossPortal) {
-		constexpr Int w = 50;
-		constexpr Float d = 1.0_f / w;
-		const auto scaled = pos * d;
+		const auto scaled = pos * bossPortalScale;
 		const auto cell = glm::floor(scaled);
-		// TODO: we will want this to be a much smaller than 1%. Is there a function we could use instead of a perm table?
-		// TODO: cont. Could we just use a LCG and seed from cell.x and cell.y? look into other hash functions
-		if (perm(static_cast<int>(cell.x), static_cast<int>(cell.y), static_cast<int>(Landmark::BossPortal)) > 5) { return { .exists = false }; }
+		if (!bossPortalCell(cell)) { return { .exists = false }; }
 		const auto offC = 2.0_f * (scaled - cell) - 1.0_f; // Offset from center [-1, 1]
 		const auto grad = 2 * glm::min(glm::length2(offC)*glm::length2(offC), 1.0_f); // Circle grad [0, 2]
 
@@ -287,41 +324,122 @@ namespace Game {
 
 #undef DEF_LANDMARK_SAMPLE
 
+namespace Game {
+	bool MapGenerator2::bossPortalCell(const IVec2 cell) const noexcept {
+		// TODO: we will want this to be a much smaller than 1%. Is there a function we could use instead of a perm table?
+		// TODO: cont. Could we just use a LCG and seed from cell.x and cell.y? look into other hash functions
+		return perm(cell.x, cell.y, static_cast<int>(Landmark::BossPortal)) <= 5;
+	}
+}
+
 namespace Game {
 	void MapGenerator2::init(const IVec2 pos, MapChunk& chunk, std::vector<BlockEntityDesc>& entData) const noexcept {
 		BlockGenData bgd = { .exists = false };
+		MapChunk::DenseData data;
+		Column col;
 
 		for (int x = 0; x < MapChunk::size.x; ++x) {
-			for (int y = 0; y < MapChunk::size.y; ++y) {
+			initColumn(col, pos.x + x, pos.y, MapChunk::size.y);
+
+			// Above the terrain the only non-air blocks come from landmarks
+			auto airFrom = MapChunk::size.y;
+			if (col.uniform && !col.bossPortal) {
+				airFrom = std::clamp(col.h + treeMinHeight + treeHeightVar + 1 - pos.y, 0, MapChunk::size.y);
+				std::fill(data[x] + airFrom, data[x] + MapChunk::size.y, BlockId::Air);
+			}
+
+			for (int y = 0; y < airFrom; ++y) {
 				const auto blockPos = pos + IVec2{x,y};
-				const auto v = value(blockPos.x, blockPos.y, bgd);
+				const auto v = value(col, blockPos.y, bgd);
 
 				if (bgd.exists) {
 					bgd.desc.pos = blockPos;
 					entData.push_back(bgd.desc);
-					chunk.data[x][y] = BlockId::Entity;
+					data[x][y] = BlockId::Entity;
 					bgd.exists = false;
 				} else {
-					chunk.data[x][y] = v;
+					data[x][y] = v;
 				}
 
-				if (chunk.data[x][y] > BlockId::Air && (x == 0 || y == 0) && chunk.data[x][y] != BlockId::Debug2) {
-					chunk.data[x][y] = BlockId::Debug;
+				if (data[x][y] > BlockId::Air && (x == 0 || y == 0) && data[x][y] != BlockId::Debug2) {
+					data[x][y] = BlockId::Debug;
 				}
 			}
 		}
+
+		chunk.assign(data);
 	}
 
 	BlockId MapGenerator2::value(const Int x, const Int y, BlockGenData& bgd) const noexcept {
-		const FVec2 ipos = IVec2{x, y};
-		const FVec2 pos = FVec2{static_cast<Float>(x), static_cast<Float>(y)};
-		const auto h0 = height0(pos.x);
-		const auto posBiome = pos - FVec2{0, h0} - biomeOffset;
-		const auto bounds = biomeAt(posBiome);
+		Column col;
+		initColumn(col, x, y, 1);
+		return value(col, y, bgd);
+	}
+
+	auto MapGenerator2::biome(const IVec2 pos) const noexcept -> Biome {
+		const FVec2 fpos = pos;
+		const auto posBiome = fpos - FVec2{0, height0(fpos.x)} - biomeOffset;
+		return biomeFor(biomeAt(posBiome));
+	}
+
+	void MapGenerator2::initColumn(Column& col, const Int x, const Int y, const Int count) const noexcept {
+		ENGINE_DEBUG_ASSERT(count > 0 && count <= Column::maxCount, "Invalid column size ", count);
+		col.x = x;
+		col.y = y;
+		col.count = count;
+		col.row = 0;
+		col.h0 = height0(static_cast<Float>(x));
+		col.heightOffsetReady = 0;
+		col.samplesReady = 0;
 
-		const Biome b = bounds.depth < 0 ? Biome::Default : static_cast<Biome>(perm(bounds.cell.x, bounds.cell.y) % (static_cast<int>(Biome::Jungle) + 1));
+		// The biome cells and portal cells are monotonic in y so we only need to check the ends
+		const auto y2 = y + count - 1;
+		const auto posBiome1 = FVec2{static_cast<Float>(x), static_cast<Float>(y)} - FVec2{0, col.h0} - biomeOffset;
+		const auto posBiome2 = FVec2{static_cast<Float>(x), static_cast<Float>(y2)} - FVec2{0, col.h0} - biomeOffset;
+
+		col.uniform = true;
+		for (int l = 0; l < std::size(biomeScales); ++l) {
+			if (glm::floor(posBiome1.y * biomeScalesInv[l]) != glm::floor(posBiome2.y * biomeScalesInv[l])) {
+				col.uniform = false;
+				break;
+			}
+		}
+
+		if (col.uniform) {
+			col.bounds = biomeAt(posBiome1);
+			col.biome = biomeFor(col.bounds);
+
+			#define CASE(B) case B: { col.h = height<B>(col, col.bounds); break; };
+			switch (col.biome) {
+				CASE(Biome::Default)
+				CASE(Biome::Forest)
+				CASE(Biome::Jungle)
+				default: { col.uniform = false; }
+			}
+			#undef CASE
+		}
+
+		const Int portalX = Engine::Noise::floorTo<Int>(x * bossPortalScale);
+		const Int portalY1 = Engine::Noise::floorTo<Int>(y * bossPortalScale);
+		const Int portalY2 = Engine::Noise::floorTo<Int>(y2 * bossPortalScale);
+		col.bossPortal = false;
+		for (Int cy = portalY1; cy <= portalY2; ++cy) {
+			if (bossPortalCell({portalX, cy})) {
+				col.bossPortal = true;
+				break;
+			}
+		}
+	}
+
+	BlockId MapGenerator2::value(Column& col, const Int y, BlockGenData& bgd) const noexcept {
+		col.row = y - col.y;
+		const FVec2 ipos = IVec2{col.x, y};
+		const FVec2 pos = FVec2{static_cast<Float>(col.x), static_cast<Float>(y)};
+		const auto posBiome = pos - FVec2{0, col.h0} - biomeOffset;
+		const auto bounds = col.uniform ? col.bounds : biomeAt(posBiome);
+		const Biome b = col.uniform ? col.biome : biomeFor(bounds);
 		
-		#define CASE(B) case B: { return calc<B>(ipos, pos, h0, posBiome, bounds, bgd); };
+		#define CASE(B) case B: { return calc<B>(col, ipos, pos, posBiome, bounds, bgd); };
 		switch (b) {
 			CASE(Biome::Default)
 			CASE(Biome::Forest)
@@ -334,22 +452,55 @@ namespace Game {
 		#undef CASE
 	}
 
+	auto MapGenerator2::sample(Column& col, const Sample s) const noexcept -> Float {
+		const auto i = static_cast<int>(s);
+		auto& samples = col.samples[i];
+
+		if (!(col.samplesReady & (1 << i))) {
+			col.samplesReady |= 1 << i;
+
+			// Must match the scaling used by the scalar version of each sample
+			constexpr Float scales[] = {
+				0.06_f, // BasisDefault
+				0.01_f, // BasisForest
+				0.005_f, // BasisJungle
+				1.0_f / 7.0_f, // ResourceGold
+				1.0_f / 5.0_f, // ResourceIron
+				0.03_f, // BlockStrength1
+				0.09_f, // BlockStrength2
+			};
+			static_assert(std::size(scales) == static_cast<size_t>(Sample::_COUNT));
+
+			Float xs[Column::maxCount];
+			Float ys[Column::maxCount];
+			const auto scale = scales[i];
+			for (Int j = 0; j < col.count; ++j) {
+				xs[j] = static_cast<Float>(col.x) * scale;
+				ys[j] = static_cast<Float>(col.y + j) * scale;
+			}
+
+			simplex.valueN(xs, ys, samples, col.count);
+		}
+
+		return samples[col.row];
+	}
+
 	template<MapGenerator2::Biome B>
-	BlockId MapGenerator2::calc(const IVec2 ipos, const FVec2 pos, const Float h0, const FVec2 posBiome, const BiomeBounds bounds, BlockGenData& bgd) const noexcept {
-		const auto h = height<B>(pos.x, bounds, h0);
+	BlockId MapGenerator2::calc(Column& col, const IVec2 ipos, const FVec2 pos, const FVec2 posBiome, const BiomeBounds bounds, BlockGenData& bgd) const noexcept {
+		const auto h = col.uniform ? col.h : height<B>(col, bounds);
 
 		const auto bstr = basisStrength<B>(pos, posBiome, bounds);
-		const auto b = basis<B>(pos, h, bstr);
+		const auto b = basis<B>(col, pos, h, bstr);
 
 		// TODO: move before basis stuff if we have l2.block != None
-		const auto l2 = landmark<B>(pos, ipos, h, bgd);
+		const auto l2 = landmark<B>(col, pos, ipos, h, bgd);
 		if (l2.exists) {
 			const auto b2 = b + l2.basis;
 			if (b2 < 0.0_f) {
 				//return BlockId::Debug2;
 				return BlockId::Air;
 			} else {
-				return l2.block ? l2.block : block<B>(pos, ipos, h, h0, bounds, bstr);
+				return l2.block ? l2.block : block<B>(col, pos, ipos, h, bounds, bstr);
 			}
 		}
 
@@ -357,29 +508,29 @@ namespace Game {
 			return BlockId::Air;
 		};
 
-		return block<B>(pos, ipos, h, h0, bounds, bstr);
+		return block<B>(col, pos, ipos, h, bounds, bstr);
 	}
 
-	BlockId MapGenerator2::resource(const FVec2 pos) const noexcept {
+	BlockId MapGenerator2::resource(Column& col, const FVec2 pos) const noexcept {
 		struct ResourceSpec {
-			consteval ResourceSpec(BlockId b, Float s, Float d)
-				: block{b}, scale{1.0_f/s}, density{d * 2.0_f - 1.0_f} {
+			consteval ResourceSpec(BlockId b, Sample s, Float d)
+				: block{b}, sample{s}, density{d * 2.0_f - 1.0_f} {
 			}
 
 			BlockId block = BlockId::None;
-			Float scale = 1.0_f;
+			Sample sample = {};
 			Float density = 0.0_f;
 		};
 
 		// TODO: will probably want to be able to set biome/depth requirements
+		// The scale of each resource is set in `sample`
 		constexpr ResourceSpec ores[] = {
-			{BlockId::Gold, 7.0_f, 0.11_f},
-			{BlockId::Iron, 5.0_f, 0.2_f},
+			{BlockId::Gold, Sample::ResourceGold, 0.11_f},
+			{BlockId::Iron, Sample::ResourceIron, 0.2_f},
 		};
 
 		for (const auto& ore : ores) {
-			const auto p = pos * ore.scale;
-			if (simplex.value(p.x, p.y) < ore.density) {
+			if (sample(col, ore.sample) < ore.density) {
 				return ore.block;
 			}
 		}
@@ -416,31 +567,53 @@ namespace Game {
 		return {-1};
 	}
 
+	auto MapGenerator2::biomeFor(const BiomeBounds bounds) const noexcept -> Biome {
+		return bounds.depth < 0 ? Biome::Default : static_cast<Biome>(perm(bounds.cell.x, bounds.cell.y) % (static_cast<int>(Biome::Jungle) + 1));
+	}
+
 	auto MapGenerator2::height0(const Float x) const noexcept -> Float {
 		return heightVar * simplex.value(0.000005_f * x, 0); // TODO: 1d simplex
 	}
 	
 	template<MapGenerator2::Biome B>
-	auto MapGenerator2::height(const Float x, const BiomeBounds bounds, const Float h0) const noexcept -> Int {
-		const auto hOff1 = biomeHeightOffset<Biome::Default>(x);
+	auto MapGenerator2::height(Column& col, const BiomeBounds bounds) const noexcept -> Int {
+		const auto x = static_cast<Float>(col.x);
+		const auto hOff1 = heightOffset<Biome::Default>(col);
 		auto h = hOff1;
 
 		if constexpr (B != Biome::Default) {
 			if (bounds.depth >= 0) {
-				const auto hOff2 = biomeHeightOffset<B>(x);
+				const auto hOff2 = heightOffset<B>(col);
 				const auto b2s = biomeHeightStrength<B>(x, bounds);
 				h = hOff1 + b2s * (hOff2 - hOff1);
 			}
 		}
 
-		return static_cast<Int>(h + h0);
+		return static_cast<Int>(h + col.h0);
+	}
+
+	template<MapGenerator2::Biome B>
+	auto MapGenerator2::heightOffset(Column& col) const noexcept -> Float {
+		constexpr auto i = static_cast<int>(B);
+		if (!(col.heightOffsetReady & (1 << i))) {
+			col.heightOffsetReady |= 1 << i;
+			col.heightOffsets[i] = biomeHeightOffset<B>(static_cast<Float>(col.x));
+		}
+		return col.heightOffsets[i];
 	}
 	
 	template<MapGenerator2::Biome B>
-	auto MapGenerator2::landmark(const FVec2 pos, const IVec2 ipos, const Int h, BlockGenData& bgd) const noexcept -> LandmarkSample {
+	auto MapGenerator2::landmark(const Column& col, const FVec2 pos, const IVec2 ipos, const Int h, BlockGenData& bgd) const noexcept -> LandmarkSample {
 		LandmarkSample res = {};
 
 		const auto sample = [&]<Landmark L>() ENGINE_INLINE {
+			if constexpr (L == Landmark::BossPortal) {
+				if (!col.bossPortal) {
+					res = { .exists = false };
+					return;
+				}
+			}
+
 			res = landmarkSample<L>(pos, ipos, h, bgd);
 		};
 
@@ -463,29 +636,29 @@ namespace Game {
 	}
 	
 	template<MapGenerator2::Biome B>
-	auto MapGenerator2::basis(const FVec2 pos, const Int h, const Float bstr) const noexcept -> Float {
+	auto MapGenerator2::basis(Column& col, const FVec2 pos, const Int h, const Float bstr) const noexcept -> Float {
 		if constexpr (B != Biome::Default) {
 			if (bstr > 0.0_f) {
-				const auto b2 = biomeBasis<B>(pos, h);
+				const auto b2 = biomeBasis<B>(col, pos, h);
 				if (bstr >= 1.0_f) { return b2; }
 
-				const auto b1 = biomeBasis<Biome::Default>(pos, h);
+				const auto b1 = biomeBasis<Biome::Default>(col, pos, h);
 				return b1 + bstr * (b2 - b1);
 			}
 		}
 
-		return biomeBasis<Biome::Default>(pos, h);
+		return biomeBasis<Biome::Default>(col, pos, h);
 	}
 	
 	template<MapGenerator2::Biome B>
-	BlockId MapGenerator2::block(const FVec2 pos, const FVec2 ipos, const Int h, const Float h0, const BiomeBounds bounds, const Float bstr) const noexcept {
+	BlockId MapGenerator2::block(Column& col, const FVec2 pos, const FVec2 ipos, const Int h, const BiomeBounds bounds, const Float bstr) const noexcept {
 		if constexpr (B != Biome::Default) {
-			if (bounds.depth >= 0 && biomeBlockStrength<B>(pos, bstr)) {
-				return biomeBlock<B>(pos, ipos, h, h0, bounds);
+			if (bounds.depth >= 0 && biomeBlockStrength<B>(col, pos, bstr)) {
+				return biomeBlock<B>(col, pos, ipos, h, bounds);
 			}
 		}
 
-		return biomeBlock<Biome::Default>(pos, ipos, h, h0, bounds);
+		return biomeBlock<Biome::Default>(col, pos, ipos, h, bounds);
 	}
 
 	/*
@@ -526,10 +699,10 @@ namespace Game {
 		return glm::compMin(off * tDist);
 	}
 	
-	auto MapGenerator2::genericBiomeBlockStrength(const FVec2 pos, const Float basisStrength) const noexcept -> bool {
+	auto MapGenerator2::genericBiomeBlockStrength(Column& col, const FVec2 pos, const Float basisStrength) const noexcept -> bool {
 		auto adj = basisStrength;
-		adj += 0.3_f * simplex.value(0.03_f * pos);
-		adj += 0.3_f * simplex.value(0.09_f * pos);
+		adj += 0.3_f * sample(col, Sample::BlockStrength1);
+		adj += 0.3_f * sample(col, Sample::BlockStrength2);
 		return 0.5_f < adj;
 	}
 }
@@ -0,0 +1,286 @@
+// STD
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+// Game
+#include <Game/MapRegion.hpp>
+#include <Game/ChunkCodec.hpp>
+
+
+namespace {
+	using namespace Game;
+
+	/** "WRGN" when read as bytes */
+	constexpr uint32 fileMagic = 0x4E475257;
+
+	struct FileHeader {
+		uint32 magic;
+		uint32 version;
+		int64 seed;
+		int32 regionX;
+		int32 regionY;
+		int32 sizeX;
+		int32 sizeY;
+	};
+	static_assert(sizeof(FileHeader) == 32);
+
+	class Writer {
+		public:
+			std::vector<byte> buffer;
+
+			template<class T>
+			void write(const T& value) {
+				static_assert(std::is_trivially_copyable_v<T>);
+				const auto* start = reinterpret_cast<const byte*>(&value);
+				buffer.insert(buffer.end(), start, start + sizeof(T));
+			}
+
+			void write(const byte* data, const size_t size) {
+				buffer.insert(buffer.end(), data, data + size);
+			}
+	};
+
+	class Reader {
+		public:
+			const byte* curr;
+			const byte* const end;
+
+			template<class T>
+			bool read(T& value) {
+				static_assert(std::is_trivially_copyable_v<T>);
+				if (end - curr < static_cast<ptrdiff_t>(sizeof(T))) { return false; }
+				memcpy(&value, curr, sizeof(T));
+				curr += sizeof(T);
+				return true;
+			}
+
+			bool skip(const size_t size) {
+				if (static_cast<size_t>(end - curr) < size) { return false; }
+				curr += size;
+				return true;
+			}
+	};
+
+	template<BlockEntityType Type>
+	void writeEntityData(Writer& writer, const BlockEntityTypeData<Type>& data) {
+		if constexpr (Type == BlockEntityType::Tree) {
+			writer.write(data.type);
+			writer.write(data.size.x);
+			writer.write(data.size.y);
+		}
+	}
+
+	template<BlockEntityType Type>
+	bool readEntityData(Reader& reader, BlockEntityTypeData<Type>& data) {
+		if constexpr (Type == BlockEntityType::Tree) {
+			return reader.read(data.type) && reader.read(data.size.x) && reader.read(data.size.y);
+		} else {
+			return true;
+		}
+	}
+
+	using EntityCount = uint16;
+	using EntityOffset = int16;
+	static_assert(static_cast<size_t>(BlockEntityType::_COUNT) <= std::numeric_limits<uint8>::max());
+
+	ENGINE_INLINE bool fitsOffset(const glm::ivec2 off) noexcept {
+		constexpr auto min = std::numeric_limits<EntityOffset>::min();
+		constexpr auto max = std::numeric_limits<EntityOffset>::max();
+		return off.x >= min && off.x <= max && off.y >= min && off.y <= max;
+	}
+
+	ENGINE_INLINE glm::ivec2 chunkOrigin(const glm::ivec2 regionPos, const int32 x, const int32 y) noexcept {
+		return (regionPos * MapRegion::size + glm::ivec2{x, y}) * MapChunk::size;
+	}
+}
+
+namespace Game {
+	std::string MapRegion::filePath(const std::string& dir, const glm::ivec2 regionPos) {
+		return dir + "/" + std::to_string(regionPos.x) + "_" + std::to_string(regionPos.y) + ".region";
+	}
+
+	bool MapRegion::save(const std::string& path, const glm::ivec2 regionPos, const int64 seed) const {
+		Writer writer;
+		writer.write(FileHeader{
+			.magic = fileMagic,
+			.version = fileVersion,
+			.seed = seed,
+			.regionX = regionPos.x,
+			.regionY = regionPos.y,
+			.sizeX = size.x,
+			.sizeY = size.y,
+		});
+
+		std::vector<byte> rle;
+		for (const auto& col : data) {
+			for (const auto& info : col) {
+				// Skip the space toRLE reserves for the chunk position
+				info.chunk.toRLE(rle);
+				const auto rleSize = static_cast<uint32>(rle.size() - sizeof(MapChunk::size));
+				writer.write(rleSize);
+				writer.write(rle.data() + sizeof(MapChunk::size), rleSize);
+			}
+		}
+
+		writeBlockEntities(writer.buffer, regionPos);
+
+		std::ofstream file{path, std::ios::binary | std::ios::out | std::ios::trunc};
+		if (!file) {
+			ENGINE_WARN("Unable to open region file: ", path);
+			return false;
+		}
+
+		file.write(reinterpret_cast<const char*>(writer.buffer.data()), writer.buffer.size());
+		return static_cast<bool>(file);
+	}
+
+	bool MapRegion::load(const std::string& path, const glm::ivec2 regionPos, const int64 seed) {
+		std::ifstream file{path, std::ios::binary | std::ios::in};
+		if (!file) {
+			ENGINE_WARN("Unable to open region file: ", path);
+			return false;
+		}
+
+		std::vector<byte> content;
+		file.seekg(0, std::ios::end);
+		content.resize(file.tellg());
+		file.seekg(0, std::ios::beg);
+		file.read(reinterpret_cast<char*>(content.data()), content.size());
+
+		Reader reader{content.data(), content.data() + content.size()};
+		FileHeader head;
+		if (!reader.read(head) || head.magic != fileMagic) {
+			ENGINE_WARN("Invalid region file: ", path);
+			return false;
+		}
+
+		if (head.version != fileVersion) {
+			ENGINE_WARN("Unsupported region file version ", head.version, ": ", path);
+			return false;
+		}
+
+		if (head.seed != seed || head.regionX != regionPos.x || head.regionY != regionPos.y || head.sizeX != size.x || head.sizeY != size.y) {
+			ENGINE_WARN("Region file does not match the requested region: ", path);
+			return false;
+		}
+
+		MapChunk::DenseData blocks;
+		for (auto& col : data) {
+			for (auto& info : col) {
+				uint32 rleSize = 0;
+				if (!reader.read(rleSize)) { return false; }
+
+				const auto* rle = reader.curr;
+				if (!reader.skip(rleSize)) { return false; }
+
+				// Not fromRLE since it can not tell malformed data apart from an empty chunk
+				if (!decodeChunk(ChunkCodec::RLE, rle, rle + rleSize, blocks)) {
+					ENGINE_WARN("Invalid chunk data in region file: ", path);
+					return false;
+				}
+
+				info.chunk.assign(blocks);
+			}
+		}
+
+		if (readBlockEntities(reader.curr, reader.end, regionPos) != reader.end) {
+			ENGINE_WARN("Invalid block entity data in region file: ", path);
+			return false;
+		}
+
+		return true;
+	}
+
+	void MapRegion::writeBlockEntities(std::vector<byte>& out, const glm::ivec2 regionPos) const {
+		Writer writer;
+		writer.buffer.swap(out);
+
+		const auto sizeAt = writer.buffer.size();
+		writer.write(uint32{});
+
+		auto countAt = writer.buffer.size();
+		writer.buffer.resize(countAt + size.x * size.y * sizeof(EntityCount));
+
+		for (int32 x = 0; x < size.x; ++x) {
+			for (int32 y = 0; y < size.y; ++y) {
+				const auto origin = chunkOrigin(regionPos, x, y);
+				EntityCount count = 0;
+
+				for (const auto& desc : data[x][y].entData) {
+					const auto off = desc.pos - origin;
+					if (!fitsOffset(off)) {
+						ENGINE_WARN("Block entity is too far from its chunk to store. Skipping.");
+						continue;
+					}
+
+					if (count == std::numeric_limits<EntityCount>::max()) {
+						ENGINE_WARN("Too many block entities in chunk to store. Skipping.");
+						break;
+					}
+
+					++count;
+					writer.write(static_cast<EntityOffset>(off.x));
+					writer.write(static_cast<EntityOffset>(off.y));
+					writer.write(static_cast<uint8>(desc.data.type));
+					desc.data.with([&]<BlockEntityType Type>(const auto& typeData) {
+						writeEntityData<Type>(writer, typeData);
+					});
+				}
+
+				memcpy(writer.buffer.data() + countAt, &count, sizeof(count));
+				countAt += sizeof(count);
+			}
+		}
+
+		const auto sectionSize = static_cast<uint32>(writer.buffer.size() - sizeAt - sizeof(uint32));
+		memcpy(writer.buffer.data() + sizeAt, &sectionSize, sizeof(sectionSize));
+		writer.buffer.swap(out);
+	}
+
+	const byte* MapRegion::readBlockEntities(const byte* begin, const byte* end, const glm::ivec2 regionPos) {
+		Reader reader{begin, end};
+		uint32 sectionSize = 0;
+		if (!reader.read(sectionSize) || static_cast<size_t>(end - reader.curr) < sectionSize) { return nullptr; }
+
+		Reader counts{reader.curr, reader.curr + sectionSize};
+		Reader ents{counts.curr, counts.end};
+		if (!ents.skip(size.x * size.y * sizeof(EntityCount))) { return nullptr; }
+
+		for (int32 x = 0; x < size.x; ++x) {
+			for (int32 y = 0; y < size.y; ++y) {
+				EntityCount count = 0;
+				counts.read(count);
+
+				const auto origin = chunkOrigin(regionPos, x, y);
+				auto& entData = data[x][y].entData;
+				entData.clear();
+				entData.reserve(count);
+
+				for (EntityCount i = 0; i < count; ++i) {
+					EntityOffset offX = 0;
+					EntityOffset offY = 0;
+					uint8 type = 0;
+					if (!ents.read(offX) || !ents.read(offY) || !ents.read(type)) { return nullptr; }
+					if (type >= static_cast<uint8>(BlockEntityType::_COUNT)) {
+						ENGINE_WARN("Invalid block entity type ", static_cast<int32>(type), ".");
+						return nullptr;
+					}
+
+					auto& desc = entData.emplace_back();
+					desc.pos = origin + glm::ivec2{offX, offY};
+					desc.data.type = static_cast<BlockEntityType>(type);
+
+					bool good = true;
+					desc.data.with([&]<BlockEntityType Type>(auto& typeData) {
+						good = readEntityData<Type>(ents, typeData);
+					});
+					if (!good) { return nullptr; }
+				}
+			}
+		}
+
+		// Trailing data would mean the counts and entities disagree
+		return ents.curr == ents.end ? ents.end : nullptr;
+	}
+}
@@ -0,0 +1,78 @@
+// STD
+#include <algorithm>
+#include <functional>
+
+// Game
+#include <Game/PhysicsState.hpp>
+
+
+namespace Game {
+	void PhysicsState::store(b2World& world) {
+		clear();
+		add(world);
+	}
+
+	void PhysicsState::add(b2World& world) {
+		for (auto* body = world.GetBodyList(); body; body = body->GetNext()) {
+			if (body->GetType() == b2_staticBody) { continue; }
+
+			bodies.push_back({
+				.body = body,
+				.pos = body->GetPosition(),
+				.angle = body->GetAngle(),
+				.vel = body->GetLinearVelocity(),
+				.angVel = body->GetAngularVelocity(),
+				.awake = body->IsAwake(),
+			});
+		}
+
+		// Box2D only creates contacts that involve at least one non-static body
+		const auto firstContact = contacts.size();
+		for (auto* contact = world.GetContactList(); contact; contact = contact->GetNext()) {
+			const auto* fixtureA = contact->GetFixtureA();
+			const auto* fixtureB = contact->GetFixtureB();
+
+			contacts.push_back({
+				.fixtureA = fixtureA,
+				.fixtureB = fixtureB,
+				.bodyA = fixtureA->GetBody(),
+				.bodyB = fixtureB->GetBody(),
+				.childA = contact->GetChildIndexA(),
+				.childB = contact->GetChildIndexB(),
+				.manifold = *contact->GetManifold(),
+			});
+		}
+
+		const auto mid = contacts.begin() + firstContact;
+		std::sort(mid, contacts.end(), less);
+		std::inplace_merge(contacts.begin(), mid, contacts.end(), less);
+	}
+
+	void PhysicsState::remove(const b2Body* body) {
+		std::erase_if(bodies, [&](const BodyState& state){ return state.body == body; });
+		removeContacts(body);
+	}
+
+	void PhysicsState::removeContacts(const b2Body* body) {
+		std::erase_if(contacts, [&](const ContactState& state){ return state.bodyA == body || state.bodyB == body; });
+	}
+
+	void PhysicsState::shiftOrigin(const b2World& world, const b2Vec2& newOrigin) noexcept {
+		for (auto& state : bodies) {
+			if (state.body->GetWorld() == &world) { state.pos -= newOrigin; }
+		}
+	}
+
+	void PhysicsState::clear() noexcept {
+		bodies.clear();
+		contacts.clear();
+	}
+
+	bool PhysicsState::less(const ContactState& a, const ContactState& b) noexcept {
+		constexpr std::less<const b2Fixture*> cmp;
+		if (a.fixtureA != b.fixtureA) { return cmp(a.fixtureA, b.fixtureA); }
+		if (a.fixtureB != b.fixtureB) { return cmp(a.fixtureB, b.fixtureB); }
+		if (a.childA != b.childA) { return a.childA < b.childA; }
+		return a.childB < b.childB;
+	}
+}
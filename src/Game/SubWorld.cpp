@@ -0,0 +1,93 @@
+// STD
+#include <numeric>
+
+// Game
+#include <Game/SubWorld.hpp>
+
+
+namespace Game {
+	void PlayerGroups::build() {
+		// Sorted so that only players within splitRange on the x axis need to be compared
+		std::sort(players.begin(), players.end(), [](const Player& a, const Player& b){
+			if (a.pos.x != b.pos.x) { return a.pos.x < b.pos.x; }
+			return a.ent.id < b.ent.id;
+		});
+
+		const auto size = static_cast<int32>(players.size());
+		parents.resize(size);
+		std::iota(parents.begin(), parents.end(), 0);
+
+		const auto find = [&](int32 i) ENGINE_INLINE {
+			while (parents[i] != i) {
+				parents[i] = parents[parents[i]];
+				i = parents[i];
+			}
+			return i;
+		};
+
+		for (int32 i = 0; i < size; ++i) {
+			const auto& ply1 = players[i];
+			for (int32 j = i + 1; j < size && players[j].pos.x - ply1.pos.x <= splitRange; ++j) {
+				const auto& ply2 = players[j];
+				const auto range = ply1.physWorld == ply2.physWorld ? splitRange : mergeRange;
+				if ((ply2.pos - ply1.pos).LengthSquared() > range * range) { continue; }
+
+				const auto a = find(i);
+				const auto b = find(j);
+				if (a != b) { parents[std::max(a, b)] = std::min(a, b); }
+			}
+		}
+
+		// The root of each set is its lowest index so it is always seen before the rest of the set
+		groups.clear();
+		for (int32 i = 0; i < size; ++i) {
+			auto& ply = players[i];
+			const auto root = find(i);
+
+			if (root == i) {
+				ply.group = static_cast<int32>(groups.size());
+				groups.emplace_back().bounds = {ply.pos, ply.pos};
+			} else {
+				ply.group = players[root].group;
+			}
+
+			auto& group = groups[ply.group];
+			group.players.push_back(i);
+			group.bounds.lowerBound = b2Min(group.bounds.lowerBound, ply.pos);
+			group.bounds.upperBound = b2Max(group.bounds.upperBound, ply.pos);
+		}
+	}
+
+	b2Body* copyBodyToWorld(const b2Body& body, const b2Vec2 fromOrigin, b2World& world, const b2Vec2 toOrigin) {
+		b2BodyDef bodyDef;
+		b2FixtureDef fixtureDef;
+		bodyDef.type = body.GetType();
+		bodyDef.position = body.GetPosition() + (fromOrigin - toOrigin);
+		bodyDef.angle = body.GetAngle();
+		bodyDef.linearVelocity = body.GetLinearVelocity();
+		bodyDef.angularVelocity = body.GetAngularVelocity();
+		bodyDef.linearDamping = body.GetLinearDamping();
+		bodyDef.angularDamping = body.GetAngularDamping();
+		bodyDef.allowSleep = body.IsSleepingAllowed();
+		bodyDef.awake = body.IsAwake();
+		bodyDef.fixedRotation = body.IsFixedRotation();
+		bodyDef.bullet = body.IsBullet();
+		bodyDef.active = body.IsActive();
+		bodyDef.userData = body.GetUserData();
+		bodyDef.gravityScale = body.GetGravityScale();
+
+		auto* newBody = world.CreateBody(&bodyDef);
+		for (const auto* fixture = body.GetFixtureList(); fixture; fixture = fixture->GetNext()) {
+			fixtureDef.shape = fixture->GetShape();
+			fixtureDef.userData = fixture->GetUserData();
+			fixtureDef.friction = fixture->GetFriction();
+			fixtureDef.restitution = fixture->GetRestitution();
+			fixtureDef.density = fixture->GetDensity();
+			fixtureDef.isSensor = fixture->IsSensor();
+			fixtureDef.filter = fixture->GetFilterData();
+			newBody->CreateFixture(&fixtureDef);
+		}
+
+		return newBody;
+	}
+}
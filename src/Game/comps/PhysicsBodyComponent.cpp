@@ -4,12 +4,13 @@
 
 
 namespace Game {
-	void PhysicsBodyComponent::setBody(b2Body* body) {
+	void PhysicsBodyComponent::setBody(b2Body* body, b2Vec2 origin) {
 		this->body = body;
+		this->origin = origin;
 	}
 
 	void PhysicsBodyComponent::netTo(Engine::Net::BufferWriter& buff) const {
-		buff.write(getTransform());
+		buff.write(getNetTransform());
 		buff.write(getVelocity());
 	}
 
@@ -59,8 +60,8 @@ namespace Game {
 		netTo(buff);
 	}
 
-	void PhysicsBodyComponent::netFrom(Connection& conn) {
-		const auto trans = *conn.read<b2Transform>();
+	void PhysicsBodyComponent::netFrom(Connection& conn, const glm::dvec2 origin) {
+		const auto trans = conn.read<NetTransform>()->to(origin);
 		const auto vel = *conn.read<b2Vec2>();
 		setTransform(trans.p, trans.q.GetAngle());
 		rollbackOverride = true;
@@ -158,6 +159,6 @@ namespace Game {
 			}
 		}
 
-		netFrom(conn);
+		netFrom(conn, world.getSystem<PhysicsOriginShiftSystem>().getOrigin());
 	}
 }
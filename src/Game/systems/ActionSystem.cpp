@@ -1,3 +1,7 @@
+// STD
+#include <algorithm>
+#include <cmath>
+
 // Game
 #include <Game/systems/ActionSystem.hpp>
 #include <Game/World.hpp>
@@ -62,12 +66,17 @@ namespace Game {
 				const auto& tpos = engine.camera.screenToWorld(state.screenTarget);
 				state.target.x = tpos.x - pos.x;
 				state.target.y = tpos.y - pos.y;
+
+				// Rounded to the nearest tick. The server does not interpolate between ticks when rewinding.
+				const auto delay = world.getSystem<PhysicsSystem>().getRemoteDelay();
+				const auto delayTicks = std::lround(Engine::Clock::Seconds{delay} / Engine::Clock::Seconds{World::getTickInterval()});
+				state.viewDelay = static_cast<uint8>(std::clamp(delayTicks, 0l, 255l));
 			}
 
 			if constexpr (ENGINE_CLIENT) {
 				// Hey! are you wondering why the client sends so much data again?
 				// Well let me save you some time. This code sends about
-				// 12288 bytes per second assuming 64 tick and 64 action history states (sending 1/4 of that).
+				// 13312 bytes per second assuming 64 tick and 64 action history states (sending 1/4 of that).
 				// If we want to do better we need to compress this or send fewer states.
 				// Check trello for more complete explanation. https://trello.com/c/O3oJLMde
 
@@ -87,6 +96,7 @@ namespace Game {
 						// TODO: if you compress this make sure to replicate on client to remain in sync
 						msg.write<32>(reinterpret_cast<const uint32&>(s.target.x));
 						msg.write<32>(reinterpret_cast<const uint32&>(s.target.y));
+						msg.write<8>(s.viewDelay);
 					}
 
 					msg.writeFlushBits();
@@ -119,7 +129,7 @@ namespace Game {
 				//	actComp.states.capacity(), " | ",
 				//	actComp.states.max(), " ", actComp.states.minValid(), " = ",
 				//	actComp.states.max() - actComp.states.minValid());
-				// If we ever add lag compensation we will need to handle server rollback here.
+				// Lag compensation rewinds positions for queries only instead of rolling back the server. @see LagCompensationSystem
 			}
 		}
 	}
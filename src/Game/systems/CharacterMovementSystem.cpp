@@ -22,6 +22,7 @@ namespace Game {
 		constexpr float speed = 1.0f * 500;
 
 		for (auto ent : world.getFilter<Filter>()) {
+			if (!world.isRollbackAffected(ent)) { continue; }
 			auto& physComp = world.getComponent<PhysicsBodyComponent>(ent);
 			const auto& actComp = world.getComponent<ActionComponent>(ent);
 			// TODO: should we use press count here?
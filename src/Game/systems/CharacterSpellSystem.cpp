@@ -20,7 +20,6 @@ namespace Game {
 
 	void CharacterSpellSystem::setup() {
 		auto& physSys = world.getSystem<Game::PhysicsSystem>();
-		physSys.addListener(this);
 
 		constexpr std::size_t count = 10;
 		missiles.reserve(count);
@@ -41,7 +40,7 @@ namespace Game {
 				physBodyComp.setBody(physSys.createBody(ent, bodyDef));
 
 				b2CircleShape shape;
-				shape.m_radius = 0.5f;
+				shape.m_radius = missileRadius;
 
 				b2FixtureDef fixtureDef;
 				fixtureDef.shape = &shape;
@@ -59,26 +58,55 @@ namespace Game {
 		}
 	}
 	
-	void CharacterSpellSystem::queueMissile(const b2Vec2& pos, const b2Vec2& dir) {
+	void CharacterSpellSystem::queueMissile(const b2Vec2& pos, const b2Vec2& dir, bool hit) {
 		events.push_back(FireEvent{
 			.pos = pos,
 			.dir = dir,
+			.hit = hit,
 		});
 	}
 
-	void CharacterSpellSystem::fireMissile(const b2Vec2& pos, const b2Vec2& dir) {
+	Engine::ECS::Entity CharacterSpellSystem::fireMissile(Engine::ECS::Entity ent, const b2Vec2& pos, const b2Vec2& dir) {
 		auto missile = missiles[currentMissile];
 		world.setEnabled(missile, true);
 
+		// Pooled missiles are left in whichever world they were last used in
+		if constexpr (ENGINE_SERVER) {
+			if (world.isAlive(ent) && world.hasComponent<PhysicsBodyComponent>(ent)) {
+				auto& shooterComp = world.getComponent<PhysicsBodyComponent>(ent);
+				world.getSystem<SubWorldSystem>().migrate(missile, *shooterComp.getWorld(), shooterComp.getOrigin());
+			}
+		}
+
 		auto& physComp = world.getComponent<PhysicsBodyComponent>(missile);
 		physComp.snap = true;
 		physComp.setTransform(pos, 0);
 
 		auto& body = physComp.getBody();
 		body.SetActive(true); // TODO: use physComp instead
-		physComp.setVelocity(4.0f * dir);
+		physComp.setVelocity(missileVelocity(dir));
 
 		currentMissile = (currentMissile + 1) % missiles.size();
+		return missile;
+	}
+
+	bool CharacterSpellSystem::validateHit(Engine::ECS::Entity ent, const b2Vec2& pos, const b2Vec2& vel) {
+		auto& lagSys = world.getSystem<LagCompensationSystem>();
+		const auto players = world.getBitsetForComponents<PlayerFlag>();
+		const auto step = Engine::Glue::as<glm::vec2>(vel) * world.getTickDelta();
+		auto missilePos = Engine::Glue::as<glm::vec2>(pos);
+
+		// Missiles move less than their diameter each tick so checking once per tick does not skip over anything
+		for (auto tick = lagSys.getViewTick(ent); tick != world.getTick(); ++tick) {
+			hitResults.clear();
+			const auto found = lagSys.queryRadius(tick, missilePos, missileRadius, players, hitResults);
+			if (std::ranges::any_of(found, [&](const auto other){ return other != ent && world.isAlive(other); })) {
+				return true;
+			}
+			missilePos += step;
+		}
+
+		return false;
 	}
 
 	void CharacterSpellSystem::detonateMissile(Engine::ECS::Entity ent) {
@@ -89,6 +117,7 @@ namespace Game {
 
 	void CharacterSpellSystem::tick() {
 		for (const auto ent : world.getFilter<PhysicsBodyComponent, ActionComponent>()) {
+			if (!world.isRollbackAffected(ent)) { continue; }
 			auto& actComp = world.getComponent<ActionComponent>(ent);
 
 			if (actComp.getButton(Button::Attack1).pressCount) {
@@ -99,25 +128,24 @@ namespace Game {
 
 				queueMissile(pos + 1.3f * dir, 4.0f * dir);
 				events.back().ent = ent;
+
+				if constexpr (ENGINE_SERVER) {
+					events.back().hit = validateHit(ent, events.back().pos, missileVelocity(events.back().dir));
+				}
 			}
 		}
 
-		if (!toDestroy.empty()) {
-			std::sort(toDestroy.begin(), toDestroy.end());
-
-			while (!toDestroy.empty()) {
-				auto ent = toDestroy.back();
-				toDestroy.pop_back();
-				detonateMissile(ent);
-
-				while(!toDestroy.empty() && toDestroy.back() == ent) {
-					toDestroy.pop_back();
+		const auto& contacts = world.getSystem<PhysicsSystem>().getContacts();
+		if (!contacts.empty()) {
+			for (const auto missile : missiles) {
+				if (!contacts.get(ContactEvents::Type::Begin, missile).empty()) {
+					detonateMissile(missile);
 				}
 			}
 		}
 
 		for (const auto& event : events) {
-			fireMissile(event.pos, event.dir);
+			const auto missile = fireMissile(event.ent, event.pos, event.dir);
 
 			if constexpr (ENGINE_SERVER) {
 				for (const auto ply : world.getFilter<PlayerFlag>()) {
@@ -128,23 +156,16 @@ namespace Game {
 					if (auto msg = conn.beginMessage<MessageType::SPELL>()) {
 						msg.write(event.pos);
 						msg.write(event.dir);
+						msg.write(event.hit);
 					}
 				}
 			}
-		}
-		events.clear();
-	}
 
-	void CharacterSpellSystem::beginContact(const Engine::ECS::Entity& entA, const Engine::ECS::Entity& entB) {
-		const auto minEnt = missiles.front();
-		const auto maxEnt = missiles.back();
-
-		if (entA <= maxEnt && entA >= minEnt) {
-			toDestroy.push_back(entA);
-		}
-
-		if (entB <= maxEnt && entB >= minEnt) {
-			toDestroy.push_back(entB);
+			// Hits validated by the server are sent with the missile so every copy of it detonates on the same tick
+			if (event.hit) {
+				detonateMissile(missile);
+			}
 		}
+		events.clear();
 	}
 }
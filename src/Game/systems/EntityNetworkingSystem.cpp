@@ -3,6 +3,8 @@
 
 // Engine
 #include <Engine/Meta/ForEach.hpp>
+#include <Engine/Glue/Box2D.hpp>
+#include <Engine/Glue/glm.hpp>
 
 // Game
 #include <Game/World.hpp>
@@ -37,7 +39,7 @@ namespace Game {
 				const auto& physComp = world.getComponent<PhysicsBodyComponent>(ply);
 				if (auto msg = conn.beginMessage<MessageType::PLAYER_DATA>()) {
 					msg.write(world.getTick() + 1); // since this is in `run` and not before `tick` we are sending one tick off. +1 is temp fix
-					msg.write(physComp.getTransform());
+					msg.write(physComp.getNetTransform());
 					msg.write(physComp.getVelocity());
 				}
 			}
@@ -162,6 +164,9 @@ namespace Game {
 	}
 
 	void EntityNetworkingSystem::updateNeighbors() {
+		const auto& index = world.getSystem<SpatialSystem>().getBodyIndex();
+		const auto networked = world.getBitsetForComponents<NetworkedFlag>();
+
 		for (const auto ply : world.getFilter<PlayerFilter>()) {
 			auto& ecsNetComp = world.getComponent<ECSNetworkingComponent>(ply);
 			const auto& physComp = world.getComponent<PhysicsBodyComponent>(ply);
@@ -175,60 +180,26 @@ namespace Game {
 				return false;
 			});
 
-			struct QueryCallbackLarge : b2QueryCallback {
-				World& world;
-				ECSNetworkingComponent& ecsNetComp;
-
-				QueryCallbackLarge(World& world, ECSNetworkingComponent& ecsNetComp)
-					: world{world}, ecsNetComp{ecsNetComp} {
-				}
-
-				virtual bool ReportFixture(b2Fixture* fixture) override {
-					const Engine::ECS::Entity ent = Game::PhysicsSystem::toEntity(fixture->GetBody()->GetUserData());
-					if (ecsNetComp.neighbors.contains(ent)) {
-						ecsNetComp.neighbors.get(ent).state = ECSNetworkingComponent::NeighborState::Current;
-					}
-					return true;
-				}
-			} queryCallbackLarge(world, ecsNetComp);
-
-			
-			struct QueryCallbackSmall : b2QueryCallback {
-				const Engine::ECS::Entity ply;
-				World& world;
-				ECSNetworkingComponent& ecsNetComp;
-
-				QueryCallbackSmall(Engine::ECS::Entity ply, World& world, ECSNetworkingComponent& ecsNetComp)
-					: ply{ply}, world{world}, ecsNetComp{ecsNetComp} {
-				}
-
-				virtual bool ReportFixture(b2Fixture* fixture) override {
-					const Engine::ECS::Entity ent = Game::PhysicsSystem::toEntity(fixture->GetBody()->GetUserData());
-					if (!world.hasComponent<NetworkedFlag>(ent)) { return true; }
-					if (!ecsNetComp.neighbors.contains(ent) && ent != ply) {
-						ecsNetComp.neighbors.add(ent, ECSNetworkingComponent::NeighborState::Added);
-					}
-					return true;
-				}
-			} queryCallbackSmall(ply, world, ecsNetComp);
-
-
 			// We keep objects loaded in a larger area than we initially load them so that
 			// if an object is near the edge it doesnt get constantly created and destroyed
-			// as a player moves a small amount
-			const auto& pos = physComp.getPosition();
+			// as a player moves a small amount.
+			// Uses fixture bounds so that large entities are found when only part of them is in range.
+			const auto pos = Engine::Glue::as<glm::vec2>(physComp.getPosition());
 			constexpr float32 rangeSmall = 5; // TODO: what range?
 			constexpr float32 rangeLarge = 20; // TODO: what range?
 
-			physComp.getWorld()->QueryAABB(&queryCallbackLarge, b2AABB{
-				{pos.x - rangeLarge, pos.y - rangeLarge},
-				{pos.x + rangeLarge, pos.y + rangeLarge},
-			});
+			neighborResults.clear();
+			for (const auto ent : index.queryOverlap(pos - rangeLarge, pos + rangeLarge, {}, neighborResults)) {
+				if (ecsNetComp.neighbors.contains(ent)) {
+					ecsNetComp.neighbors.get(ent).state = ECSNetworkingComponent::NeighborState::Current;
+				}
+			}
 
-			physComp.getWorld()->QueryAABB(&queryCallbackSmall, b2AABB{
-				{pos.x - rangeSmall, pos.y - rangeSmall},
-				{pos.x + rangeSmall, pos.y + rangeSmall},
-			});
+			for (const auto ent : index.queryOverlap(pos - rangeSmall, pos + rangeSmall, networked, neighborResults)) {
+				if (!ecsNetComp.neighbors.contains(ent) && ent != ply) {
+					ecsNetComp.neighbors.add(ent, ECSNetworkingComponent::NeighborState::Added);
+				}
+			}
 		}
 	}
 }
@@ -0,0 +1,98 @@
+// STD
+#include <algorithm>
+#include <cstdlib>
+
+// Engine
+#include <Engine/Glue/Box2D.hpp>
+#include <Engine/Glue/glm.hpp>
+
+// Game
+#include <Game/World.hpp>
+#include <Game/systems/LagCompensationSystem.hpp>
+
+
+namespace Game {
+	LagCompensationSystem::LagCompensationSystem(SystemArg arg)
+		: System{arg} {
+		static_assert(maxRewind < tickrate, "Rewinding further than the snapshot history is kept is not possible.");
+	}
+
+	void LagCompensationSystem::preTick() {
+		if constexpr (!ENGINE_SERVER) { return; }
+
+		if (fallbacks) {
+			ENGINE_WARN("LagCompensationSystem - ", fallbacks, " queries exceeded the build budget on tick ", world.getTick() - 1);
+		}
+
+		spent = {};
+		fallbacks = 0;
+	}
+
+	Engine::ECS::Tick LagCompensationSystem::getViewTick(Engine::ECS::Entity ent) const {
+		const auto& actComp = world.getComponent<ActionComponent>(ent);
+
+		// A client always views at least one tick behind since it has to receive the tick first
+		const int32 delay = actComp.valid() ? std::clamp<int32>(actComp.getViewDelay(), 1, maxRewind) : 1;
+		return world.getTick() - delay;
+	}
+
+	std::span<const Engine::ECS::Entity> LagCompensationSystem::queryRadius(
+		const Engine::ECS::Tick viewTick,
+		const glm::vec2 center,
+		const float32 radius,
+		const Engine::ECS::ComponentBitset& with,
+		Engine::ECS::SpatialIndex::Results& out) {
+		return getIndex(viewTick).queryRadius(center, radius, with, out);
+	}
+
+	const Engine::ECS::SpatialIndex& LagCompensationSystem::getIndex(const Engine::ECS::Tick viewTick) {
+		// The snapshot for a tick holds the state at the end of the tick before it
+		const auto snapTick = viewTick + 1;
+		auto& frame = frames[snapTick % frames.size()];
+
+		// The server never rolls back so once built an index is valid for as long as its tick is in the history
+		if (frame.valid && frame.tick == snapTick) { return frame.index; }
+
+		if (spent < budget) {
+			const auto start = Engine::Clock::now();
+			const auto built = build(frame, snapTick);
+			spent += Engine::Clock::now() - start;
+			if (built) { return frame.index; }
+		}
+
+		++fallbacks;
+
+		const Frame* best = nullptr;
+		for (const auto& other : frames) {
+			if (!other.valid) { continue; }
+			const auto diff = static_cast<int32>(other.tick - snapTick);
+			if (!best || std::abs(diff) < std::abs(static_cast<int32>(best->tick - snapTick))) {
+				best = &other;
+			}
+		}
+
+		// Also checked against maxRewind so an index for a tick that has left the history is not used
+		if (best && std::abs(static_cast<int32>(best->tick - snapTick)) <= maxRewind) {
+			return best->index;
+		}
+
+		return world.getSystem<SpatialSystem>().getBodyIndex();
+	}
+
+	bool LagCompensationSystem::build(Frame& frame, const Engine::ECS::Tick snapTick) {
+		frame.valid = false;
+		frame.index.clear();
+
+		const auto found = world.forEachComponentState<PhysicsBodyComponent>(snapTick, [&](const Engine::ECS::Entity ent, const auto& state){
+			if (!world.isAlive(ent)) { return; }
+			frame.index.insert(ent, Engine::Glue::as<glm::vec2>(state.trans.p), world.getComponentsBitset(ent));
+		});
+
+		if (!found) { return false; }
+
+		frame.index.build();
+		frame.tick = snapTick;
+		frame.valid = true;
+		return true;
+	}
+}
@@ -1,3 +1,7 @@
+// STD
+#include <algorithm>
+#include <filesystem>
+
 // GLM
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -16,19 +20,55 @@ namespace {
 		Game::PhysicsBodyComponent,
 		Game::ConnectionComponent
 	>;
+
+	constexpr const char* treeTexturePaths[] = {
+		"assets/tree1.png",
+		"assets/tree2.png",
+		"assets/tree3.png",
+	};
+
+	/**
+	 * Calls `func(pos)` for each position in the inclusive box [minA, maxA] that is not in [minB, maxB].
+	 */
+	template<class Func>
+	void forEachBoxDifference(const glm::ivec2 minA, const glm::ivec2 maxA, const glm::ivec2 minB, const glm::ivec2 maxB, Func&& func) {
+		for (glm::ivec2 pos = minA; pos.y <= maxA.y; ++pos.y) {
+			if (pos.y < minB.y || pos.y > maxB.y) {
+				for (pos.x = minA.x; pos.x <= maxA.x; ++pos.x) { func(pos); }
+			} else {
+				for (pos.x = minA.x; pos.x <= std::min(maxA.x, minB.x - 1); ++pos.x) { func(pos); }
+				for (pos.x = std::max(minA.x, maxB.x + 1); pos.x <= maxA.x; ++pos.x) { func(pos); }
+			}
+		}
+	}
 }
 
 
-#define BUILD_BLOCK_ENTITY(Type) template<> Engine::ECS::Entity MapSystem::buildBlockEntity<BlockEntityType::Type>(const BlockEntityDesc& desc)
+#define PREPARE_BLOCK_ENTITY(Type) template<> void MapSystem::prepareBlockEntity<BlockEntityType::Type>(const BlockEntityDesc& desc, PreparedBlockEntity& prep)
+#define BUILD_BLOCK_ENTITY(Type) template<> Engine::ECS::Entity MapSystem::buildBlockEntity<BlockEntityType::Type>(const BlockEntityDesc& desc, const PreparedBlockEntity& prep)
 #define STORE_BLOCK_ENTITY(Type) template<> void MapSystem::storeBlockEntity<BlockEntityType::Type>(BlockEntityTypeData<BlockEntityType::Type>& data, const Engine::ECS::Entity ent)
 
 namespace Game {
+	PREPARE_BLOCK_ENTITY(None) {
+	}
+
 	BUILD_BLOCK_ENTITY(None) {
 		return Engine::ECS::INVALID_ENTITY;
 	}
 
 	STORE_BLOCK_ENTITY(None) {
-		ENGINE_WARN("TODO: Store None"); // TODO: impl
+	}
+
+	PREPARE_BLOCK_ENTITY(Tree) {
+		int32 texIdx = desc.data.asTree.type;
+		if (texIdx >= std::size(treeTexturePaths)) {
+			ENGINE_WARN("Attempting to create tree with invalid type.");
+			texIdx = 0;
+		}
+		prep.texture = static_cast<uint8>(texIdx);
+
+		prep.halfSize = 0.5f * MapChunk::blockSize * glm::vec2{desc.data.asTree.size};
+		prep.center = {0.5f * MapChunk::blockSize, prep.halfSize.y};
 	}
 
 	BUILD_BLOCK_ENTITY(Tree) {
@@ -45,21 +85,9 @@ namespace Game {
 		const auto ent = world.createEntity();
 
 		world.addComponent<NetworkedFlag>(ent);
-		
-		constexpr const char* texStr[] = {
-			"assets/tree1.png",
-			"assets/tree2.png",
-			"assets/tree3.png",
-		};
-
-		int texIdx = desc.data.asTree.type;
-		if (texIdx >= std::size(texStr)) {
-			ENGINE_WARN("Attempting to create tree with invalid type.");
-			texIdx = 0;
-		}
 
 		auto& spriteComp = world.addComponent<SpriteComponent>(ent);
-		spriteComp.texture = engine.textureManager.get(texStr[texIdx]);
+		spriteComp.texture = treeTextures[prep.texture];
 		spriteComp.layer = RenderLayer::Background;
 		//spriteComp.texture = engine.textureManager.get("assets/large_sprite_test.png");
 		{
@@ -77,8 +105,7 @@ namespace Game {
 			b2Body* body = physSys.createBody(ent, bodyDef);
 
 			b2PolygonShape shape;
-			const b2Vec2 tsize = 0.5f * MapChunk::blockSize * Engine::Glue::as<b2Vec2>(desc.data.asTree.size);
-			shape.SetAsBox(tsize.x, tsize.y, {0.5f * MapChunk::blockSize, tsize.y}, 0);
+			shape.SetAsBox(prep.halfSize.x, prep.halfSize.y, Engine::Glue::as<b2Vec2>(prep.center), 0);
 			fixtureDef.shape = &shape;
 			body->CreateFixture(&fixtureDef);
 
@@ -92,9 +119,10 @@ namespace Game {
 	}
 
 	STORE_BLOCK_ENTITY(Tree) {
-		ENGINE_WARN("TODO: Store Tree"); // TODO: impl
-		data.type = 1;
-		data.size = {1,20};
+		// Trees don't change after they are built. Their data is already in BlockEntityComponent.
+	}
+
+	PREPARE_BLOCK_ENTITY(Portal) {
 	}
 
 	BUILD_BLOCK_ENTITY(Portal) {
@@ -102,11 +130,11 @@ namespace Game {
 	}
 
 	STORE_BLOCK_ENTITY(Portal) {
-		ENGINE_WARN("TODO: Store Portal"); // TODO: impl
 	}
 }
 
 
+#undef PREPARE_BLOCK_ENTITY
 #undef BUILD_BLOCK_ENTITY
 #undef STORE_BLOCK_ENTITY
 
@@ -134,6 +162,11 @@ namespace Game {
 		mapEntity = world.createEntity();
 		shader = engine.shaderManager.get("shaders/terrain");
 
+		static_assert(std::size(treeTexturePaths) == std::extent_v<decltype(treeTextures)>);
+		for (int32 i = 0; auto path : treeTexturePaths) {
+			treeTextures[i++] = engine.textureManager.get(path);
+		}
+
 		constexpr int32 offset = 2; // offset by 2 to skip None and Air
 		const char* textures[BlockId::_COUNT - offset] = {};
 		for (int32 i = offset; i < BlockId::_COUNT; ++i) {
@@ -175,6 +208,18 @@ namespace Game {
 	void MapSystem::tick() {
 		const auto currTick = world.getTick();
 
+		// Count finished chunks so we know when regions are safe to unload
+		completedChunks.popAll(completedTemp);
+		for (const auto chunkPos : completedTemp) {
+			const auto found = regions.find(chunkToRegion(chunkPos));
+			if (found == regions.end()) [[unlikely]] {
+				ENGINE_WARN("Completed chunk for unknown region.");
+				continue;
+			}
+			++found->second->completedCount;
+		}
+		completedTemp.clear();
+
 		// TODO: move
 		const auto makeEdit = [&](BlockId bid, const glm::vec2 mouse) {
 			for (int x = -2; x < 3; ++x) {
@@ -188,6 +233,7 @@ namespace Game {
 		};
 
 		for (auto& ply : world.getFilter<PlayerFilter>()) {
+			if (!world.isRollbackAffected(ply)) { continue; }
 			const auto& actComp = world.getComponent<ActionComponent>(ply);
 
 			if (actComp.getButton(Button::Attack1).latest) {
@@ -206,24 +252,43 @@ namespace Game {
 			}
 		}
 
+		if constexpr (ENGINE_SERVER) {
+			if (!world.isPerformingRollback()) {
+				buildQueuedBlockEntities();
+			}
+		}
+
 		// Apply edits
-		for (auto& [chunkPos, edit] : chunkEdits) {
+		for (auto it = chunkEdits.begin(); it != chunkEdits.end();) {
+			// Edits are kept between ticks so continuous edits can reuse their storage
+			if (it->second.empty()) {
+				it = chunkEdits.erase(it);
+				continue;
+			}
+
+			const auto& [chunkPos, edit] = *it;
+			++it;
+
 			const auto regionPos = chunkToRegion(chunkPos);
 			const auto regionIt = regions.find(regionPos);
-			if (regionIt == regions.end() || regionIt->second->loading()) [[unlikely]] {
+			const auto chunkIndex = chunkToRegionIndex(chunkPos);
+			if (regionIt == regions.end() || !regionIt->second->isReady(chunkIndex)) [[unlikely]] {
 				// I think we could hit this if we get a chunk from the network before we have that area loaded on the client.
 				// TODO: Would it be better to just have it load that area here instead of trying to pre-load on the client?
 				ENGINE_WARN("Attempting to edit unloaded chunk/region");
 				continue;
 			}
 
-			const auto chunkIndex = chunkToRegionIndex(chunkPos);
 			auto& chunk = regionIt->second->data[chunkIndex.x][chunkIndex.y].chunk;
 
 			if (chunk.apply(edit)) {
+				regionIt->second->modified = true;
 				const auto found = activeChunks.find(chunkPos);
 				if (found != activeChunks.end()) {
-					found->second.updated = currTick;
+					markChunkUpdated(chunkPos, found->second, currTick);
+				} else if (const auto warm = warmChunks.find(chunkPos); warm != warmChunks.end()) {
+					releaseChunkData(warm->second);
+					warmChunks.erase(warm);
 				}
 			}
 		}
@@ -234,7 +299,9 @@ namespace Game {
 			}
 		}
 
-		chunkEdits.clear();
+		for (auto& [chunkPos, edit] : chunkEdits) {
+			edit.clear();
+		}
 	}
 
 	void MapSystem::chunkFromNet(Connection& from, const Engine::Net::MessageHeader& head) {
@@ -242,14 +309,129 @@ namespace Game {
 		const byte* end = begin + head.size;
 		glm::ivec2 chunkPos;
 
+		CachedChunk chunk;
+
+		if (head.size < sizeof(chunkPos) + sizeof(chunk.hash) + sizeof(chunk.codec)) {
+			ENGINE_WARN("Invalid chunk message.");
+			return;
+		}
+
 		memcpy(&chunkPos.x, begin, sizeof(chunkPos.x));
 		begin += sizeof(chunkPos.x);
 		
 		memcpy(&chunkPos.y, begin, sizeof(chunkPos.y));
 		begin += sizeof(chunkPos.y);
 
+		memcpy(&chunk.hash, begin, sizeof(chunk.hash));
+		begin += sizeof(chunk.hash);
+
+		memcpy(&chunk.codec, begin, sizeof(chunk.codec));
+		begin += sizeof(chunk.codec);
+
 		// ENGINE_INFO("Recv chunk from net: ", chunkPos.x, " ", chunkPos.y, " ", head.size);
-		chunkEdits[chunkPos].fromRLE(begin, end);
+		chunk.data.assign(begin, end);
+		if (applyChunkFromNet(chunkPos, chunk)) {
+			chunkCache.insert(chunkPos, std::move(chunk));
+		}
+	}
+
+	bool MapSystem::applyChunkFromNet(const glm::ivec2 chunkPos, const CachedChunk& cached) {
+		MapChunk::DenseData blocks;
+		const auto* data = cached.data.data();
+
+		if (cached.codec >= ChunkCodec::_COUNT || !decodeChunk(cached.codec, data, data + cached.data.size(), blocks)) {
+			ENGINE_WARN("Invalid chunk data for chunk ", chunkPos.x, " ", chunkPos.y);
+			return false;
+		}
+
+		chunkEdits[chunkPos].fromDense(blocks);
+		return true;
+	}
+
+	void MapSystem::chunkEditFromNet(Connection& from, const Engine::Net::MessageHeader& head) {
+		const byte* begin = reinterpret_cast<const byte*>(from.read(head.size));
+		const byte* end = begin + head.size;
+		glm::ivec2 chunkPos;
+
+		if (head.size < sizeof(chunkPos)) {
+			ENGINE_WARN("Invalid chunk edit message.");
+			return;
+		}
+
+		memcpy(&chunkPos.x, begin, sizeof(chunkPos.x));
+		begin += sizeof(chunkPos.x);
+
+		memcpy(&chunkPos.y, begin, sizeof(chunkPos.y));
+		begin += sizeof(chunkPos.y);
+
+		if (!chunkEdits[chunkPos].decode(begin, end)) {
+			ENGINE_WARN("Invalid chunk edit data for chunk ", chunkPos.x, " ", chunkPos.y);
+		}
+	}
+
+	void MapSystem::chunkCachedFromNet(Connection& from, const Engine::Net::MessageHeader& head) {
+		const byte* begin = reinterpret_cast<const byte*>(from.read(head.size));
+		glm::ivec2 chunkPos;
+		uint64 hash;
+
+		if (head.size != sizeof(chunkPos) + sizeof(hash)) {
+			ENGINE_WARN("Invalid cached chunk message.");
+			return;
+		}
+
+		memcpy(&chunkPos.x, begin, sizeof(chunkPos.x));
+		begin += sizeof(chunkPos.x);
+
+		memcpy(&chunkPos.y, begin, sizeof(chunkPos.y));
+		begin += sizeof(chunkPos.y);
+
+		memcpy(&hash, begin, sizeof(hash));
+
+		// Always use `find` so our use order stays in sync with the server's copy
+		if (const auto* cached = chunkCache.find(chunkPos); cached && cached->hash == hash) {
+			if (applyChunkFromNet(chunkPos, *cached)) { return; }
+		}
+
+		// Our cache has diverged from the server's. Ask for the full chunk.
+		ENGINE_WARN("Missing cached chunk ", chunkPos.x, " ", chunkPos.y);
+		chunkCache.erase(chunkPos);
+		if (auto msg = from.beginMessage<MessageType::MAP_CHUNK_REQUEST>()) {
+			msg.write(chunkPos.x);
+			msg.write(chunkPos.y);
+		} else {
+			ENGINE_WARN("Unable to begin MAP_CHUNK_REQUEST message.");
+		}
+	}
+
+	void MapSystem::chunkRequestFromNet(Connection& from, const Engine::Net::MessageHeader& head, Engine::ECS::Entity ply) {
+		const byte* begin = reinterpret_cast<const byte*>(from.read(head.size));
+		glm::ivec2 chunkPos;
+
+		if (head.size != sizeof(chunkPos)) {
+			ENGINE_WARN("Invalid chunk request message.");
+			return;
+		}
+
+		memcpy(&chunkPos.x, begin, sizeof(chunkPos.x));
+		begin += sizeof(chunkPos.x);
+
+		memcpy(&chunkPos.y, begin, sizeof(chunkPos.y));
+
+		if (!world.hasComponent<MapAreaComponent>(ply)) { return; }
+		auto& mapAreaComp = world.getComponent<MapAreaComponent>(ply);
+		mapAreaComp.cached.erase(chunkPos);
+
+		// Resend the full chunk on the next update
+		if (mapAreaComp.isSubscribed(chunkPos)) {
+			mapAreaComp.lastAt(chunkPos) = {};
+			mapAreaComp.enqueue(chunkPos);
+		}
+	}
+
+	void MapSystem::onComponentRemoved(const Engine::ECS::Entity ent, MapAreaComponent& comp) {
+		comp.forEachSubscribed([&](const glm::ivec2 chunkPos) ENGINE_INLINE {
+			unsubscribe(ent, comp, chunkPos);
+		});
 	}
 
 	void MapSystem::run(float32 dt) {
@@ -258,103 +440,100 @@ namespace Game {
 
 		for (auto ent : world.getFilter<MapAreaComponent>()) {
 			auto& mapAreaComp = world.getComponent<MapAreaComponent>(ent);
-			const auto begin = mapAreaComp.updates.begin();
-			const auto end = mapAreaComp.updates.end();
+			auto& queue = mapAreaComp.queue;
+			size_t keep = 0;
 
-			for (auto it = begin; it != end;) {
-				const auto& chunkPos = it->first;
-				auto& meta = it->second;
+			// Chunks that fail to send are kept in the queue to try again next time
+			for (size_t i = 0; i < queue.size(); ++i) {
+				const auto chunkPos = queue[i];
 
-				if (meta.tick != tick) {
-					// ENGINE_LOG("Remove: ", chunkPos.x, " ", chunkPos.y);
-					it = mapAreaComp.updates.erase(it);
-					continue;
-				}
-				
+				// Skips unsubscribed chunks and duplicate entries
+				if (!mapAreaComp.isQueued(chunkPos)) { continue; }
+				mapAreaComp.dequeue(chunkPos);
+
+				// Inactive chunks are queued again when they are activated
 				const auto found = activeChunks.find(chunkPos);
 				if (found == activeChunks.end()) { continue; }
+
 				auto& activeData = found->second;
+				auto& last = mapAreaComp.lastAt(chunkPos);
 
-				if (meta.last != activeData.updated) {
-					if (meta.last == 0) { // Fresh chunk
+				if (last != activeData.updated) {
+					if (last == 0) { // Fresh chunk
 						auto& connComp = world.getComponent<ConnectionComponent>(ent);
 						auto& conn = *connComp.conn;
 
 						const auto regionPos = chunkToRegion(chunkPos);
 						const auto regionIt = regions.find(regionPos);
-						if (regionIt != regions.end() && !regionIt->second->loading()) {
-							const auto chunkIndex = chunkToRegionIndex(chunkPos);
+						const auto chunkIndex = chunkToRegionIndex(chunkPos);
+						if (regionIt != regions.end() && regionIt->second->isReady(chunkIndex)) {
 							auto& chunkInfo = regionIt->second->data[chunkIndex.x][chunkIndex.y];
-							rleTemp.clear();
-							chunkInfo.chunk.toRLE(rleTemp);
-							
-							if (auto msg = conn.beginMessage<MessageType::MAP_CHUNK>()) {
-								meta.last = activeData.updated;
-								const auto size = static_cast<int32>(rleTemp.size() * sizeof(rleTemp[0]));
-								byte* data = reinterpret_cast<byte*>(rleTemp.data());
-								memcpy(data, &chunkPos.x, sizeof(chunkPos.x));
-								memcpy(data + sizeof(chunkPos.x), &chunkPos.y, sizeof(chunkPos.y));
-								msg.writeBlob(data, size);
-								//ENGINE_INFO("Send Chunk (fresh): ", tick, " ", chunkPos.x, " ", chunkPos.y, " ", size);
+
+							updateChunkEncoding(activeData, chunkPos, chunkInfo.chunk, false);
+
+							if (const auto* cached = mapAreaComp.cached.peek(chunkPos); cached && *cached == activeData.hash) {
+								// The client already has this version of the chunk
+								if (auto msg = conn.beginMessage<MessageType::MAP_CHUNK_CACHED>()) {
+									last = activeData.updated;
+									mapAreaComp.cached.find(chunkPos);
+
+									byte data[sizeof(chunkPos) + sizeof(activeData.hash)];
+									memcpy(data, &chunkPos.x, sizeof(chunkPos.x));
+									memcpy(data + sizeof(chunkPos.x), &chunkPos.y, sizeof(chunkPos.y));
+									memcpy(data + sizeof(chunkPos), &activeData.hash, sizeof(activeData.hash));
+									msg.writeBlob(data, sizeof(data));
+									//ENGINE_INFO("Send Chunk (cached): ", tick, " ", chunkPos.x, " ", chunkPos.y);
+								} else {
+									//ENGINE_WARN("Unable to begin MAP_CHUNK_CACHED message.");
+								}
 							} else {
-								//ENGINE_WARN("Unable to begin MAP_CHUNK message.");
+								updateChunkEncoding(activeData, chunkPos, chunkInfo.chunk, true);
+
+								if (auto msg = conn.beginMessage<MessageType::MAP_CHUNK>()) {
+									last = activeData.updated;
+									mapAreaComp.cached.insert(chunkPos, activeData.hash);
+
+									msg.writeBlob(activeData.encoded);
+									//ENGINE_INFO("Send Chunk (fresh): ", tick, " ", chunkPos.x, " ", chunkPos.y, " ", activeData.encoded->size());
+								} else {
+									//ENGINE_WARN("Unable to begin MAP_CHUNK message.");
+								}
 							}
 						}
-					} else if (activeData.rle.empty()) {
+					} else if (activeData.edits.empty()) {
 						// TODO: i dont think this case should be hit?
-						ENGINE_WARN("No RLE data for chunk");
+						ENGINE_WARN("No edit data for chunk");
+						last = {}; // Send the full chunk instead
 					} else { // Chunk edit
 						auto& connComp = world.getComponent<ConnectionComponent>(ent);
 						auto& conn = *connComp.conn;
-						if (auto msg = conn.beginMessage<MessageType::MAP_CHUNK>()) {
-							meta.last = activeData.updated;
-							const auto size = static_cast<int32>(activeData.rle.size() * sizeof(activeData.rle[0]));
-							byte* data = reinterpret_cast<byte*>(activeData.rle.data());
+						if (auto msg = conn.beginMessage<MessageType::MAP_EDIT>()) {
+							last = activeData.updated;
+							const auto size = static_cast<int32>(activeData.edits.size() * sizeof(activeData.edits[0]));
+							byte* data = reinterpret_cast<byte*>(activeData.edits.data());
 							memcpy(data, &chunkPos.x, sizeof(chunkPos.x));
 							memcpy(data + sizeof(chunkPos.x), &chunkPos.y, sizeof(chunkPos.y));
 							msg.writeBlob(data, size);
 							//ENGINE_INFO("Send Chunk (edit): ", tick, " ", chunkPos.x, " ", chunkPos.y, " ", size);
 						} else {
-							//ENGINE_WARN("Unable to begin MAP_CHUNK message.");
+							//ENGINE_WARN("Unable to begin MAP_EDIT message.");
 						}
 					}
 				}
 
-				++it;
+				if (last != activeData.updated) {
+					mapAreaComp.markQueued(chunkPos);
+					queue[keep++] = chunkPos;
+				}
 			}
+
+			queue.resize(keep);
 		}
 
-		// Unload active chunks
+		// Deactivate chunks
 		for (auto it = activeChunks.begin(); it != activeChunks.end();) {
 			if (it->second.lastUsed < timeout) {
-				// ENGINE_LOG("Unloading chunk: ", it->first.x, ", ", it->first.y);
-
-				// Store block entities
-				if constexpr (ENGINE_SERVER) {
-					const auto regionPos = chunkToRegion(it->first);
-					const auto regionIt = regions.find(regionPos);
-					if (regionIt == regions.end() || regionIt->second->loading()) {
-						ENGINE_WARN("Attempting to unload a active chunk into unloaded region.");
-					} else {
-						auto& region = *regionIt->second;
-						const auto chunkIndex = chunkToRegionIndex(it->first);
-						auto& chunkData = region.data[chunkIndex.x][chunkIndex.y];
-						chunkData.entData.clear();
-
-						for (const auto ent : it->second.blockEntities) {
-							auto& desc = chunkData.entData.emplace_back();
-							const auto& beComp = world.getComponent<BlockEntityComponent>(ent);
-							desc.data.type = beComp.type;
-							desc.pos = beComp.block;
-							desc.data.with([&]<auto Type>(auto& data){
-								storeBlockEntity<Type>(data, ent);
-							});
-							world.deferedDestroyEntity(ent);
-						}
-					}
-				}
-
-				world.getSystem<PhysicsSystem>().destroyBody(it->second.body);
+				deactivateChunk(it->first, it->second);
 				it = activeChunks.erase(it);
 			} else {
 				++it;
@@ -365,6 +544,19 @@ namespace Game {
 		for (auto it = regions.begin(); it != regions.end();) {
 			if (it->second->lastUsed < timeout && !it->second->loading()) {
 				ENGINE_LOG("Unloading region: ", it->first.x, ", ", it->first.y);
+				unloadRegion(it->first, *it->second);
+
+				// Warm chunks are only valid while their region is loaded
+				const auto regionStart = regionToChunk(it->first);
+				for (glm::ivec2 chunkPos = regionStart; chunkPos.x < regionStart.x + regionSize.x; ++chunkPos.x) {
+					for (chunkPos.y = regionStart.y; chunkPos.y < regionStart.y + regionSize.y; ++chunkPos.y) {
+						if (const auto warm = warmChunks.find(chunkPos); warm != warmChunks.end()) {
+							releaseChunkData(warm->second);
+							warmChunks.erase(warm);
+						}
+					}
+				}
+
 				it = regions.erase(it);
 			} else {
 				++it;
@@ -379,19 +571,16 @@ namespace Game {
 		const auto tick = world.getTick();
 		const auto plyPos = Engine::Glue::as<glm::vec2>(world.getComponent<PhysicsBodyComponent>(ply).getPosition());
 		const auto blockPos = worldToBlock(plyPos);
+		const auto plyChunk = blockToChunk(blockPos);
 
-		// How large of an area to load around the chunk blockPos is in.
-		constexpr auto areaSize = glm::ivec2{5, 5};
-
-		// How large of a buffer around areaSize to wait befor unloading areas.
-		// We want a larger unload area so that we arent constantly loading/unloading
-		// when a player is near a chunk border
-		constexpr auto buffSize = glm::ivec2{7, 7};
+		const auto minAreaChunk = plyChunk - playAreaSize;
+		const auto maxAreaChunk = plyChunk + playAreaSize;
+		const auto minBuffChunk = minAreaChunk - playBufferSize;
+		const auto maxBuffChunk = maxAreaChunk + playBufferSize;
 
-		const auto minAreaChunk = blockToChunk(blockPos) - areaSize;
-		const auto maxAreaChunk = blockToChunk(blockPos) + areaSize;
-		const auto minBuffChunk = minAreaChunk - buffSize;
-		const auto maxBuffChunk = maxAreaChunk + buffSize;
+		#if ENGINE_SERVER
+			updateSubscriptions(ply, mapAreaComp, plyChunk);
+		#endif
 
 		for (auto chunkPos = minBuffChunk; chunkPos.x <= maxBuffChunk.x; ++chunkPos.x) {
 			for (chunkPos.y = minBuffChunk.y; chunkPos.y <= maxBuffChunk.y; ++chunkPos.y) {
@@ -424,48 +613,39 @@ namespace Game {
 				}
 
 				const auto& region = regionIt->second;
-				if (region->loading()) { continue; }
 				region->lastUsed = world.getTickTime();
 
-				#if ENGINE_SERVER
-				{
-					const auto found = mapAreaComp.updates.contains(chunkPos);
-					if (!isBufferChunk || found) {
-						mapAreaComp.updates[chunkPos].tick = tick;
-					}
-				}
-				#endif
-				
+				const auto chunkIndex = chunkToRegionIndex(chunkPos);
+				if (!region->isReady(chunkIndex)) { continue; }
+
 				auto it = activeChunks.find(chunkPos);
 				if (it == activeChunks.end()) {
 					if (isBufferChunk) { continue; }
-					it = activeChunks.emplace(chunkPos, TestData{}).first;
-					it->second.body = createBody();
-					setupMesh(it->second.mesh);
 
-					const auto chunkIndex = chunkToRegionIndex(chunkPos);
-					auto& chunkInfo = region->data[chunkIndex.x][chunkIndex.y];
+					// Reuse the built body and mesh if we have them
+					const auto warm = warmChunks.find(chunkPos);
+					const bool isWarm = warm != warmChunks.end();
+					if (isWarm) {
+						it = activeChunks.emplace(chunkPos, std::move(warm->second)).first;
+						warmChunks.erase(warm);
+					} else {
+						it = activeChunks.emplace(chunkPos, acquireChunkData()).first;
+					}
+					it->second.body->SetActive(true);
 
 					if constexpr (ENGINE_SERVER) {
-						for (const auto& desc : chunkInfo.entData) {
-							Engine::ECS::Entity ent;
-
-							desc.data.with([&]<auto Type>(auto& data) ENGINE_INLINE {
-								ent = buildBlockEntity<Type>(desc);
-								if (ent != Engine::ECS::INVALID_ENTITY) {
-									auto& beComp = world.addComponent<BlockEntityComponent>(ent);
-									beComp.type = desc.data.type;
-									beComp.block = desc.pos;
-									it->second.blockEntities.push_back(ent);
-								} else {
-									ENGINE_WARN("Attempting to create invalid block entity.");
-								}
-							});
+						const auto& chunkInfo = region->data[chunkIndex.x][chunkIndex.y];
+						if (!chunkInfo.entData.empty()) {
+							blockEntityQueue.push_back(chunkPos);
 						}
 					}
 
 					// ENGINE_LOG("Activating chunk: ", chunkPos.x, ", ", chunkPos.y, " (", (it->second.updated == tick) ? "fresh" : "stale", ")");
-					it->second.updated = tick;
+					if (isWarm) {
+						queueReactivatedChunk(chunkPos, it->second);
+					} else {
+						markChunkUpdated(chunkPos, it->second, tick);
+					}
 				}
 				
 				it->second.lastUsed = world.getTickTime();
@@ -489,7 +669,7 @@ namespace Game {
 		const auto chunkPos = blockToChunk(getBlockOffset()) + chunkOffset;
 
 		auto& edit = chunkEdits[chunkPos];
-		edit.data[blockIndex.x][blockIndex.y] = bid;
+		edit.set(blockIndex, bid);
 	}
 	
 	glm::ivec2 MapSystem::worldToBlock(const glm::vec2 world) const {
@@ -501,57 +681,221 @@ namespace Game {
 		return glm::vec2{block - getBlockOffset()} * MapChunk::blockSize;
 	}
 
+	void MapSystem::markChunkUpdated(const glm::ivec2 chunkPos, TestData& data, const Engine::ECS::Tick tick) {
+		data.updated = tick;
+
+		const auto found = subscribers.find(chunkPos);
+		if (found == subscribers.end()) { return; }
+
+		for (const auto ply : found->second) {
+			world.getComponent<MapAreaComponent>(ply).enqueue(chunkPos);
+		}
+	}
+
+	void MapSystem::queueReactivatedChunk(const glm::ivec2 chunkPos, const TestData& data) {
+		const auto found = subscribers.find(chunkPos);
+		if (found == subscribers.end()) { return; }
+
+		for (const auto ply : found->second) {
+			auto& mapAreaComp = world.getComponent<MapAreaComponent>(ply);
+			auto& last = mapAreaComp.lastAt(chunkPos);
+			if (last == data.updated) { continue; }
+
+			// The edits only cover the latest update so anything older needs the full chunk
+			last = {};
+			mapAreaComp.enqueue(chunkPos);
+		}
+	}
+
+	void MapSystem::updateSubscriptions(Engine::ECS::Entity ply, MapAreaComponent& mapAreaComp, const glm::ivec2 center) {
+		constexpr auto buffSize = playAreaSize + playBufferSize;
+
+		if (!mapAreaComp.centered) {
+			mapAreaComp.center = center;
+			mapAreaComp.centered = true;
+			for (auto chunkPos = center - playAreaSize; chunkPos.x <= center.x + playAreaSize.x; ++chunkPos.x) {
+				for (chunkPos.y = center.y - playAreaSize.y; chunkPos.y <= center.y + playAreaSize.y; ++chunkPos.y) {
+					subscribe(ply, mapAreaComp, chunkPos);
+				}
+			}
+			return;
+		}
+
+		const auto prev = mapAreaComp.center;
+		if (prev == center) { return; }
+
+		// Only chunks in the previous buffer area can be subscribed
+		forEachBoxDifference(prev - buffSize, prev + buffSize, center - buffSize, center + buffSize, [&](const glm::ivec2 chunkPos) ENGINE_INLINE {
+			if (mapAreaComp.isSubscribed(chunkPos)) {
+				unsubscribe(ply, mapAreaComp, chunkPos);
+			}
+		});
+
+		mapAreaComp.center = center;
+
+		// Chunks in the previous play area are already subscribed
+		forEachBoxDifference(center - playAreaSize, center + playAreaSize, prev - playAreaSize, prev + playAreaSize, [&](const glm::ivec2 chunkPos) ENGINE_INLINE {
+			if (!mapAreaComp.isSubscribed(chunkPos)) {
+				subscribe(ply, mapAreaComp, chunkPos);
+			}
+		});
+	}
+
+	void MapSystem::subscribe(Engine::ECS::Entity ply, MapAreaComponent& mapAreaComp, const glm::ivec2 chunkPos) {
+		mapAreaComp.subscribe(chunkPos);
+		subscribers[chunkPos].push_back(ply);
+	}
+
+	void MapSystem::unsubscribe(Engine::ECS::Entity ply, MapAreaComponent& mapAreaComp, const glm::ivec2 chunkPos) {
+		mapAreaComp.unsubscribe(chunkPos);
+
+		const auto found = subscribers.find(chunkPos);
+		if (found == subscribers.end()) { return; }
+
+		auto& subs = found->second;
+		const auto it = std::find(subs.begin(), subs.end(), ply);
+		if (it != subs.end()) {
+			*it = subs.back();
+			subs.pop_back();
+		}
+
+		if (subs.empty()) { subscribers.erase(found); }
+	}
+
+	void MapSystem::updateChunkEncoding(TestData& data, const glm::ivec2 chunkPos, const MapChunk& chunk, const bool full) {
+		if (data.hashed != data.updated) {
+			data.hash = chunk.hash();
+			data.hashed = data.updated;
+		}
+
+		if (!full || data.encodedTick == data.updated) { return; }
+		data.encodedTick = data.updated;
+
+		// Chunk position, hash, codec, then the encoded blocks
+		auto encoded = std::make_shared<std::vector<byte>>(sizeof(chunkPos) + sizeof(data.hash) + sizeof(chunkCodec));
+		byte* head = encoded->data();
+		memcpy(head, &chunkPos.x, sizeof(chunkPos.x));
+		memcpy(head + sizeof(chunkPos.x), &chunkPos.y, sizeof(chunkPos.y));
+		memcpy(head + sizeof(chunkPos), &data.hash, sizeof(data.hash));
+		memcpy(head + sizeof(chunkPos) + sizeof(data.hash), &chunkCodec, sizeof(chunkCodec));
+
+		MapChunk::DenseData blocks;
+		chunk.toDense(blocks);
+		encodeChunk(chunkCodec, blocks, *encoded);
+		data.encoded = std::move(encoded);
+	}
+
+	MapSystem::TestData MapSystem::acquireChunkData() {
+		if (chunkDataPool.empty()) {
+			TestData data;
+			data.body = createBody();
+			data.body->SetActive(false);
+			setupMesh(data.mesh);
+			return data;
+		}
+
+		TestData data = std::move(chunkDataPool.back());
+		chunkDataPool.pop_back();
+		return data;
+	}
+
+	void MapSystem::releaseChunkData(TestData& data) {
+		ENGINE_DEBUG_ASSERT(data.blockEntities.empty(), "Attempting to release chunk data with block entities.");
+		auto& body = *data.body;
+		world.getSystem<PhysicsSystem>().destroyFixtures(body);
+		body.SetActive(false);
+
+		// Keep the mesh and vector storage. The mesh is rebuilt before it is drawn.
+		data.updated = {};
+		data.edits.clear();
+		data.hash = 0;
+		data.hashed = {};
+		data.encoded.reset();
+		data.encodedTick = {};
+		data.entDataBuilt = 0;
+		chunkDataPool.push_back(std::move(data));
+	}
+
+	void MapSystem::deactivateChunk(const glm::ivec2 chunkPos, TestData& data) {
+		// ENGINE_LOG("Deactivating chunk: ", chunkPos.x, ", ", chunkPos.y);
+		const auto regionPos = chunkToRegion(chunkPos);
+		const auto regionIt = regions.find(regionPos);
+		const auto chunkIndex = chunkToRegionIndex(chunkPos);
+		const bool ready = regionIt != regions.end() && regionIt->second->isReady(chunkIndex);
+
+		// Store block entities
+		if constexpr (ENGINE_SERVER) {
+			if (!ready) {
+				ENGINE_WARN("Attempting to unload a active chunk into unloaded region.");
+				for (const auto ent : data.blockEntities) {
+					world.deferedDestroyEntity(ent);
+				}
+				data.blockEntities.clear();
+				releaseChunkData(data);
+				return;
+			}
+
+			auto& region = *regionIt->second;
+			auto& chunkData = region.data[chunkIndex.x][chunkIndex.y];
+
+			// Entries that were never built are kept as is
+			chunkData.entData.erase(chunkData.entData.begin(), chunkData.entData.begin() + data.entDataBuilt);
+			region.modified = region.modified || !data.blockEntities.empty();
+
+			for (const auto ent : data.blockEntities) {
+				auto& desc = chunkData.entData.emplace_back();
+				const auto& beComp = world.getComponent<BlockEntityComponent>(ent);
+				desc.pos = beComp.block;
+				desc.data = beComp.data;
+				desc.data.with([&]<auto Type>(auto& beData){
+					storeBlockEntity<Type>(beData, ent);
+				});
+				world.deferedDestroyEntity(ent);
+			}
+			data.blockEntities.clear();
+			prepareBlockEntities(chunkData);
+		}
+
+		// Edits only ever add palette entries. Drop the unused ones while the chunk is idle.
+		if (ready) {
+			regionIt->second->data[chunkIndex.x][chunkIndex.y].chunk.compact();
+		}
+
+		data.entDataBuilt = 0;
+		data.body->SetActive(false);
+
+		if (warmChunks.size() >= warmChunkLimit) {
+			auto oldest = warmChunks.begin();
+			for (auto it = oldest; it != warmChunks.end(); ++it) {
+				if (it->second.lastUsed < oldest->second.lastUsed) { oldest = it; }
+			}
+			releaseChunkData(oldest->second);
+			warmChunks.erase(oldest);
+		}
+
+		warmChunks.emplace(chunkPos, std::move(data));
+	}
+
 	// TODO: thread this. Not sure how nice box2d will play with it.
 	void MapSystem::buildActiveChunkData(TestData& data, glm::ivec2 chunkPos) {
 		const auto regionPos = chunkToRegion(chunkPos);
 		const auto regionIt = regions.find(regionPos);
-		if (regionIt == regions.end() || regionIt->second->loading()) [[unlikely]] { return; }
-				
 		const auto chunkIndex = chunkToRegionIndex(chunkPos);
+		if (regionIt == regions.end() || !regionIt->second->isReady(chunkIndex)) [[unlikely]] { return; }
+
 		auto& chunkInfo = regionIt->second->data[chunkIndex.x][chunkIndex.y];
 
 		if constexpr (ENGINE_SERVER) { // Build edits
 			const auto found = chunkEdits.find(chunkPos);
-			if (found == chunkEdits.end()) {
-				data.rle.clear();
+			if (found == chunkEdits.end() || found->second.empty()) {
+				data.edits.clear();
 			} else {
-				found->second.toRLE(data.rle);
+				found->second.encode(data.edits);
 			}
 		}
 
-		decltype(auto) greedyExpand = [&chunkInfo](auto usable, auto submitArea) ENGINE_INLINE {
-			bool used[MapChunk::size.x][MapChunk::size.y] = {};
-			
-			for (glm::ivec2 begin = {0, 0}; begin.x < MapChunk::size.x; ++begin.x) {  
-				for (begin.y = 0; begin.y < MapChunk::size.y;) {
-					const auto& blockMeta = getBlockMeta(chunkInfo.chunk.data[begin.x][begin.y]);
-					auto end = begin;
-					while (end.y < MapChunk::size.y && !used[end.x][end.y] && usable(end, blockMeta)) { ++end.y; }
-					if (end.y == begin.y) { ++begin.y; continue; }
-
-					for (bool cond = true; cond;) {
-						//std::fill(&used[end.x][begin.y], &used[end.x][end.y], true);
-						memset(&used[end.x][begin.y], 1, end.y - begin.y);
-						++end.x;
-
-						if (end.x == MapChunk::size.x) { break; }
-						for (int y = begin.y; y < end.y; ++y) {
-							if (used[end.x][y] || !usable(glm::ivec2{end.x, y}, blockMeta)) { cond = false; break; }
-						}
-					}
-
-					submitArea(begin, end);
-					begin.y = end.y;
-				}
-			}
-		};
-
 		{ // Render
-			greedyExpand([&](const auto& pos, const auto& blockMeta) ENGINE_INLINE {
-				return blockMeta.id != BlockId::None
-					&& blockMeta.id != BlockId::Air
-					&& chunkInfo.chunk.data[pos.x][pos.y] == blockMeta.id;
-			}, [&](const auto& begin, const auto& end) ENGINE_INLINE {
+			chunkInfo.chunk.forEachRenderArea([&](const auto& begin, const auto& end) ENGINE_INLINE {
 				// Add buffer data
 				glm::vec2 origin = glm::vec2{begin} * MapChunk::blockSize;
 				glm::vec2 size = glm::vec2{end - begin} * MapChunk::blockSize;
@@ -560,7 +904,7 @@ namespace Game {
 				static_assert(BlockId::_COUNT <= 255,
 					"Texture index is a byte. You will need to change its type if you now have more than 255 blocks."
 				);
-				const auto tex = static_cast<GLfloat>(chunkInfo.chunk.data[begin.x][begin.y] - 2); // TODO: -2 for None and Air. Handle this better.
+				const auto tex = static_cast<GLfloat>(chunkInfo.chunk.getBlock(begin) - 2); // TODO: -2 for None and Air. Handle this better.
 				buildVBOData.push_back({.pos = origin, .tex = tex});
 				buildVBOData.push_back({.pos = origin + glm::vec2{size.x, 0}, .tex = tex});
 				buildVBOData.push_back({.pos = origin + size, .tex = tex});
@@ -586,11 +930,7 @@ namespace Game {
 
 			// TODO: Look into edge and chain shapes
 			// Clear all fixtures
-			for (auto* fixture = body.GetFixtureList(); fixture;) {
-				auto* next = fixture->GetNext();
-				body.DestroyFixture(fixture);
-				fixture = next;
-			}
+			world.getSystem<PhysicsSystem>().destroyFixtures(body);
 
 			body.SetTransform(pos, 0);
 
@@ -598,9 +938,7 @@ namespace Game {
 			b2FixtureDef fixtureDef;
 			fixtureDef.shape = &shape;
 
-			greedyExpand([&](const auto& pos, const auto& blockMeta) ENGINE_INLINE {
-				return getBlockMeta(chunkInfo.chunk.data[pos.x][pos.y]).solid;
-			}, [&](const auto& begin, const auto& end) ENGINE_INLINE {
+			chunkInfo.chunk.forEachSolidArea([&](const auto& begin, const auto& end) ENGINE_INLINE {
 				// ENGINE_LOG("Physics: (", begin.x, ", ", begin.y, ") ", "(", end.x, ", ", end.y, ")");
 				const auto halfSize = MapChunk::blockSize * 0.5f * Engine::Glue::as<b2Vec2>(end - begin);
 				const auto center = MapChunk::blockSize * Engine::Glue::as<b2Vec2>(begin) + halfSize;
@@ -613,6 +951,61 @@ namespace Game {
 	void MapSystem::loadChunk(const glm::ivec2 chunkPos, MapRegion::ChunkInfo& chunkInfo) const noexcept {
 		const auto chunkBlockPos = chunkToBlock(chunkPos);
 		mgen.init(chunkBlockPos, chunkInfo.chunk, chunkInfo.entData);
+		prepareBlockEntities(chunkInfo);
+	}
+
+	void MapSystem::prepareBlockEntities(MapRegion::ChunkInfo& chunkInfo) {
+		chunkInfo.prepared.resize(chunkInfo.entData.size());
+		for (size_t i = 0; i < chunkInfo.entData.size(); ++i) {
+			const auto& desc = chunkInfo.entData[i];
+			auto& prep = chunkInfo.prepared[i];
+			prep = {};
+			desc.data.with([&]<auto Type>(auto&) ENGINE_INLINE {
+				prepareBlockEntity<Type>(desc, prep);
+			});
+		}
+	}
+
+	void MapSystem::buildQueuedBlockEntities() {
+		int32 budget = blockEntityBuildBudget;
+		size_t done = 0;
+
+		for (; done < blockEntityQueue.size(); ++done) {
+			const auto chunkPos = blockEntityQueue[done];
+
+			// Chunks deactivated before they were built keep their unbuilt entData
+			const auto found = activeChunks.find(chunkPos);
+			if (found == activeChunks.end()) { continue; }
+			auto& data = found->second;
+
+			const auto regionIt = regions.find(chunkToRegion(chunkPos));
+			const auto chunkIndex = chunkToRegionIndex(chunkPos);
+			if (regionIt == regions.end() || !regionIt->second->isReady(chunkIndex)) [[unlikely]] { continue; }
+			const auto& chunkInfo = regionIt->second->data[chunkIndex.x][chunkIndex.y];
+			ENGINE_DEBUG_ASSERT(chunkInfo.prepared.size() == chunkInfo.entData.size(), "Block entities have not been prepared.");
+
+			for (; data.entDataBuilt < chunkInfo.entData.size() && budget > 0; ++data.entDataBuilt, --budget) {
+				const auto& desc = chunkInfo.entData[data.entDataBuilt];
+				const auto& prep = chunkInfo.prepared[data.entDataBuilt];
+
+				desc.data.with([&]<auto Type>(auto&) ENGINE_INLINE {
+					const auto ent = buildBlockEntity<Type>(desc, prep);
+					if (ent != Engine::ECS::INVALID_ENTITY) {
+						auto& beComp = world.addComponent<BlockEntityComponent>(ent);
+						beComp.block = desc.pos;
+						beComp.data = desc.data;
+						data.blockEntities.push_back(ent);
+					} else {
+						ENGINE_WARN("Attempting to create invalid block entity.");
+					}
+				});
+			}
+
+			// Out of budget. Continue from this chunk next tick.
+			if (data.entDataBuilt < chunkInfo.entData.size()) { break; }
+		}
+
+		blockEntityQueue.erase(blockEntityQueue.begin(), blockEntityQueue.begin() + done);
 	}
 
 	void MapSystem::loadChunkAsyncWorker() {
@@ -624,22 +1017,67 @@ namespace Game {
 		}
 	}
 
+	void MapSystem::unloadRegion(const glm::ivec2 regionPos, const MapRegion& region) {
+		if constexpr (!ENGINE_SERVER) { return; }
+		if (!region.modified) { return; }
+
+		// Saved in place of the pre-generated region so queueRegionToLoad picks it up. Done here rather than on a loading
+		// thread so that the file is complete before the region can be queued to load again.
+		std::error_code err;
+		std::filesystem::create_directories(MapRegion::bakeDirectory, err);
+		const auto path = MapRegion::filePath(MapRegion::bakeDirectory, regionPos);
+		if (err || !region.save(path, regionPos, seed)) {
+			ENGINE_WARN("Unable to save region. Changes will be lost: ", path);
+		}
+	}
+
 	void MapSystem::queueRegionToLoad(glm::ivec2 regionPos, MapRegion& region) {
 		std::cout << "Queue region: " << regionPos.x << " " << regionPos.y << "\n";
-		constexpr auto totalSize = MapRegion::size.x * MapRegion::size.y;
 		const auto regionStart = regionToChunk(regionPos);
 
+		// Use the pre-generated region if one exists. See MapTool.
+		if (auto path = MapRegion::filePath(MapRegion::bakeDirectory, regionPos); std::filesystem::exists(path)) {
+			chunkQueue.emplace([this, regionPos, regionStart, &region, path = std::move(path)] {
+				if (region.load(path, regionPos, seed)) {
+					for (auto& col : region.data) {
+						for (auto& chunkInfo : col) {
+							prepareBlockEntities(chunkInfo);
+						}
+					}
+				} else {
+					ENGINE_WARN("Unable to load region file. Generating instead: ", path);
+					for (int x = 0; x < regionSize.x; ++x) {
+						for (int y = 0; y < regionSize.y; ++y) {
+							// The failed load may have partially filled the entity data
+							region.data[x][y].entData.clear();
+							loadChunk(regionStart + glm::ivec2{x, y}, region.data[x][y]);
+						}
+					}
+				}
+				region.setAllReady();
+
+				auto lock = completedChunks.lock();
+				for (int x = 0; x < regionSize.x; ++x) {
+					for (int y = 0; y < regionSize.y; ++y) {
+						completedChunks.unsafeEmplace(regionStart + glm::ivec2{x, y});
+					}
+				}
+			});
+			return;
+		}
+
 		auto lock = chunkQueue.lock();
 		for (int x = 0; x < regionSize.x; ++x) {
 			for (int y = 0; y < regionSize.y; ++y) {
 				// TODO: maybe have each thred do a whole row of a region? per chunk seems to granular
 				chunkQueue.unsafeEmplace([this,
 						chunkPos = regionStart + glm::ivec2{x, y},
-						&region,
-						&chunkInfo = region.data[x][y]
+						chunkIndex = glm::ivec2{x, y},
+						&region
 					] {
-					loadChunk(chunkPos, chunkInfo);
-					++region.loadedChunks;
+					loadChunk(chunkPos, region.data[chunkIndex.x][chunkIndex.y]);
+					region.setReady(chunkIndex);
+					completedChunks.push(chunkPos);
 				});
 			}
 		}
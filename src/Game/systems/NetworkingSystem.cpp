@@ -371,7 +371,15 @@ namespace Game {
 					}
 
 					auto& state = world.getComponentState<C>(local, *tick);
-					state.netFrom(from);
+
+					if constexpr (std::same_as<C, PhysicsBodyComponent>) {
+						state.netFrom(from, world.getSystem<PhysicsOriginShiftSystem>().getOrigin());
+						if (world.hasComponent<PhysicsInterpComponent>(local)) {
+							world.getComponent<PhysicsInterpComponent>(local).confirm(*tick, state.trans);
+						}
+					} else {
+						state.netFrom(from);
+					}
 				} else {
 					world.getComponent<C>(local).netFrom(from);
 				}
@@ -406,22 +414,24 @@ namespace Game {
 	HandleMessageDef(MessageType::PLAYER_DATA)
 		ENGINE_DEBUG_ASSERT(!ENGINE_SERVER, "This message is not for the server."); // TODO: rm - debugging
 		const auto* tick = from.read<Engine::ECS::Tick>();
-		const auto* trans = from.read<b2Transform>();
+		const auto* netTrans = from.read<PhysicsBodyComponent::NetTransform>();
 		const auto* vel = from.read<b2Vec2>();
 		// TODO: angVel
 
-		if (!tick || !trans || !vel) {
+		if (!tick || !netTrans || !vel) {
 			ENGINE_WARN("Invalid PLAYER_DATA network message");
 			return;
 		}
 
+		const auto trans = netTrans->to(world.getSystem<PhysicsOriginShiftSystem>().getOrigin());
+
 		if (!world.hasComponent<PhysicsBodyComponent>(info.ent)) {
 			ENGINE_WARN("PLAYER_DATA message received for entity that has no PhysicsBodyComponent");
 			return;
 		}
 
 		auto& physCompState = world.getComponentState<PhysicsBodyComponent>(info.ent, *tick);
-		const auto diff = physCompState.trans.p - trans->p;
+		const auto diff = physCompState.trans.p - trans.p;
 		const float32 eps = 0.0001f; // TODO: figure out good eps value. Probably half the size of a pixel or similar.
 		//if (diff.LengthSquared() > 0.0001f) { // TODO: also check q
 		// TODO: why does this ever happen with only one player connected?
@@ -429,16 +439,20 @@ namespace Game {
 			ENGINE_INFO(std::setprecision(std::numeric_limits<decltype(physCompState.trans.p.x)>::max_digits10),
 				"Oh boy a mishap has occured on tick ", *tick,
 				" (<", physCompState.trans.p.x, ", ", physCompState.trans.p.y, "> - <",
-				trans->p.x, ", ", trans->p.y, "> = <",
+				trans.p.x, ", ", trans.p.y, "> = <",
 				diff.x, ", ", diff.y,
 				">)"
 			);
 
-			physCompState.trans = *trans;
+			physCompState.trans = trans;
 			physCompState.vel = *vel;
 			physCompState.rollbackOverride = true;
 
-			world.scheduleRollback(*tick);
+			if (world.hasComponent<PhysicsInterpComponent>(info.ent)) {
+				world.getComponent<PhysicsInterpComponent>(info.ent).confirm(*tick, trans);
+			}
+
+			world.scheduleRollback(*tick, info.ent);
 		}
 
 		// TODO: vel
@@ -455,13 +469,26 @@ namespace Game {
 		world.getSystem<MapSystem>().chunkFromNet(from, head);
 	}
 
+	HandleMessageDef(MessageType::MAP_EDIT)
+		world.getSystem<MapSystem>().chunkEditFromNet(from, head);
+	}
+
+	HandleMessageDef(MessageType::MAP_CHUNK_CACHED)
+		world.getSystem<MapSystem>().chunkCachedFromNet(from, head);
+	}
+
+	HandleMessageDef(MessageType::MAP_CHUNK_REQUEST)
+		world.getSystem<MapSystem>().chunkRequestFromNet(from, head, info.ent);
+	}
+
 	// TODO: unsued?
 	HandleMessageDef(MessageType::SPELL)
 		auto& spellSys = world.getSystem<CharacterSpellSystem>();
 		const auto* pos = from.read<b2Vec2>();
 		const auto* dir = from.read<b2Vec2>();
-		if (!pos || !dir) { return; }
-		spellSys.queueMissile(*pos, *dir);
+		const auto* hit = from.read<bool>();
+		if (!pos || !dir || !hit) { return; }
+		spellSys.queueMissile(*pos, *dir, *hit);
 	}
 }
 #undef HandleMessageDef
@@ -515,34 +542,50 @@ namespace Game {
 	}
 	#endif
 
+	void NetworkingSystem::recvPacket(const Engine::Net::IPv4Address& addr, const Engine::Net::Packet& pkt, int32 sz, Engine::Clock::TimePoint time) {
+		const auto& [info, conn] = getOrCreateConnection(addr);
+		// TODO: move back to connection
+		if (pkt.getProtocol() != Engine::Net::protocol) {
+			ENGINE_WARN("Invalid protocol"); // TODO: rm - could be used for lag/dos?
+			return;
+		}
+
+		if (conn.getKeyRecv() != pkt.getKey()) {
+			if (info.state == Engine::Net::ConnState::Connected) {
+				ENGINE_WARN("Invalid key for ", conn.address(), " ", pkt.getKey(), " != ", conn.getKeyRecv());
+				return;
+			}
+		}
+
+		// ENGINE_LOG("****** ", conn.getKeySend(), " ", conn.getKeyRecv(), " ", pkt.getKey(), " ", pkt.getSeqNum());
+
+		if (!conn.recv(pkt, sz, time)) { return; }
+
+		const Engine::Net::MessageHeader* hdr; 
+		while (hdr = conn.recvNext()) {
+			dispatchMessage(info, conn, hdr);
+		}
+	}
+
 	void NetworkingSystem::run(float32 dt) {
 		now = Engine::Clock::now();
 
+		if (!world.isPerformingRollback()) {
+			for (const auto& buffered : bufferedPackets) {
+				recvPacket(buffered.address, buffered.packet, buffered.size, buffered.time);
+			}
+			bufferedPackets.clear();
+		}
+
 		// Recv messages
 		int32 sz;
 		while ((sz = socket.recv(&packet, sizeof(packet), address)) > -1) {
-			const auto& [info, conn] = getOrCreateConnection(address);
-			// TODO: move back to connection
-			if (packet.getProtocol() != Engine::Net::protocol) {
-				ENGINE_WARN("Invalid protocol"); // TODO: rm - could be used for lag/dos?
+			if (world.isPerformingRollback()) {
+				bufferedPackets.push_back({address, now, sz, packet});
 				continue;
 			}
 
-			if (conn.getKeyRecv() != packet.getKey()) {
-				if (info.state == Engine::Net::ConnState::Connected) {
-					ENGINE_WARN("Invalid key for ", conn.address(), " ", packet.getKey(), " != ", conn.getKeyRecv());
-					continue;
-				}
-			}
-
-			// ENGINE_LOG("****** ", conn.getKeySend(), " ", conn.getKeyRecv(), " ", packet.getKey(), " ", packet.getSeqNum());
-
-			if (!conn.recv(packet, sz, now)) { continue; }
-
-			const Engine::Net::MessageHeader* hdr; 
-			while (hdr = conn.recvNext()) {
-				dispatchMessage(info, conn, hdr);
-			}
+			recvPacket(address, packet, sz, now);
 		}
 
 		// TODO: instead of sending all connections on every X. Send a smaller number every frame to distribute load.
@@ -6,6 +6,9 @@
 
 namespace Game {
 	void PhysicsInterpSystem::run(float32 dt) {
+		// Keep showing the last interpolated state while a rollback is spread over multiple frames
+		if (world.isPerformingRollback()) { return; }
+
 		const auto now = Engine::Clock::now();
 
 		for (const auto& ent : world.getFilter<PhysicsBodyComponent, PhysicsInterpComponent>()) {
@@ -17,6 +20,7 @@ namespace Game {
 			Engine::Clock::TimePoint interpTime;
 			const b2Transform* nextTrans = nullptr;
 			const b2Transform* prevTrans = nullptr;
+			b2Transform currTrans;
 
 			if (physComp.snap) {
 				physInterpComp.trans = physComp.getTransform();
@@ -32,7 +36,8 @@ namespace Game {
 				prevTrans = &physCompState2.trans;
 				prevTime = world.getTickTime(tick);
 
-				nextTrans = &physComp.getTransform();
+				currTrans = physComp.getTransform();
+				nextTrans = &currTrans;
 				nextTime = world.getTickTime();
 
 				interpTime = now - world.getTickInterval();
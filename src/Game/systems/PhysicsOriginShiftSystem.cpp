@@ -1,8 +1,20 @@
+// STD
+#include <cmath>
+
 // Game
 #include <Game/systems/PhysicsOriginShiftSystem.hpp>
 #include <Game/World.hpp>
 
 
+namespace {
+	/**
+	 * The number of whole shifts needed to bring @p x within @p range of the origin.
+	 */
+	ENGINE_INLINE int32 shiftSteps(const float32 x, const float32 range) noexcept {
+		return std::abs(x) > range ? static_cast<int32>(x / range) : 0;
+	}
+}
+
 namespace Game {
 	PhysicsOriginShiftSystem::PhysicsOriginShiftSystem(SystemArg arg)
 		: System{arg} {
@@ -10,42 +22,23 @@ namespace Game {
 	}
 
 	void PhysicsOriginShiftSystem::run(float32 dt) {
-		return;
+		if constexpr (!ENGINE_CLIENT) { return; }
+
+		// Stored positions are rebased when shifting so wait for any rollback to finish
+		if (world.isPerformingRollback()) { return; }
+
 		// Using last frames position shouldnt be a problem here normally.
-		// May be an issue in cases of long distance teleportation.
-		const auto& pos = engine.camera.getPosition();
-
-		if (std::abs(pos.x) > range) {
-			std::cout
-				<< "shift x "
-				<< pos.x << " "
-				<< range << "\n";
-			auto& physSys = world.getSystem<Game::PhysicsSystem>();
-			auto dir = std::copysign(1.0f, pos.x);
-
-			physSys.shiftOrigin({
-				range * dir,
-				0.0f
-			});
-
-			offset.x += static_cast<int>(dir);
-		}
-
-		if (std::abs(pos.y) > range) {
-			std::cout
-				<< "shift y "
-				<< pos.y << " "
-				<< range << "\n";
-			auto& physSys = world.getSystem<Game::PhysicsSystem>();
-			auto dir = std::copysign(1.0f, pos.y);
-
-			physSys.shiftOrigin({
-				0.0f,
-				range * dir
-			});
-
-			offset.y += static_cast<int>(dir);
-		}
+		// Long distance teleports are handled by shifting multiple times at once.
+		const glm::vec2 pos = engine.camera.getPosition();
+		const glm::ivec2 steps = {shiftSteps(pos.x, range), shiftSteps(pos.y, range)};
+		if (steps == glm::ivec2{0, 0}) { return; }
+
+		const b2Vec2 shift = {steps.x * range, steps.y * range};
+		ENGINE_LOG("Shifting physics origin by (", shift.x, ", ", shift.y, ")");
+
+		world.getSystem<PhysicsSystem>().shiftOrigin(shift);
+		engine.camera.setPosition(pos - glm::vec2{shift.x, shift.y});
+		offset += steps;
 	}
 
 	glm::ivec2 PhysicsOriginShiftSystem::getOffset() const {
@@ -1,6 +1,11 @@
+// STD
+#include <algorithm>
+#include <thread>
+
 // Game
 #include <Game/World.hpp>
 #include <Game/Math.hpp>
+#include <Game/PhysicsOrigin.hpp>
 #include <Game/systems/PhysicsSystem.hpp>
 
 namespace {
@@ -8,14 +13,41 @@ namespace {
 	using ProxyFilter = Engine::ECS::EntityFilterList<
 		Game::PhysicsBodyComponent
 	>;
+
+	/**
+	 * Box2D lazily initializes the contact create functions the first time a contact is created.
+	 * Do that up front so it can not happen on multiple threads at once when worlds are stepped in parallel.
+	 * Box2D's remaining globals (b2_gjkCalls, b2_toiCalls, etc.) are profiling counters only and are safe to ignore.
+	 */
+	void initContactRegisters() {
+		static const bool init = []{
+			b2World temp{b2Vec2_zero};
+			b2CircleShape shape;
+			shape.m_radius = 1.0f;
+
+			for (int i = 0; i < 2; ++i) {
+				b2BodyDef bodyDef;
+				bodyDef.type = b2_dynamicBody;
+				temp.CreateBody(&bodyDef)->CreateFixture(&shape, 1.0f);
+			}
+
+			temp.Step(1.0f / 64, 1, 1);
+			return true;
+		}();
+	}
+
+	int32 getStepThreadCount(const int32 max) {
+		return std::clamp(static_cast<int32>(std::thread::hardware_concurrency()), 1, max) - 1;
+	}
 }
 
 namespace Game {
 	PhysicsSystem::PhysicsSystem(SystemArg arg)
 		: System{arg}
 		, physWorld{b2Vec2_zero}
-		, contactListener{*this} {
+		, pool{getStepThreadCount(maxStepThreads)} {
 
+		initContactRegisters();
 		physWorld.SetContactListener(&contactListener);
 
 		#if defined(DEBUG_PHYSICS)
@@ -31,7 +63,7 @@ namespace Game {
 
 	void PhysicsSystem::onComponentRemoved(const Engine::ECS::Entity ent, PhysicsBodyComponent& comp) {
 		// ENGINE_INFO(" PhysicsSystem - component removed from ", ent);
-		physWorld.DestroyBody(comp.body);
+		destroyBody(comp.body);
 	};
 
 	void PhysicsSystem::tick() {
@@ -49,6 +81,7 @@ namespace Game {
 			}
 
 			for (const auto ent : world.getFilter<PhysicsBodyComponent, PhysicsInterpComponent>()) {
+				if (!world.isRollbackAffected(ent)) { continue; }
 				auto& physBodyComp = world.getComponent<PhysicsBodyComponent>(ent);
 				auto& physInterpComp = world.getComponent<PhysicsInterpComponent>(ent);
 				if (physInterpComp.onlyUserVerified && physBodyComp.getBody().GetType() != b2_staticBody) {
@@ -76,20 +109,30 @@ namespace Game {
 					constexpr auto serverTickTime = World::getTickInterval();
 					const auto step = dejitter + ping + netrate + serverTickTime + World::getTickInterval() * buffSize;
 					interpTime = world.getTickTime() - step;
+					remoteDelay = step;
+
+					{
+						// Only states within the snapshot history have a known tick time
+						const auto tick = world.getTick();
+						const auto& confirmed = physInterpComp.confirmed;
+						const auto byTick = [](const auto& state, Engine::ECS::Tick t){ return Engine::seqLess(state.tick, t); };
+						const auto first = std::lower_bound(confirmed.begin(), confirmed.end(), tick - tickrate + 1, byTick);
+						const auto last = std::lower_bound(first, confirmed.end(), tick + 1, byTick);
 
-					// TODO: this isnt great on the ECS/snapshot memory layout
-					for (Engine::ECS::Tick t = world.getTick(); t > world.getTick() - tickrate; --t) {
-						const auto& physCompState = world.getComponentState<PhysicsBodyComponent>(ent, t);
-						if (physCompState.rollbackOverride) {
-							const auto tickTime = world.getTickTime(t);
-							if (tickTime >= interpTime) {
-								physInterpComp.nextTrans = physCompState.trans;
-								physInterpComp.nextTime = tickTime;
-							} else {
-								physInterpComp.prevTrans = physCompState.trans;
-								physInterpComp.prevTime = tickTime;
-								break;
-							}
+						// The first state at or after interpTime and the one before it
+						const auto found = std::lower_bound(first, last, interpTime, [&](const auto& state, const auto& time){
+							return world.getTickTime(state.tick) < time;
+						});
+
+						if (found != last) {
+							physInterpComp.nextTrans = found->trans;
+							physInterpComp.nextTime = world.getTickTime(found->tick);
+						}
+
+						if (found != first) {
+							const auto& prev = *(found - 1);
+							physInterpComp.prevTrans = prev.trans;
+							physInterpComp.prevTime = world.getTickTime(prev.tick);
 						}
 					}
 
@@ -125,14 +168,40 @@ namespace Game {
 		}
 
 		// TODO: look into SetAutoClearForces
-		physWorld.Step(world.getTickDelta(), 8, 3);
+		if (zones.empty()) {
+			physWorld.Step(world.getTickDelta(), 8, 3);
+		} else {
+			stepZones(world.getTickDelta());
+		}
+
+		collectContacts();
+	}
+
+	void PhysicsSystem::stepZones(float32 dt) {
+		pool.forEach(static_cast<int32>(zones.size()) + 1, [&](int32 i){
+			auto& w = i == 0 ? physWorld : zones[i - 1]->physWorld;
+			w.Step(dt, 8, 3);
+		});
+	}
+
+	void PhysicsSystem::collectContacts() {
+		contacts.clear();
+		contacts.append(contactListener.events);
+		contactListener.events.clear();
+
+		for (auto& zone : zones) {
+			contacts.append(zone->contactListener.events);
+			zone->contactListener.events.clear();
+		}
+
+		contacts.build();
 	}
 
 	void PhysicsSystem::render(const RenderLayer layer) {
 		#if defined(DEBUG_PHYSICS)
 		if (layer == RenderLayer::PhysicsDebug) {
 			debugDraw.reset();
-			physWorld.DrawDebugData();
+			forEachWorld([](b2World& w){ w.DrawDebugData(); });
 		}
 		#endif
 	}
@@ -140,6 +209,7 @@ namespace Game {
 	void PhysicsSystem::preStoreSnapshot() {
 		// TODO: client only?
 		for (const auto ent : world.getFilter<PhysicsBodyComponent>()) {
+			if (!world.isRollbackAffected(ent)) { continue; }
 			auto& physComp = world.getComponent<PhysicsBodyComponent>(ent);
 			physComp.snap = false;
 			physComp.rollbackOverride = false;
@@ -155,10 +225,203 @@ namespace Game {
 				}
 			}
 		}
+
+		// A selective rollback only resimulates some bodies so keep the originally stored state.
+		// Any corrected bodies are fixed up from the snapshot components when loaded.
+		if (!world.isSelectiveRollback()) {
+			auto& state = states.insert(world.getTick());
+			state.store(physWorld);
+			for (auto& zone : zones) { state.add(zone->physWorld); }
+		}
+	}
+
+	void PhysicsSystem::preLoadSnapshot() {
+		const auto* state = states.find(world.getRollbackTick());
+		if (!state) { return; }
+
+		forEachWorld([&](b2World& w){
+			if (world.isSelectiveRollback()) {
+				state->load(w, [&](const b2Body& body){
+					return world.isRollbackAffected(toEntity(body.GetUserData()));
+				});
+			} else {
+				state->load(w);
+			}
+		});
+	}
+
+	void PhysicsSystem::postLoadSnapshot() {
+		if (!world.isSelectiveRollback()) { return; }
+
+		// Unaffected bodies are moved along their recorded path during the replay. Keep their current state to restore afterward.
+		// They are kinematic until then so the solver only integrates them and they have no contacts with terrain or each other.
+		unaffectedBodies.clear();
+		for (const auto ent : world.getFilter<PhysicsBodyComponent>()) {
+			if (world.isRollbackAffected(ent)) { continue; }
+			const auto& physComp = world.getComponent<PhysicsBodyComponent>(ent);
+			const auto& body = physComp.getBody();
+			if (body.GetType() == b2_staticBody) { continue; }
+
+			unaffectedBodies.push_back({
+				.ent = ent,
+				.trans = physComp.getTransform(),
+				.vel = body.GetLinearVelocity(),
+				.angVel = body.GetAngularVelocity(),
+				.type = body.GetType(),
+				.awake = body.IsAwake(),
+			});
+		}
+
+		setBodyTypes(true);
+	}
+
+	void PhysicsSystem::preTick() {
+		if (!world.isSelectiveRollback()) { return; }
+
+		// Resimulated bodies should interact with unaffected ones where they were at this tick, not where they are now.
+		// Unaffected bodies are kinematic so the step moves them by their velocity alone. Aim that at their recorded
+		// transform for the next tick instead of setting the transform each tick, which would update the broad-phase.
+		const auto tick = world.getTick();
+		const auto next = tick + 1;
+		const auto invDt = 1.0f / world.getTickDelta();
+		for (auto& unaffected : unaffectedBodies) {
+			if (!world.isAlive(unaffected.ent) || !world.hasComponent<PhysicsBodyComponent>(unaffected.ent)) { continue; }
+			if (!world.hadComponent<PhysicsBodyComponent>(unaffected.ent, tick)) { continue; }
+
+			auto& physComp = world.getComponent<PhysicsBodyComponent>(unaffected.ent);
+			if (!unaffected.tracking) {
+				unaffected.tracking = true;
+				const auto& state = world.getComponentState<PhysicsBodyComponent>(unaffected.ent, tick);
+				const auto& trans = physComp.getTransform();
+				if (trans.p != state.trans.p || trans.q.s != state.trans.q.s || trans.q.c != state.trans.q.c) {
+					physComp.setTransform(state.trans.p, state.trans.q.GetAngle());
+				}
+			}
+
+			// The last replayed tick ends where the body was before the rollback
+			const b2Transform* target = nullptr;
+			if (tick == world.getRollbackEndTick()) {
+				target = &unaffected.trans;
+			} else if (world.hasHistory(next) && world.hadComponent<PhysicsBodyComponent>(unaffected.ent, next)) {
+				target = &world.getComponentState<PhysicsBodyComponent>(unaffected.ent, next).trans;
+			}
+
+			if (target) {
+				const auto& trans = physComp.getTransform();
+				physComp.setVelocity(invDt * (target->p - trans.p));
+				physComp.setAngularVelocity(invDt * b2MulT(trans.q, target->q).GetAngle());
+			} else {
+				physComp.setVelocity(b2Vec2_zero);
+				physComp.setAngularVelocity(0.0f);
+			}
+		}
+	}
+
+	void PhysicsSystem::preRollback() {
+		if (!world.isSelectiveRollback()) { return; }
+		const auto tick = world.getRollbackTick();
+
+		// The area each corrected entity could have covered between the rollback tick and now
+		rollbackAreas.clear();
+		for (const auto ent : world.getRollbackCorrected()) {
+			if (!world.isAlive(ent) || !world.hasComponent<PhysicsBodyComponent>(ent)) { continue; }
+
+			const auto pos = world.getComponent<PhysicsBodyComponent>(ent).getPosition();
+			auto& area = rollbackAreas.emplace_back(b2AABB{pos, pos});
+
+			if (world.hadComponent<PhysicsBodyComponent>(ent, tick)) {
+				const auto old = world.getComponentState<PhysicsBodyComponent>(ent, tick).trans.p;
+				area.lowerBound = b2Min(area.lowerBound, old);
+				area.upperBound = b2Max(area.upperBound, old);
+			}
+
+			area.lowerBound -= b2Vec2{rollbackMargin, rollbackMargin};
+			area.upperBound += b2Vec2{rollbackMargin, rollbackMargin};
+		}
+
+		const auto inArea = [&](const b2Vec2 p) {
+			for (const auto& area : rollbackAreas) {
+				if (area.lowerBound.x <= p.x && p.x <= area.upperBound.x
+					&& area.lowerBound.y <= p.y && p.y <= area.upperBound.y) {
+					return true;
+				}
+			}
+			return false;
+		};
+
+		// Anything that is or was near a corrected entity
+		for (const auto ent : world.getFilter<PhysicsBodyComponent>()) {
+			const auto& physComp = world.getComponent<PhysicsBodyComponent>(ent);
+			if (physComp.getBody().GetType() == b2_staticBody) { continue; }
+
+			if (inArea(physComp.getPosition())
+				|| (world.hadComponent<PhysicsBodyComponent>(ent, tick) && inArea(world.getComponentState<PhysicsBodyComponent>(ent, tick).trans.p))) {
+				world.markRollbackAffected(ent);
+			}
+		}
+
+		// Anything touching an affected entity. Marking extends the affected list so this follows chains of contacts.
+		const auto& affected = world.getRollbackAffected();
+		for (size_t i = 0; i < affected.size(); ++i) {
+			const auto ent = affected[i];
+			if (!world.hasComponent<PhysicsBodyComponent>(ent)) { continue; }
+
+			auto& body = world.getComponent<PhysicsBodyComponent>(ent).getBody();
+			for (auto* edge = body.GetContactList(); edge; edge = edge->next) {
+				if (!edge->contact->IsTouching() || edge->other->GetType() == b2_staticBody) { continue; }
+				world.markRollbackAffected(toEntity(edge->other->GetUserData()));
+			}
+		}
+	}
+
+	void PhysicsSystem::postRollback() {
+		setBodyTypes(false);
+
+		for (const auto& unaffected : unaffectedBodies) {
+			if (!world.isAlive(unaffected.ent) || !world.hasComponent<PhysicsBodyComponent>(unaffected.ent)) { continue; }
+			auto& physComp = world.getComponent<PhysicsBodyComponent>(unaffected.ent);
+			const auto& trans = physComp.getTransform();
+			if (trans.p != unaffected.trans.p || trans.q.s != unaffected.trans.q.s || trans.q.c != unaffected.trans.q.c) {
+				physComp.setTransform(unaffected.trans.p, unaffected.trans.q.GetAngle());
+			}
+			physComp.setVelocity(unaffected.vel);
+			physComp.setAngularVelocity(unaffected.angVel);
+			physComp.getBody().SetAwake(unaffected.awake);
+		}
+
+		unaffectedBodies.clear();
+	}
+
+	template<class Func>
+	void PhysicsSystem::forEachState(Func&& func) {
+		const auto tick = world.getTick();
+		for (Engine::ECS::Tick t = tick - states.capacity() + 1; t != tick + 1; ++t) {
+			if (auto* state = states.find(t)) { func(*state); }
+		}
+	}
+
+	void PhysicsSystem::setBodyTypes(bool replay) {
+		contactListener.paused = true;
+		for (auto& zone : zones) { zone->contactListener.paused = true; }
+
+		// Changing the type destroys the contacts of a body. Any that are still needed are recreated by the next step.
+		for (const auto& unaffected : unaffectedBodies) {
+			if (!world.isAlive(unaffected.ent) || !world.hasComponent<PhysicsBodyComponent>(unaffected.ent)) { continue; }
+			auto& body = world.getComponent<PhysicsBodyComponent>(unaffected.ent).getBody();
+			body.SetType(replay ? b2_kinematicBody : unaffected.type);
+			if (replay) { body.SetAwake(unaffected.awake); }
+		}
+
+		contactListener.paused = false;
+		for (auto& zone : zones) { zone->contactListener.paused = false; }
 	}
 
 	b2Body* PhysicsSystem::createBody(Engine::ECS::Entity ent, b2BodyDef& bodyDef) {
-		auto body = physWorld.CreateBody(&bodyDef);
+		return createBody(ent, bodyDef, physWorld);
+	}
+
+	b2Body* PhysicsSystem::createBody(Engine::ECS::Entity ent, b2BodyDef& bodyDef, b2World& zoneWorld) {
+		auto body = zoneWorld.CreateBody(&bodyDef);
 		static_assert(sizeof(void*) >= sizeof(ent), "Engine::ECS::Entity is to large to store in userdata pointer.");
 		body->SetUserData(reinterpret_cast<void*>(reinterpret_cast<std::uintptr_t&>(ent)));
 		return body;
@@ -166,21 +429,57 @@ namespace Game {
 
 	void PhysicsSystem::destroyBody(b2Body* body) {
 		ENGINE_DEBUG_ASSERT(body != nullptr, "Attempting to destroy null b2Body");
-		physWorld.DestroyBody(body);
+
+		forEachState([&](PhysicsState& state){ state.remove(body); });
+		body->GetWorld()->DestroyBody(body);
 	}
 
-	void PhysicsSystem::addListener(PhysicsListener* listener) {
-		contactListener.addListener(listener);
+	void PhysicsSystem::destroyFixtures(b2Body& body) {
+		forEachState([&](PhysicsState& state){ state.removeContacts(&body); });
+		for (auto* fixture = body.GetFixtureList(); fixture;) {
+			auto* next = fixture->GetNext();
+			body.DestroyFixture(fixture);
+			fixture = next;
+		}
+	}
+
+	b2World& PhysicsSystem::createWorld() {
+		return zones.emplace_back(std::make_unique<Zone>(*this))->physWorld;
+	}
+
+	void PhysicsSystem::destroyWorld(b2World& zoneWorld) {
+		const auto found = std::find_if(zones.begin(), zones.end(), [&](const auto& zone){ return &zone->physWorld == &zoneWorld; });
+		ENGINE_DEBUG_ASSERT(found != zones.end(), "Attempting to destroy an unknown b2World");
+		ENGINE_DEBUG_ASSERT(zoneWorld.GetBodyCount() == 0, "Attempting to destroy a b2World that still has bodies");
+
+		// Keep the end events from the bodies that were removed
+		contactListener.events.append((*found)->contactListener.events);
+		zones.erase(found);
 	}
 
 	void PhysicsSystem::shiftOrigin(const b2Vec2& newOrigin) {
-		ENGINE_ASSERT(false, "TODO: impl"); // TODO: impl
-		//physWorld.ShiftOrigin(newOrigin);
-		//
-		//for (auto& ent : world.getFilter<PhysicsBodyComponent>()) {
-		//	auto& physComp = world.getComponent<PhysicsBodyComponent>(ent);
-		//	physComp.setTransform2(physComp.body->GetTransform());
-		//}
+		ENGINE_DEBUG_ASSERT(zones.empty(), "The main world is only shifted on the client which has no additional worlds");
+		ENGINE_DEBUG_ASSERT(!world.isPerformingRollback(), "Attempting to shift the physics origin during a rollback");
+
+		// Box2D moves all bodies, including inactive chunk bodies, so chunks and their meshes follow without a rebuild
+		physWorld.ShiftOrigin(newOrigin);
+		forEachState([&](PhysicsState& state){ state.shiftOrigin(physWorld, newOrigin); });
+		shiftComponentOrigin<PhysicsBodyComponent, PhysicsInterpComponent>(world, newOrigin);
+	}
+
+	void PhysicsSystem::shiftOrigin(b2World& zoneWorld, const b2Vec2& newOrigin) {
+		ENGINE_DEBUG_ASSERT(&zoneWorld != &physWorld, "Use shiftOrigin(newOrigin) to shift the main world");
+
+		zoneWorld.ShiftOrigin(newOrigin);
+		forEachState([&](PhysicsState& state){ state.shiftOrigin(zoneWorld, newOrigin); });
+
+		for (auto* body = zoneWorld.GetBodyList(); body; body = body->GetNext()) {
+			const auto ent = toEntity(body->GetUserData());
+			if (!world.isAlive(ent) || !world.hasComponent<PhysicsBodyComponent>(ent)) { continue; }
+
+			auto& physComp = world.getComponent<PhysicsBodyComponent>(ent);
+			if (physComp.body == body) { physComp.origin += newOrigin; }
+		}
 	}
 
 	#if defined(DEBUG_PHYSICS)
@@ -192,29 +491,39 @@ namespace Game {
 }
 
 namespace Game {
-	PhysicsSystem::ContactListener::ContactListener(PhysicsSystem& physSys)
-		: physSys{physSys} {
-	}
-
 	void PhysicsSystem::ContactListener::BeginContact(b2Contact* contact) {
-		const auto entA = toEntity(contact->GetFixtureA()->GetBody()->GetUserData());
-		const auto entB = toEntity(contact->GetFixtureB()->GetBody()->GetUserData());
-
-		for (auto listener : listeners) {
-			listener->beginContact(entA, entB);
-		}
+		if (paused) { return; }
+		const auto* fixtureA = contact->GetFixtureA();
+		const auto* fixtureB = contact->GetFixtureB();
+		events.add(ContactEvents::Type::Begin,
+			toEntity(fixtureA->GetBody()->GetUserData()),
+			toEntity(fixtureB->GetBody()->GetUserData()),
+			fixtureA->GetUserData(),
+			fixtureB->GetUserData()
+		);
 	}
 
 	void PhysicsSystem::ContactListener::EndContact(b2Contact* contact) {
-		const auto entA = toEntity(contact->GetFixtureA()->GetBody()->GetUserData());
-		const auto entB = toEntity(contact->GetFixtureB()->GetBody()->GetUserData());
-
-		for (auto listener : listeners) {
-			listener->endContact(entA, entB);
-		}
+		if (paused) { return; }
+		const auto* fixtureA = contact->GetFixtureA();
+		const auto* fixtureB = contact->GetFixtureB();
+		events.add(ContactEvents::Type::End,
+			toEntity(fixtureA->GetBody()->GetUserData()),
+			toEntity(fixtureB->GetBody()->GetUserData()),
+			fixtureA->GetUserData(),
+			fixtureB->GetUserData()
+		);
 	}
+}
 
-	void PhysicsSystem::ContactListener::addListener(PhysicsListener* listener) {
-		listeners.push_back(listener);
+namespace Game {
+	PhysicsSystem::Zone::Zone(PhysicsSystem& physSys)
+		: physWorld{b2Vec2_zero} {
+
+		physWorld.SetContactListener(&contactListener);
+
+		#if defined(DEBUG_PHYSICS)
+			physWorld.SetDebugDraw(&physSys.debugDraw);
+		#endif
 	}
 }
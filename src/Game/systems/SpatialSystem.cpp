@@ -0,0 +1,51 @@
+// Engine
+#include <Engine/Glue/Box2D.hpp>
+#include <Engine/Glue/glm.hpp>
+
+// Game
+#include <Game/World.hpp>
+#include <Game/systems/SpatialSystem.hpp>
+
+
+namespace Game {
+	SpatialSystem::SpatialSystem(SystemArg arg)
+		: System{arg} {
+		static_assert(World::orderAfter<SpatialSystem, PhysicsInterpSystem>());
+	}
+
+	void SpatialSystem::postTick() {
+		bodyIndex.clear();
+		for (const auto ent : world.getFilter<PhysicsBodyComponent>()) {
+			const auto& physComp = world.getComponent<PhysicsBodyComponent>(ent);
+			const auto& body = physComp.getBody();
+			const auto pos = Engine::Glue::as<glm::vec2>(physComp.getPosition());
+
+			// Bounds of all fixtures so that large entities can be found by overlap. Same space as getPosition.
+			glm::vec2 min = pos;
+			glm::vec2 max = pos;
+			for (const auto* fixture = body.GetFixtureList(); fixture; fixture = fixture->GetNext()) {
+				const auto* shape = fixture->GetShape();
+				for (int32 child = 0; child < shape->GetChildCount(); ++child) {
+					b2AABB aabb;
+					shape->ComputeAABB(&aabb, body.GetTransform(), child);
+					min = glm::min(min, Engine::Glue::as<glm::vec2>(aabb.lowerBound + physComp.getOrigin()));
+					max = glm::max(max, Engine::Glue::as<glm::vec2>(aabb.upperBound + physComp.getOrigin()));
+				}
+			}
+
+			bodyIndex.insert(ent, pos, min, max, world.getComponentsBitset(ent));
+		}
+		bodyIndex.build();
+	}
+
+	void SpatialSystem::run(float32 dt) {
+		if constexpr (!ENGINE_CLIENT) { return; }
+
+		interpIndex.clear();
+		for (const auto ent : world.getFilter<PhysicsInterpComponent>()) {
+			const auto& physInterpComp = world.getComponent<PhysicsInterpComponent>(ent);
+			interpIndex.insert(ent, Engine::Glue::as<glm::vec2>(physInterpComp.getPosition()), world.getComponentsBitset(ent));
+		}
+		interpIndex.build();
+	}
+}
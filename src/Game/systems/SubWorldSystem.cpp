@@ -1,178 +1,298 @@
+// STD
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+// Engine
+#include <Engine/Glue/Box2D.hpp>
+#include <Engine/Glue/glm.hpp>
+
 // Game
 #include <Game/World.hpp>
 #include <Game/systems/SubWorldSystem.hpp>
 
 
 namespace {
-	ENGINE_INLINE b2Body* copyBodyToWorld(b2Body* body, b2World* world) {
-		b2BodyDef bodyDef;
-		b2FixtureDef fixtureDef;
-		bodyDef.type = body->GetType();
-		bodyDef.position = body->GetPosition(); // TODO: this wont work. need to adjust for new world origin
-		bodyDef.angle = body->GetAngle();
-		bodyDef.linearVelocity = body->GetLinearVelocity();
-		bodyDef.angularVelocity = body->GetAngularVelocity();
-		bodyDef.linearDamping = body->GetLinearDamping();
-		bodyDef.angularDamping = body->GetAngularDamping();
-		bodyDef.allowSleep = body->IsSleepingAllowed();
-		bodyDef.awake = body->IsAwake();
-		bodyDef.fixedRotation = body->IsFixedRotation();
-		bodyDef.bullet = body->IsBullet();
-		bodyDef.active = body->IsActive();
-		bodyDef.userData = body->GetUserData();
-		bodyDef.gravityScale = body->GetGravityScale();
-
-		auto* newBody = world->CreateBody(&bodyDef);
-		auto* fixture = body->GetFixtureList();
-		while (fixture) {
-			fixtureDef.shape = fixture->GetShape();
-			fixtureDef.userData = fixture->GetUserData();
-			fixtureDef.friction = fixture->GetFriction();
-			fixtureDef.restitution = fixture->GetRestitution();
-			fixtureDef.density = fixture->GetDensity();
-			fixtureDef.isSensor = fixture->IsSensor();
-			fixtureDef.filter = fixture->GetFilterData();
-
-			newBody->CreateFixture(&fixtureDef);
-			fixture = fixture->GetNext();
-		}
-
-		return newBody;
+	b2Vec2 snapOrigin(const b2Vec2 pos) {
+		constexpr auto step = Game::SubWorldSystem::originStep;
+		return {std::floor(pos.x / step) * step, std::floor(pos.y / step) * step};
 	}
 }
 
 namespace Game {
 	SubWorldSystem::SubWorldSystem(SystemArg arg)
-		: System{arg} { // TODO: add own comp (flag comp?) to id players
-	};
+		: System{arg} {
+		static_assert(World::orderBefore<SubWorldSystem, PhysicsSystem>());
+	}
 
 	void SubWorldSystem::tick() {
-		// TODO: Lots can be improved here.
+		if constexpr (!ENGINE_SERVER) { return; }
 
-		// TODO: shoudl be able to do this whenever we merge/split so we dont need an extra iteration
-		playerData.clear();
-		for (auto ent : world.getFilter<PhysicsBodyComponent>()) {
+		buildGroups();
+		assignWorlds();
+		migrateGroups();
+
+		// Anything left in a zone no group claimed is no longer near any players
+		for (auto& zone : zones) {
+			if (!zone.claimed) { releaseZone(zone); }
+		}
+		std::erase_if(zones, [](const Zone& zone){ return !zone.claimed; });
+
+		for (const auto& zone : zones) {
+			releaseBodies(zone);
+		}
+
+		for (const auto& group : playerGroups.groups) {
+			if (auto* zone = findZone(group.physWorld)) {
+				syncTerrain(*zone, group);
+			}
+		}
+	}
+
+	void SubWorldSystem::buildGroups() {
+		auto& players = playerGroups.players;
+		players.clear();
+		for (const auto ent : world.getFilter<PlayerFlag, PhysicsBodyComponent>()) {
 			auto& physComp = world.getComponent<PhysicsBodyComponent>(ent);
-			playerData.push_back({
+			players.push_back({
 				.ent = ent,
-				.physComp = &physComp,
+				.physWorld = physComp.getWorld(),
+				.origin = physComp.getOrigin(),
 				.pos = physComp.getPosition(),
-				.group = nullptr,
-				.shouldSplit = false,
 			});
 		}
-		const auto size = playerData.size();
 
-		// Group and split players by proximity to eachother and world origins
-		groups.clear();
-		groups.reserve(size);
-		for (int i = 0; i < size; ++i) {
-			auto& ply1 = playerData[i];
+		playerGroups.build();
+	}
+
+	void SubWorldSystem::assignWorlds() {
+		auto& physSys = world.getSystem<PhysicsSystem>();
+		auto& groups = playerGroups.groups;
 
-			if (maxRangeSquared < ply1.pos.LengthSquared()) {
-				ply1.shouldSplit = true;
-			}
+		for (auto& zone : zones) { zone.claimed = false; }
 
-			if (ply1.group == nullptr) {
-				groups.emplace_back();
-				ply1.group = &groups.back();
+		// Larger groups pick first so the fewest bodies need to move
+		std::vector<int32> order(groups.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&](int32 a, int32 b){
+			return groups[a].players.size() > groups[b].players.size();
+		});
+
+		std::vector<std::pair<b2World*, int32>> counts;
+		for (const auto g : order) {
+			auto& group = groups[g];
+			const auto center = group.bounds.GetCenter();
+
+			counts.clear();
+			for (const auto p : group.players) {
+				auto* w = playerGroups.players[p].physWorld;
+				const auto found = std::find_if(counts.begin(), counts.end(), [&](const auto& pair){ return pair.first == w; });
+				if (found == counts.end()) {
+					counts.emplace_back(w, 1);
+				} else {
+					++found->second;
+				}
 			}
 
-			for (int j = i + 1; j < size; ++j) {
-				auto& ply2 = playerData[j];
-				const auto diff = abs(ply1.pos.LengthSquared() - ply2.pos.LengthSquared());
-				if (diff < minRangeSquared) {
-					ply2.group = ply1.group;
-					ply1.shouldSplit = false;
+			std::stable_sort(counts.begin(), counts.end(), [](const auto& a, const auto& b){ return a.second > b.second; });
+
+			group.physWorld = nullptr;
+			for (const auto& [w, count] : counts) {
+				// The main world is never shifted so groups always use a zone to keep their origin nearby
+				auto* zone = findZone(w);
+				if (!zone || zone->claimed) { continue; }
+				zone->claimed = true;
+
+				const auto dist = center - zone->origin;
+				if (std::abs(dist.x) > PhysicsOriginShiftSystem::range || std::abs(dist.y) > PhysicsOriginShiftSystem::range) {
+					const auto newOrigin = snapOrigin(center);
+					physSys.shiftOrigin(*zone->physWorld, newOrigin - zone->origin);
+					zone->origin = newOrigin;
 				}
+
+				group.physWorld = w;
+				group.origin = zone->origin;
+				break;
+			}
+
+			if (!group.physWorld) {
+				auto& zone = zones.emplace_back();
+				zone.physWorld = &physSys.createWorld();
+				zone.origin = snapOrigin(center);
+				zone.claimed = true;
+				group.physWorld = zone.physWorld;
+				group.origin = zone.origin;
+				ENGINE_LOG("SubWorldSystem - new world for ", group.players.size(), " players at (", zone.origin.x, ", ", zone.origin.y, ")");
 			}
 		}
+	}
+
+	void SubWorldSystem::migrateGroups() {
+		auto& mainWorld = world.getSystem<PhysicsSystem>().getWorld();
+
+		for (const auto& group : playerGroups.groups) {
+			moving.clear();
 
-		// Determine the most populated world per group
-		for (int i = 0; i < size; ++i) {
-			auto& ply = playerData[i];
-			if (!ply.shouldSplit) {
-				++ply.group->worlds[ply.physComp->getWorld()];
+			for (const auto p : group.players) {
+				const auto& ply = playerGroups.players[p];
+				auto* from = ply.physWorld;
+
+				if (from != group.physWorld) {
+					moving.push_back(ply.ent);
+					findNearby(*from, ply.origin, ply.pos);
+				}
+
+				// Bodies not near any group are left in the main world. Pick them up as the group approaches.
+				findNearby(mainWorld, b2Vec2_zero, ply.pos);
+			}
+
+			for (const auto ent : moving) {
+				migrate(ent, *group.physWorld, group.origin);
 			}
 		}
+	}
 
-		// Set the world for each group
-		for (auto& group : groups) { // TODO: this could be moved into the group find loop
-			group.world = std::max_element(group.worlds.begin(), group.worlds.end(), [](const auto& a, const auto& b){
-				return a.second < b.second;
-			})->first;
+	void SubWorldSystem::releaseBodies(const Zone& zone) {
+		auto& mainWorld = world.getSystem<PhysicsSystem>().getWorld();
+		const auto& groups = playerGroups.groups;
+
+		// Bodies are only picked up from the main world and a player's previous world so anything that leaves its group would
+		// otherwise stay in this zone
+		moving.clear();
+		for (auto* body = zone.physWorld->GetBodyList(); body; body = body->GetNext()) {
+			const auto ent = PhysicsSystem::toEntity(body->GetUserData());
+			if (!world.isAlive(ent) || world.hasComponent<PlayerFlag>(ent) || !world.hasComponent<PhysicsBodyComponent>(ent)) { continue; }
+			if (&world.getComponent<PhysicsBodyComponent>(ent).getBody() != body) { continue; }
+			moving.push_back(ent);
 		}
-		// TODO: unused worlds arent freed
 
-		// Merge worlds
-		for (int i = 0; i < size; ++i) {
-			auto& ply = playerData[i];
-			if (!ply.shouldSplit && ply.physComp->getWorld() != ply.group->world) {
-				mergePlayer(ply, ply.group->world);
+		for (const auto ent : moving) {
+			const auto pos = world.getComponent<PhysicsBodyComponent>(ent).getPosition();
+			const PlayerGroups::Group* other = nullptr;
+			bool keep = false;
+
+			playerGroups.forEachNear(pos, releaseRange, [&](const PlayerGroups::Player& ply){
+				const auto& group = groups[ply.group];
+				if (group.physWorld == zone.physWorld) {
+					keep = true;
+				} else if (std::abs(ply.pos.x - pos.x) <= bodyRange && std::abs(ply.pos.y - pos.y) <= bodyRange) {
+					other = &group;
+				}
+			});
+
+			if (other) {
+				migrate(ent, *other->physWorld, other->origin);
+			} else if (!keep) {
+				migrate(ent, mainWorld, b2Vec2_zero);
 			}
 		}
+	}
 
-		// TODO: could be merged into above
-		// Split players
-		for (int i = 0; i < size; ++i) {
-			auto& ply = playerData[i];
-			if (!ply.shouldSplit) { continue; }
-			splitFromWorld(ply);
+	void SubWorldSystem::syncTerrain(Zone& zone, const PlayerGroups::Group& group) {
+		auto& mapSys = world.getSystem<MapSystem>();
+		auto& physSys = world.getSystem<PhysicsSystem>();
+		const auto tick = world.getTick();
+
+		const b2Vec2 margin = {bodyRange, bodyRange};
+		const auto minChunk = MapSystem::blockToChunk(mapSys.worldToBlock(Engine::Glue::as<glm::vec2>(group.bounds.lowerBound - margin)));
+		const auto maxChunk = MapSystem::blockToChunk(mapSys.worldToBlock(Engine::Glue::as<glm::vec2>(group.bounds.upperBound + margin)));
+
+		for (auto chunkPos = minChunk; chunkPos.x <= maxChunk.x; ++chunkPos.x) {
+			for (chunkPos.y = minChunk.y; chunkPos.y <= maxChunk.y; ++chunkPos.y) {
+				const auto active = mapSys.activeChunks.find(chunkPos);
+				if (active == mapSys.activeChunks.end()) { continue; }
+
+				auto& copy = zone.chunks[chunkPos];
+				copy.used = tick;
+
+				// MapSystem rebuilds chunk bodies after we run so a chunk updated this tick is copied again next tick
+				if (copy.body && Engine::seqLess(active->second.updated, copy.synced)) { continue; }
+
+				if (copy.body) { physSys.destroyBody(copy.body); }
+				copy.body = copyBodyToWorld(*active->second.body, b2Vec2_zero, *zone.physWorld, zone.origin);
+				copy.synced = tick;
+			}
 		}
 
-		// TODO: where to handle shifting worlds?
+		for (auto it = zone.chunks.begin(); it != zone.chunks.end();) {
+			if (it->second.used == tick) { ++it; continue; }
+			physSys.destroyBody(it->second.body);
+			it = zone.chunks.erase(it);
+		}
 	}
 
-	void SubWorldSystem::mergePlayer(PlayerData& ply, b2World* world) {
-		ENGINE_LOG("Merging - ", ply.ent, " ", world);
-		ENGINE_DEBUG_ASSERT(ply.physComp->getWorld() != ply.group->world);
-		auto* oldW = ply.physComp->getWorld();
-
-		bodies.clear();
-		struct QueryCallback : public b2QueryCallback {
-			decltype(bodies)& bs;
-			QueryCallback(decltype(bs) bs) : bs{bs} {};
-			bool ReportFixture(b2Fixture* fixture) override {
-				bs.insert(fixture->GetBody());
+	void SubWorldSystem::findNearby(b2World& physWorld, const b2Vec2 origin, const b2Vec2 pos) {
+		struct QueryCallback : b2QueryCallback {
+			World& world;
+			std::vector<Engine::ECS::Entity>& moving;
+
+			QueryCallback(World& world, std::vector<Engine::ECS::Entity>& moving)
+				: world{world}, moving{moving} {
+			}
+
+			virtual bool ReportFixture(b2Fixture* fixture) override {
+				auto* body = fixture->GetBody();
+				const auto ent = PhysicsSystem::toEntity(body->GetUserData());
+				if (!world.isAlive(ent) || world.hasComponent<PlayerFlag>(ent) || !world.hasComponent<PhysicsBodyComponent>(ent)) { return true; }
+
+				// Terrain and its copies are owned by the map entity
+				if (&world.getComponent<PhysicsBodyComponent>(ent).getBody() != body) { return true; }
+
+				moving.push_back(ent);
 				return true;
-			};
-		} callback{bodies};
+			}
+		} callback{world, moving};
 
-		oldW->QueryAABB(&callback, b2AABB{
-			ply.pos - b2Vec2{minRange, minRange},
-			ply.pos + b2Vec2{minRange, minRange},
+		const auto local = pos - origin;
+		physWorld.QueryAABB(&callback, b2AABB{
+			local - b2Vec2{bodyRange, bodyRange},
+			local + b2Vec2{bodyRange, bodyRange},
 		});
+	}
 
-		b2BodyDef bodyDef;
-		b2FixtureDef fixtureDef;
-		for (auto* body : bodies) {
-			Engine::ECS::Entity ent{static_cast<uint16>(reinterpret_cast<uintptr_t>(body->GetUserData())), 0};
-			auto* newBody = copyBodyToWorld(body, world);
-			this->world.getComponent<PhysicsBodyComponent>(ent).setBody(newBody);
-		}
+	void SubWorldSystem::migrate(const Engine::ECS::Entity ent, b2World& physWorld, const b2Vec2 origin) {
+		auto& physComp = world.getComponent<PhysicsBodyComponent>(ent);
+		auto* old = &physComp.getBody();
+		if (old->GetWorld() == &physWorld) { return; }
 
-		// TODO: if oldW has no players add it to usable list for splitting
+		auto* body = copyBodyToWorld(*old, physComp.getOrigin(), physWorld, origin);
+		world.getSystem<PhysicsSystem>().destroyBody(old);
+		physComp.setBody(body, origin);
 	}
 
-	void SubWorldSystem::splitFromWorld(PlayerData& ply) {
-		ENGINE_DEBUG_ASSERT(maxRangeSquared < ply.pos.LengthSquared(), "Needless player splitting");
-		auto* world = getFreeWorld();
-		ENGINE_LOG("Splitting - ", ply.ent, " ", world);
-		if (world != ply.physComp->getWorld()) {
-			mergePlayer(ply, world);
+	void SubWorldSystem::releaseZone(Zone& zone) {
+		auto& physSys = world.getSystem<PhysicsSystem>();
+
+		for (auto& [chunkPos, copy] : zone.chunks) {
+			physSys.destroyBody(copy.body);
+		}
+		zone.chunks.clear();
+
+		moving.clear();
+		for (auto* body = zone.physWorld->GetBodyList(); body; body = body->GetNext()) {
+			const auto ent = PhysicsSystem::toEntity(body->GetUserData());
+			if (!world.isAlive(ent) || !world.hasComponent<PhysicsBodyComponent>(ent)) { continue; }
+			if (&world.getComponent<PhysicsBodyComponent>(ent).getBody() != body) { continue; }
+			moving.push_back(ent);
+		}
+
+		for (const auto ent : moving) {
+			migrate(ent, physSys.getWorld(), b2Vec2_zero);
 		}
-		world->ShiftOrigin(ply.pos);
-	}
 
-	b2World* SubWorldSystem::getFreeWorld() {
-		b2World* world;
-		if (freeWorlds.empty()) {
-			// TODO: need to copy world properities
-			world = worlds.emplace_back(std::make_unique<b2World>(b2Vec2_zero)).get();
-		} else {
-			world = freeWorlds.back();
-			freeWorlds.pop_back();
+		for (auto* body = zone.physWorld->GetBodyList(); body;) {
+			auto* next = body->GetNext();
+			ENGINE_WARN("SubWorldSystem - destroying body without an owner");
+			physSys.destroyBody(body);
+			body = next;
 		}
-		return world;
+
+		physSys.destroyWorld(*zone.physWorld);
+		zone.physWorld = nullptr;
+	}
+
+	SubWorldSystem::Zone* SubWorldSystem::findZone(const b2World* physWorld) {
+		const auto found = std::find_if(zones.begin(), zones.end(), [&](const Zone& zone){ return zone.physWorld == physWorld; });
+		return found == zones.end() ? nullptr : &*found;
 	}
 }
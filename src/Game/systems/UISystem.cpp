@@ -111,6 +111,18 @@ namespace Game {
 		ImGui::Text("Tick %i", world.getTick());
 		ImGui::Text("Tick Scale: %.4f", world.tickScale);
 
+		{
+			const auto& stats = world.getRollbackStats();
+			ImGui::Text("Rollback: %i ticks, %i replayed, %i corrections, %i affected, %i frames, %.3fms",
+				stats.depth,
+				stats.replayed,
+				stats.corrections,
+				stats.affected,
+				stats.frames,
+				Engine::Clock::Milliseconds{stats.time}.count()
+			);
+		}
+
 		if (ImGui::Button("Disconnect")) {
 			for (const auto& ent : world.getFilter<ConnectionComponent>()) {
 				const auto& addr = world.getComponent<ConnectionComponent>(ent).conn->address();
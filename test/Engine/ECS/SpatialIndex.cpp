@@ -0,0 +1,208 @@
+// STD
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Engine
+#include <Engine/ECS/SpatialIndex.hpp>
+
+// GoogleTest
+#include<gtest/gtest.h>
+
+namespace {
+	using namespace Engine::Types;
+	using Engine::ECS::Entity;
+	using Engine::ECS::ComponentBitset;
+	using Engine::ECS::SpatialIndex;
+
+	struct Point {
+		Entity ent;
+		glm::vec2 pos;
+		ComponentBitset comps;
+	};
+
+	/**
+	 * Random points including negative coordinates and some in the same cell.
+	 */
+	std::vector<Point> makePoints(SpatialIndex& index, const int32 count) {
+		std::mt19937 rng{1234};
+		std::uniform_real_distribution<float32> dist{-100.0f, 100.0f};
+		std::vector<Point> points;
+
+		for (int32 i = 0; i < count; ++i) {
+			auto& point = points.emplace_back();
+			point.ent = {static_cast<uint16>(i), 0};
+			point.pos = {dist(rng), dist(rng)};
+			if (i % 7 == 0) { point.pos = points.front().pos; }
+			point.comps.set(i % 3);
+			if (i % 2) { point.comps.set(5); }
+			index.insert(point.ent, point.pos, point.comps);
+		}
+
+		index.build();
+		return points;
+	}
+
+	bool matches(const Point& point, const ComponentBitset& with) {
+		return (point.comps & with) == with;
+	}
+
+	std::vector<Entity> sorted(std::span<const Entity> ents) {
+		std::vector<Entity> result(ents.begin(), ents.end());
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+	TEST(Engine_ECS_SpatialIndex, queryAABB_MatchesBruteForce) {
+		SpatialIndex index{8.0f};
+		const auto points = makePoints(index, 1000);
+		EXPECT_EQ(index.size(), 1000);
+
+		ComponentBitset with;
+		with.set(5);
+
+		SpatialIndex::Results results;
+		const glm::vec2 boxes[][2] = {
+			{{-10.0f, -10.0f}, {10.0f, 10.0f}},
+			{{-100.0f, 3.5f}, {-20.0f, 40.0f}},
+			{{-1000.0f, -1000.0f}, {1000.0f, 1000.0f}},
+			{{500.0f, 500.0f}, {600.0f, 600.0f}},
+		};
+
+		for (const auto& box : boxes) {
+			for (const auto& filter : {ComponentBitset{}, with}) {
+				std::vector<Entity> expected;
+				for (const auto& point : points) {
+					if (!matches(point, filter)) { continue; }
+					if (point.pos.x < box[0].x || point.pos.y < box[0].y || point.pos.x > box[1].x || point.pos.y > box[1].y) { continue; }
+					expected.push_back(point.ent);
+				}
+
+				std::sort(expected.begin(), expected.end());
+				EXPECT_EQ(sorted(index.queryAABB(box[0], box[1], filter, results)), expected);
+			}
+		}
+
+		// Each query in the batch is kept
+		ASSERT_EQ(results.size(), 8);
+		EXPECT_EQ(results[4].size(), points.size());
+		EXPECT_TRUE(results[6].empty());
+	}
+
+	TEST(Engine_ECS_SpatialIndex, queryOverlap_MatchesBruteForce) {
+		SpatialIndex index{8.0f};
+		std::mt19937 rng{4321};
+		std::uniform_real_distribution<float32> dist{-100.0f, 100.0f};
+		std::uniform_real_distribution<float32> size{0.0f, 3.0f};
+
+		struct Bounds {
+			Entity ent;
+			glm::vec2 min;
+			glm::vec2 max;
+		};
+		std::vector<Bounds> bounds;
+
+		for (int32 i = 0; i < 500; ++i) {
+			auto& b = bounds.emplace_back();
+			b.ent = {static_cast<uint16>(i), 0};
+			const glm::vec2 pos = {dist(rng), dist(rng)};
+			b.min = pos - glm::vec2{size(rng), 0.0f};
+			b.max = pos + glm::vec2{size(rng), size(rng)};
+
+			// Tall entities anchored at their base
+			if (i % 50 == 0) { b.max.y += 40.0f; }
+
+			index.insert(b.ent, pos, b.min, b.max, {});
+		}
+
+		// Points are included as zero size bounds
+		index.insert({500, 0}, {1.0f, 1.0f}, {});
+		bounds.push_back({{500, 0}, {1.0f, 1.0f}, {1.0f, 1.0f}});
+		index.build();
+
+		SpatialIndex::Results results;
+		const glm::vec2 boxes[][2] = {
+			{{-5.0f, -5.0f}, {5.0f, 5.0f}},
+			{{-100.0f, 90.0f}, {100.0f, 140.0f}},
+			{{500.0f, 500.0f}, {600.0f, 600.0f}},
+		};
+
+		for (const auto& box : boxes) {
+			std::vector<Entity> expected;
+			for (const auto& b : bounds) {
+				if (b.max.x < box[0].x || b.min.x > box[1].x || b.max.y < box[0].y || b.min.y > box[1].y) { continue; }
+				expected.push_back(b.ent);
+			}
+
+			std::sort(expected.begin(), expected.end());
+			EXPECT_EQ(sorted(index.queryOverlap(box[0], box[1], {}, results)), expected);
+		}
+
+		// The tops of the tall entities are outside the cells of their positions
+		EXPECT_FALSE(results[1].empty());
+	}
+
+	TEST(Engine_ECS_SpatialIndex, queryRadius_MatchesBruteForce) {
+		SpatialIndex index{4.0f};
+		const auto points = makePoints(index, 500);
+
+		SpatialIndex::Results results;
+		for (const auto radius : {0.5f, 5.0f, 30.0f}) {
+			const glm::vec2 center = {-12.0f, 7.0f};
+
+			std::vector<Entity> expected;
+			for (const auto& point : points) {
+				const auto d = point.pos - center;
+				if (glm::dot(d, d) <= radius * radius) { expected.push_back(point.ent); }
+			}
+
+			std::sort(expected.begin(), expected.end());
+			EXPECT_EQ(sorted(index.queryRadius(center, radius, {}, results)), expected) << radius;
+		}
+	}
+
+	TEST(Engine_ECS_SpatialIndex, queryNearest_MatchesBruteForce) {
+		SpatialIndex index{8.0f};
+		const auto points = makePoints(index, 1000);
+
+		ComponentBitset with;
+		with.set(1);
+
+		SpatialIndex::Results results;
+		for (const auto k : {1, 5, 40}) {
+			for (const auto center : {glm::vec2{0.0f, 0.0f}, points.front().pos, glm::vec2{150.0f, -150.0f}}) {
+				std::vector<std::pair<float32, Entity>> expected;
+				for (const auto& point : points) {
+					if (!matches(point, with)) { continue; }
+					const auto d = point.pos - center;
+					expected.emplace_back(glm::dot(d, d), point.ent);
+				}
+
+				std::sort(expected.begin(), expected.end(), [](const auto& a, const auto& b){
+					if (a.first != b.first) { return a.first < b.first; }
+					return a.second.id < b.second.id;
+				});
+				expected.resize(k);
+
+				const auto found = index.queryNearest(center, k, 1000.0f, with, results);
+				ASSERT_EQ(found.size(), static_cast<size_t>(k));
+				for (int32 i = 0; i < k; ++i) {
+					EXPECT_EQ(found[i], expected[i].second) << k << " " << i;
+				}
+			}
+		}
+
+		// Nothing within range
+		EXPECT_TRUE(index.queryNearest({500.0f, 500.0f}, 3, 10.0f, {}, results).empty());
+	}
+
+	TEST(Engine_ECS_SpatialIndex, build_Empty) {
+		SpatialIndex index;
+		index.build();
+
+		SpatialIndex::Results results;
+		EXPECT_TRUE(index.queryAABB({-1.0f, -1.0f}, {1.0f, 1.0f}, {}, results).empty());
+		EXPECT_TRUE(index.queryNearest({0.0f, 0.0f}, 4, 100.0f, {}, results).empty());
+		EXPECT_EQ(results.size(), 2);
+	}
+}
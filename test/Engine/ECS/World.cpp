@@ -14,9 +14,31 @@ namespace {
 			int value = 0;
 	};
 
-	template<int>
-	class System;
-	
+	class World;
+
+	class SystemBase {
+		public:
+			SystemBase(World&) {};
+
+			void setup() {}
+			void preTick() {}
+			void tick() {}
+			void postTick() {}
+			void run(float) {}
+			void preStoreSnapshot() {}
+			void preLoadSnapshot() {}
+			void postLoadSnapshot() {}
+			void preRollback() {}
+			void postRollback() {}
+	};
+
+	template<int I>
+	class System : public SystemBase {
+		public:
+			using SystemBase::SystemBase;
+			int value = 0;
+	};
+
 	using ComponentA = Component<0>;
 	using ComponentB = Component<1>;
 	using ComponentC = Component<2>;
@@ -45,13 +67,9 @@ namespace {
 		ComponentE
 	>;
 
-	using World = Engine::ECS::World<SystemsSet, ComponentsSet>;
-
-	template<int I>
-	class System : public Engine::ECS::System {
+	class World : public Engine::ECS::World<World, 64, SystemsSet, ComponentsSet> {
 		public:
-			System(World&) {};
-			int value = 0;
+			World() : Engine::ECS::World<World, 64, SystemsSet, ComponentsSet>(*this) {}
 	};
 }
 
@@ -60,14 +78,21 @@ namespace {
 		World w;
 
 		auto ent = w.createEntity();
-		w.destroyEntity(ent);
+		ASSERT_TRUE(w.isAlive(ent));
+		ASSERT_TRUE(w.isEnabled(ent));
+
+		w.deferedDestroyEntity(ent);
+		ASSERT_FALSE(w.isEnabled(ent));
+
+		w.run();
+		ASSERT_FALSE(w.isAlive(ent));
 	}
 
 	TEST(Engine_ECS_World, getComponent) {
 		World w;
 
 		auto ent = w.createEntity();
-		
+
 		auto& c1 = w.addComponent<ComponentB>(ent);
 		auto& c2 = w.getComponent<ComponentB>(ent);
 
@@ -142,115 +167,64 @@ namespace {
 
 		const auto ent = w.createEntity();
 
-		ASSERT_FALSE(w.hasComponent(ent, w.getComponentID<ComponentA>()));
-		ASSERT_FALSE(w.hasComponent(ent, w.getComponentID<ComponentC>()));
-		ASSERT_FALSE(w.hasComponent(ent, w.getComponentID<ComponentE>()));
-
-		w.addComponent<ComponentA>(ent);
-		w.addComponent<ComponentC>(ent);
-		w.addComponent<ComponentE>(ent);
-
-		ASSERT_TRUE(w.hasComponent(ent, w.getComponentID<ComponentA>()));
-		ASSERT_TRUE(w.hasComponent(ent, w.getComponentID<ComponentC>()));
-		ASSERT_TRUE(w.hasComponent(ent, w.getComponentID<ComponentE>()));
-
-		w.removeComponent<ComponentA>(ent);
-		w.removeComponent<ComponentC>(ent);
-		w.removeComponent<ComponentE>(ent);
-
-		ASSERT_FALSE(w.hasComponent(ent, w.getComponentID<ComponentA>()));
-		ASSERT_FALSE(w.hasComponent(ent, w.getComponentID<ComponentC>()));
-		ASSERT_FALSE(w.hasComponent(ent, w.getComponentID<ComponentE>()));
-	}
-
-	TEST(Engine_ECS_World, hasComponent_Template) {
-		World w;
-
-		const auto ent = w.createEntity();
-
-		ASSERT_FALSE(w.hasComponent<ComponentA>(ent));
-		ASSERT_FALSE(w.hasComponent<ComponentC>(ent));
-		ASSERT_FALSE(w.hasComponent<ComponentE>(ent));
+		ASSERT_FALSE(w.hasComponent(ent, w.getComponentId<ComponentA>()));
+		ASSERT_FALSE(w.hasComponent(ent, w.getComponentId<ComponentC>()));
+		ASSERT_FALSE(w.hasComponent(ent, w.getComponentId<ComponentE>()));
 
 		w.addComponent<ComponentA>(ent);
 		w.addComponent<ComponentC>(ent);
 		w.addComponent<ComponentE>(ent);
 
-		ASSERT_TRUE(w.hasComponent<ComponentA>(ent));
-		ASSERT_TRUE(w.hasComponent<ComponentC>(ent));
-		ASSERT_TRUE(w.hasComponent<ComponentE>(ent));
+		ASSERT_TRUE(w.hasComponent(ent, w.getComponentId<ComponentA>()));
+		ASSERT_TRUE(w.hasComponent(ent, w.getComponentId<ComponentC>()));
+		ASSERT_TRUE(w.hasComponent(ent, w.getComponentId<ComponentE>()));
 
 		w.removeComponent<ComponentA>(ent);
 		w.removeComponent<ComponentC>(ent);
 		w.removeComponent<ComponentE>(ent);
 
-		ASSERT_FALSE(w.hasComponent<ComponentA>(ent));
-		ASSERT_FALSE(w.hasComponent<ComponentC>(ent));
-		ASSERT_FALSE(w.hasComponent<ComponentE>(ent));
-	}
-
-	TEST(Engine_ECS_World, hasComponents) {
-		World w;
-
-		const auto ent = w.createEntity();
-		w.addComponent<ComponentA>(ent);
-		w.addComponent<ComponentC>(ent);
-		w.addComponent<ComponentE>(ent);
-
-		Engine::ECS::ComponentBitset cbits;
-		cbits[0] = true;
-		cbits[2] = true;
-		cbits[4] = true;
-
-		ASSERT_TRUE(w.hasComponents(ent, cbits));
-	}
-
-	TEST(Engine_ECS_World, hasComponents_Template) {
-		World w;
-
-		const auto ent = w.createEntity();
-		w.addComponents<ComponentA, ComponentC, ComponentE>(ent);
-
-		const auto value = w.hasComponents<ComponentA, ComponentC, ComponentE>(ent);
-		ASSERT_TRUE(value);
+		ASSERT_FALSE(w.hasComponent(ent, w.getComponentId<ComponentA>()));
+		ASSERT_FALSE(w.hasComponent(ent, w.getComponentId<ComponentC>()));
+		ASSERT_FALSE(w.hasComponent(ent, w.getComponentId<ComponentE>()));
 	}
 
 	TEST(Engine_ECS_World, addComponents) {
 		World w;
 
 		const auto ent = w.createEntity();
-		auto& [a, c, e] = w.addComponents<ComponentA, ComponentC, ComponentE>(ent);
+		auto [a, c, e] = w.addComponents<ComponentA, ComponentC, ComponentE>(ent);
 		const auto cbits = w.getBitsetForComponents<ComponentA, ComponentC, ComponentE>();
 
-		ASSERT_TRUE(w.hasComponents(ent, cbits));
+		ASSERT_EQ(w.getComponentsBitset(ent), cbits);
 		ASSERT_TRUE(&a == &w.getComponent<ComponentA>(ent));
 		ASSERT_TRUE(&c == &w.getComponent<ComponentC>(ent));
 		ASSERT_TRUE(&e == &w.getComponent<ComponentE>(ent));
 	}
 
-	TEST(Engine_ECS_World, removeComponents) {
+	TEST(Engine_ECS_World, removeComponent_Bitset) {
 		World w;
 		const auto ent = w.createEntity();
 		const auto cbits = w.getBitsetForComponents<ComponentA, ComponentC, ComponentE>();
 
-		ASSERT_EQ(w.getComponentsBitset(ent), 0);
+		ASSERT_EQ(w.getComponentsBitset(ent), Engine::ECS::ComponentBitset{});
 
 		w.addComponents<ComponentA, ComponentC, ComponentE>(ent);
 
 		ASSERT_EQ(w.getComponentsBitset(ent), cbits);
 
-		w.removeComponents<ComponentA, ComponentC, ComponentE>(ent);
+		w.removeComponent<ComponentA>(ent);
+		w.removeComponent<ComponentC>(ent);
+		w.removeComponent<ComponentE>(ent);
 
-		ASSERT_EQ(w.getComponentsBitset(ent), 0);
+		ASSERT_EQ(w.getComponentsBitset(ent), Engine::ECS::ComponentBitset{});
 	}
 
 	TEST(Engine_ECS_World, getComponents) {
 		World w;
 
 		const auto ent = w.createEntity();
-		auto& [a1, c1, e1] = w.addComponents<ComponentA, ComponentC, ComponentE>(ent);
-		auto& [a2, c2, e2] = w.getComponents<ComponentA, ComponentC, ComponentE>(ent);
-
+		auto [a1, c1, e1] = w.addComponents<ComponentA, ComponentC, ComponentE>(ent);
+		auto [a2, c2, e2] = w.getComponents<ComponentA, ComponentC, ComponentE>(ent);
 
 		ASSERT_TRUE(&a1 == &a2);
 		ASSERT_TRUE(&c1 == &c2);
@@ -263,16 +237,16 @@ namespace {
 		const auto ent = w.createEntity();
 		w.addComponents<ComponentA, ComponentC, ComponentE>(ent);
 
-		auto cbits = w.getComponentsBitset(ent);
+		const auto& cbits = w.getComponentsBitset(ent);
 
 		for (std::size_t i = 0; i < cbits.size(); ++i) {
-			if (i == w.getComponentID<ComponentA>()
-				|| i == w.getComponentID<ComponentC>()
-				|| i == w.getComponentID<ComponentE>()) {
+			if (i == w.getComponentId<ComponentA>()
+				|| i == w.getComponentId<ComponentC>()
+				|| i == w.getComponentId<ComponentE>()) {
 
-				ASSERT_TRUE(cbits[i]);
+				ASSERT_TRUE(cbits.test(i));
 			} else {
-				ASSERT_FALSE(cbits[i]);
+				ASSERT_FALSE(cbits.test(i));
 			}
 		}
 	}
@@ -281,18 +255,20 @@ namespace {
 		World w;
 		auto ent = w.createEntity();
 
-		ASSERT_EQ(w.getComponentsBitset(ent), 0);
+		ASSERT_EQ(w.getComponentsBitset(ent), Engine::ECS::ComponentBitset{});
 
 		w.addComponents<ComponentA, ComponentC, ComponentE>(ent);
 
 		const auto cbits = w.getBitsetForComponents<ComponentA, ComponentC, ComponentE>();
 		ASSERT_EQ(cbits, w.getComponentsBitset(ent));
 
-		w.destroyEntity(ent);
+		w.deferedDestroyEntity(ent);
+		w.run();
 		auto ent2 = w.createEntity();
 
 		ASSERT_EQ(ent.id, ent2.id);
+		ASSERT_NE(ent.gen, ent2.gen);
 
-		ASSERT_EQ(w.getComponentsBitset(ent), 0);
+		ASSERT_EQ(w.getComponentsBitset(ent2), Engine::ECS::ComponentBitset{});
 	}
 }
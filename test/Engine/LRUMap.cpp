@@ -0,0 +1,63 @@
+// Google Test
+#include <gtest/gtest.h>
+
+// Engine
+#include <Engine/LRUMap.hpp>
+
+
+namespace {
+	using namespace Engine::Types;
+
+	TEST(Engine_LRUMap, insert_EvictsLeastRecentlyUsed) {
+		Engine::LRUMap<int32, int32> map{3};
+		map.insert(1, 10);
+		map.insert(2, 20);
+		map.insert(3, 30);
+
+		ASSERT_NE(map.find(1), nullptr); // 2 is now the least recently used
+		map.insert(4, 40);
+
+		EXPECT_EQ(map.size(), 3);
+		EXPECT_EQ(map.peek(2), nullptr);
+		EXPECT_EQ(*map.peek(1), 10);
+		EXPECT_EQ(*map.peek(3), 30);
+		EXPECT_EQ(*map.peek(4), 40);
+
+		// Peek does not change the order so 3 is evicted
+		map.insert(5, 50);
+		EXPECT_EQ(map.peek(3), nullptr);
+	}
+
+	TEST(Engine_LRUMap, insert_Replaces) {
+		Engine::LRUMap<int32, int32> map{2};
+		map.insert(1, 10);
+		map.insert(2, 20);
+		map.insert(1, 11);
+		map.insert(3, 30);
+
+		EXPECT_EQ(map.size(), 2);
+		EXPECT_EQ(*map.peek(1), 11);
+		EXPECT_EQ(map.peek(2), nullptr);
+	}
+
+	TEST(Engine_LRUMap, erase_ReusesNodes) {
+		Engine::LRUMap<int32, int32> map{3};
+		map.insert(1, 10);
+		map.insert(2, 20);
+		map.insert(3, 30);
+
+		EXPECT_TRUE(map.erase(2));
+		EXPECT_FALSE(map.erase(2));
+		EXPECT_EQ(map.size(), 2);
+
+		map.insert(4, 40);
+		EXPECT_EQ(map.size(), 3);
+		EXPECT_EQ(*map.peek(1), 10);
+
+		map.insert(5, 50);
+		EXPECT_EQ(map.peek(1), nullptr);
+		EXPECT_EQ(*map.peek(3), 30);
+		EXPECT_EQ(*map.peek(4), 40);
+		EXPECT_EQ(*map.peek(5), 50);
+	}
+}
@@ -0,0 +1,98 @@
+// STD
+#include <vector>
+#include <random>
+#include <cmath>
+
+// Google Test
+#include <gtest/gtest.h>
+
+// Engine
+#include <Engine/Noise/OpenSimplexNoise.hpp>
+#include <Engine/Noise/SimplexNoise.hpp>
+#include <Engine/Noise/WorleyNoise.hpp>
+
+
+namespace {
+	using namespace Engine::Types;
+
+	constexpr uint64 seed = 1645448290048005;
+
+	/**
+	 * Random points near the origin and far from it along with grid aligned points.
+	 * An odd count so the scalar remainder is also used.
+	 */
+	struct Points {
+		std::vector<float32> xs;
+		std::vector<float32> ys;
+
+		Points() {
+			std::mt19937 rng{1};
+			std::uniform_real_distribution<float32> far{-1e4f, 1e4f};
+			std::uniform_real_distribution<float32> near{-3.0f, 3.0f};
+
+			for (int32 i = 0; i < 4099; ++i) {
+				if (i % 3 == 0) {
+					xs.push_back(far(rng));
+					ys.push_back(far(rng));
+				} else if (i % 3 == 1) {
+					xs.push_back(near(rng));
+					ys.push_back(near(rng));
+				} else {
+					xs.push_back(std::floor(far(rng)));
+					ys.push_back(std::floor(far(rng)) * 0.05f);
+				}
+			}
+		}
+	};
+
+	TEST(Engine_Noise, valueN_OpenSimplex) {
+		const Engine::Noise::OpenSimplexNoise noise{seed};
+		const Points pts;
+		std::vector<float32> out(pts.xs.size());
+		noise.valueN(pts.xs.data(), pts.ys.data(), out.data(), out.size());
+
+		for (size_t i = 0; i < out.size(); ++i) {
+			ASSERT_EQ(noise.value(pts.xs[i], pts.ys[i]), out[i]) << pts.xs[i] << ", " << pts.ys[i];
+		}
+	}
+
+	TEST(Engine_Noise, valueN_Worley) {
+		const Engine::Noise::WorleyNoise noise{seed};
+		const Points pts;
+		std::vector<float32> d2(pts.xs.size());
+		std::vector<float32> f2f1(pts.xs.size());
+		noise.valueD2N(pts.xs.data(), pts.ys.data(), d2.data(), d2.size());
+		noise.valueF2F1N(pts.xs.data(), pts.ys.data(), f2f1.data(), f2f1.size());
+
+		for (size_t i = 0; i < d2.size(); ++i) {
+			ASSERT_EQ(noise.valueD2(pts.xs[i], pts.ys[i]).value, d2[i]) << pts.xs[i] << ", " << pts.ys[i];
+			ASSERT_EQ(noise.valueF2F1(pts.xs[i], pts.ys[i]).value, f2f1[i]) << pts.xs[i] << ", " << pts.ys[i];
+		}
+	}
+
+	TEST(Engine_Noise, valueN_Simplex) {
+		const Engine::Noise::SimplexNoise noise{seed};
+		const Points pts;
+		std::vector<float32> out(pts.xs.size());
+		noise.value1DN(pts.xs.data(), out.data(), out.size());
+
+		for (size_t i = 0; i < out.size(); ++i) {
+			ASSERT_EQ(noise.value1D(pts.xs[i]), out[i]) << pts.xs[i];
+		}
+	}
+
+	TEST(Engine_Noise, valueGrid) {
+		const Engine::Noise::OpenSimplexNoise noise{seed};
+		const glm::vec2 origin = {-12.5f, 3.25f};
+		const glm::vec2 step = {0.3f, 0.07f};
+		const glm::ivec2 size = {37, 300};
+		std::vector<float32> out(size.x * size.y);
+		noise.valueGrid(origin, step, size, out.data());
+
+		for (int32 x = 0; x < size.x; ++x) {
+			for (int32 y = 0; y < size.y; ++y) {
+				ASSERT_EQ(noise.value(origin.x + x * step.x, origin.y + y * step.y), out[x * size.y + y]);
+			}
+		}
+	}
+}
@@ -0,0 +1,46 @@
+// STD
+#include <atomic>
+#include <vector>
+
+// Google Test
+#include <gtest/gtest.h>
+
+// Engine
+#include <Engine/WorkerPool.hpp>
+
+
+namespace {
+	using namespace Engine::Types;
+
+	TEST(Engine_WorkerPool, forEach_CallsEachIndexOnce) {
+		Engine::WorkerPool pool{3};
+		EXPECT_EQ(pool.size(), 4);
+
+		for (int32 n : {0, 1, 2, 7, 1000}) {
+			std::vector<std::atomic<int32>> calls(n);
+			pool.forEach(n, [&](int32 i){ ++calls[i]; });
+
+			for (int32 i = 0; i < n; ++i) {
+				ASSERT_EQ(calls[i].load(), 1) << n << " " << i;
+			}
+		}
+	}
+
+	TEST(Engine_WorkerPool, forEach_Repeated) {
+		Engine::WorkerPool pool{2};
+		std::atomic<int64> sum = 0;
+
+		for (int32 j = 0; j < 500; ++j) {
+			pool.forEach(8, [&](int32 i){ sum += i; });
+		}
+
+		EXPECT_EQ(sum.load(), 500 * 28);
+	}
+
+	TEST(Engine_WorkerPool, forEach_NoThreads) {
+		Engine::WorkerPool pool{0};
+		int32 sum = 0;
+		pool.forEach(4, [&](int32 i){ sum += i; });
+		EXPECT_EQ(sum, 6);
+	}
+}
@@ -0,0 +1,85 @@
+// STD
+#include <vector>
+#include <cstring>
+
+// Google Test
+#include <gtest/gtest.h>
+
+// Game
+#include <Game/ChunkCodec.hpp>
+#include <Game/MapGenerator2.hpp>
+
+
+namespace {
+	using namespace Game;
+
+	struct Chunk {
+		MapChunk::DenseData blocks;
+	};
+
+	std::vector<Chunk> makeChunks() {
+		std::vector<Chunk> res;
+
+		// Uniform
+		auto& air = res.emplace_back();
+		std::fill(&air.blocks[0][0], &air.blocks[0][0] + MapChunk::size.x * MapChunk::size.y, BlockId::Air);
+
+		// Every block different from its neighbors
+		auto& noise = res.emplace_back();
+		for (int x = 0; x < MapChunk::size.x; ++x) {
+			for (int y = 0; y < MapChunk::size.y; ++y) {
+				noise.blocks[x][y] = static_cast<BlockId>((x * 7 + y * 3 + x * y) % BlockId::_COUNT);
+			}
+		}
+
+		// Generated terrain
+		const MapGenerator2 mgen{1234};
+		std::vector<BlockEntityDesc> entData;
+		for (const glm::ivec2 chunkPos : {glm::ivec2{0, 0}, glm::ivec2{0, -1}, glm::ivec2{3, -4}, glm::ivec2{-2, 1}}) {
+			MapChunk chunk;
+			mgen.init(chunkPos * MapChunk::size, chunk, entData);
+			chunk.toDense(res.emplace_back().blocks);
+		}
+
+		return res;
+	}
+
+	TEST(Game_ChunkCodec, RoundTrip) {
+		const auto chunks = makeChunks();
+		std::vector<byte> encoding;
+		Chunk decoded;
+
+		for (int c = 0; c < static_cast<int>(ChunkCodec::_COUNT); ++c) {
+			const auto codec = static_cast<ChunkCodec>(c);
+			for (size_t i = 0; i < chunks.size(); ++i) {
+				encoding.clear();
+				encodeChunk(codec, chunks[i].blocks, encoding);
+				ASSERT_TRUE(decodeChunk(codec, encoding.data(), encoding.data() + encoding.size(), decoded.blocks))
+					<< getChunkCodecName(codec) << " " << i;
+				ASSERT_EQ(memcmp(decoded.blocks, chunks[i].blocks, sizeof(decoded.blocks)), 0)
+					<< getChunkCodecName(codec) << " " << i;
+			}
+		}
+	}
+
+	TEST(Game_ChunkCodec, Malformed) {
+		const auto chunks = makeChunks();
+		std::vector<byte> encoding;
+		Chunk decoded;
+
+		for (int c = 0; c < static_cast<int>(ChunkCodec::_COUNT); ++c) {
+			const auto codec = static_cast<ChunkCodec>(c);
+			for (const auto& chunk : chunks) {
+				encoding.clear();
+				encodeChunk(codec, chunk.blocks, encoding);
+
+				EXPECT_FALSE(decodeChunk(codec, encoding.data(), encoding.data() + encoding.size() - 1, decoded.blocks))
+					<< getChunkCodecName(codec);
+
+				encoding.push_back(0);
+				EXPECT_FALSE(decodeChunk(codec, encoding.data(), encoding.data() + encoding.size(), decoded.blocks))
+					<< getChunkCodecName(codec);
+			}
+		}
+	}
+}
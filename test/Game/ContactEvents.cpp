@@ -0,0 +1,70 @@
+// Google Test
+#include <gtest/gtest.h>
+
+// Game
+#include <Game/ContactEvents.hpp>
+
+
+namespace {
+	using namespace Game;
+	using Engine::ECS::Entity;
+	using Type = ContactEvents::Type;
+
+	TEST(Game_ContactEvents, build_SortsAndDedups) {
+		const Entity a = {1, 0};
+		const Entity b = {2, 0};
+		const Entity c = {3, 0};
+		int fixA = 0;
+		int fixB = 0;
+
+		ContactEvents events;
+		EXPECT_TRUE(events.empty());
+
+		events.add(Type::Begin, c, a, nullptr, nullptr);
+		events.add(Type::Begin, a, b, &fixA, &fixB);
+		events.add(Type::Begin, b, a, &fixB, &fixA);
+		events.add(Type::End, b, c, nullptr, nullptr);
+		events.build();
+
+		EXPECT_FALSE(events.empty());
+		ASSERT_EQ(events.get(Type::Begin).size(), 4);
+		ASSERT_EQ(events.get(Type::End).size(), 2);
+
+		const auto forA = events.get(Type::Begin, a);
+		ASSERT_EQ(forA.size(), 2);
+		EXPECT_EQ(forA[0].other, b);
+		EXPECT_EQ(forA[0].fixtureData, &fixA);
+		EXPECT_EQ(forA[0].otherFixtureData, &fixB);
+		EXPECT_EQ(forA[1].other, c);
+
+		const auto forB = events.get(Type::Begin, b);
+		ASSERT_EQ(forB.size(), 1);
+		EXPECT_EQ(forB[0].other, a);
+		EXPECT_EQ(forB[0].fixtureData, &fixB);
+
+		EXPECT_TRUE(events.get(Type::End, a).empty());
+		EXPECT_EQ(events.get(Type::End, c).size(), 1);
+	}
+
+	TEST(Game_ContactEvents, append_Combines) {
+		const Entity a = {1, 0};
+		const Entity b = {2, 0};
+
+		ContactEvents first;
+		ContactEvents second;
+		first.add(Type::Begin, a, b, nullptr, nullptr);
+		second.add(Type::Begin, b, a, nullptr, nullptr);
+		second.add(Type::End, a, b, nullptr, nullptr);
+
+		ContactEvents events;
+		events.append(first);
+		events.append(second);
+		events.build();
+
+		EXPECT_EQ(events.get(Type::Begin, a).size(), 1);
+		EXPECT_EQ(events.get(Type::End, b).size(), 1);
+
+		events.clear();
+		EXPECT_TRUE(events.empty());
+	}
+}
@@ -0,0 +1,52 @@
+// STD
+#include <vector>
+
+// Google Test
+#include <gtest/gtest.h>
+
+// Game
+#include <Game/MapChunk.hpp>
+#include <Game/MapGenerator2.hpp>
+
+
+namespace {
+	using namespace Game;
+
+	std::vector<MapChunk> makeChunks() {
+		std::vector<MapChunk> res;
+
+		// Uniform
+		MapChunk::DenseData blocks;
+		std::fill(&blocks[0][0], &blocks[0][0] + MapChunk::size.x * MapChunk::size.y, BlockId::Air);
+		res.emplace_back().assign(blocks);
+
+		// Every block different from its neighbors
+		for (int x = 0; x < MapChunk::size.x; ++x) {
+			for (int y = 0; y < MapChunk::size.y; ++y) {
+				blocks[x][y] = static_cast<BlockId>((x * 7 + y * 3 + x * y) % BlockId::_COUNT);
+			}
+		}
+		res.emplace_back().assign(blocks);
+
+		// Generated terrain
+		const MapGenerator2 mgen{1234};
+		std::vector<BlockEntityDesc> entData;
+		for (const glm::ivec2 chunkPos : {glm::ivec2{0, 0}, glm::ivec2{0, -1}, glm::ivec2{3, -4}, glm::ivec2{-2, 1}}) {
+			mgen.init(chunkPos * MapChunk::size, res.emplace_back(), entData);
+		}
+
+		return res;
+	}
+
+	TEST(Game_MapChunk, toRLE_RoundTrip) {
+		std::vector<byte> encoding;
+
+		for (const auto& src : makeChunks()) {
+			src.toRLE(encoding);
+
+			MapChunk dst;
+			ASSERT_TRUE(dst.fromRLE(encoding.data() + sizeof(MapChunk::size), encoding.data() + encoding.size()));
+			EXPECT_EQ(src.hash(), dst.hash());
+		}
+	}
+}
@@ -0,0 +1,81 @@
+// STD
+#include <vector>
+
+// Google Test
+#include <gtest/gtest.h>
+
+// Game
+#include <Game/MapChunk.hpp>
+#include <Game/MapChunkEdit.hpp>
+
+
+namespace {
+	using namespace Game;
+
+	TEST(Game_MapChunkEdit, set_ReplacesPrevious) {
+		MapChunkEdit edit;
+		edit.set({3, 7}, BlockId::Dirt);
+		edit.set({3, 8}, BlockId::Dirt);
+		edit.set({3, 7}, BlockId::Air);
+
+		ASSERT_EQ(edit.size(), 2);
+		EXPECT_EQ(edit.entries()[0].index, MapChunkEdit::toIndex({3, 7}));
+		EXPECT_EQ(edit.entries()[0].bid, BlockId::Air);
+
+		edit.clear();
+		EXPECT_TRUE(edit.empty());
+
+		edit.set({3, 7}, BlockId::Gold);
+		EXPECT_EQ(edit.size(), 1);
+	}
+
+	TEST(Game_MapChunkEdit, encode_RoundTrip) {
+		MapChunkEdit edit;
+		for (int x = 30; x < 35; ++x) {
+			for (int y = 62; y < 67; ++y) {
+				edit.set({x, y % MapChunk::size.y}, (x + y) % 3 ? BlockId::Air : BlockId::Dirt);
+			}
+		}
+		edit.set({MapChunk::size.x - 1, MapChunk::size.y - 1}, BlockId::Iron);
+
+		std::vector<byte> encoding;
+		edit.encode(encoding);
+
+		MapChunkEdit decoded;
+		ASSERT_TRUE(decoded.decode(encoding.data() + sizeof(MapChunk::size), encoding.data() + encoding.size()));
+
+		MapChunk expected;
+		MapChunk actual;
+		EXPECT_TRUE(expected.apply(edit));
+		EXPECT_TRUE(actual.apply(decoded));
+		EXPECT_FALSE(actual.apply(decoded));
+
+		for (int x = 0; x < MapChunk::size.x; ++x) {
+			for (int y = 0; y < MapChunk::size.y; ++y) {
+				ASSERT_EQ(expected.getBlock({x, y}), actual.getBlock({x, y})) << x << ", " << y;
+			}
+		}
+
+		// Truncated data
+		EXPECT_FALSE(decoded.decode(encoding.data() + sizeof(MapChunk::size), encoding.data() + encoding.size() - 1));
+	}
+
+	TEST(Game_MapChunkEdit, fromDense_SkipsNone) {
+		MapChunk chunk;
+		chunk.setBlock({0, 0}, BlockId::Dirt);
+		chunk.setBlock({10, 20}, BlockId::Grass);
+
+		MapChunk::DenseData blocks;
+		chunk.toDense(blocks);
+
+		MapChunkEdit edit;
+		edit.fromDense(blocks);
+		ASSERT_EQ(edit.size(), 2);
+
+		MapChunk result;
+		result.apply(edit);
+		EXPECT_EQ(result.getBlock({0, 0}), BlockId::Dirt);
+		EXPECT_EQ(result.getBlock({10, 20}), BlockId::Grass);
+		EXPECT_EQ(result.getBlock({10, 21}), BlockId::None);
+	}
+}
@@ -0,0 +1,160 @@
+// STD
+#include <vector>
+
+// Google Test
+#include <gtest/gtest.h>
+
+// Game
+#include <Game/MapGenerator2.hpp>
+#include <Game/MapChunk.hpp>
+
+
+namespace {
+	using namespace Game;
+
+	/**
+	 * Chunks covering the sky, surface, caves, trees, portals, and non-default biomes.
+	 * Hashes are from the original per block implementation of init from before chunks were generated a column at a time.
+	 * @see init_GoldenCoverage
+	 */
+	constexpr struct {
+		int64 seed;
+		glm::ivec2 chunk;
+
+		/** The hash of the blocks and block entities. @see hashChunk */
+		uint64 hash;
+
+		/** The hash of only the blocks. @see hashBlocks */
+		uint64 blocks;
+	} golden[] = {
+		{12345, {0, 0}, 0xB11915D2416CC8C3, 0x1809CC5423EE2B69},
+		{12345, {0, -1}, 0xE3D6D00CE74CAB0B, 0x305E6688BABA00C3},
+		{12345, {0, -3}, 0x0959079A0386897F, 0x0959079A0386897F},
+		{12345, {0, 5}, 0x0B926FF341736325, 0x0B926FF341736325},
+		{12345, {-3000, -36}, 0xE4AB915558EE0AE1, 0x6C69BDE04FF49563},
+		{12345, {-2391, -24}, 0xC9445A5326AA388D, 0xCE1827E1CE6C4F54},
+		{12345, {-2997, 63}, 0xF3CF443831FA2F8F, 0xF3CF443831FA2F8F},
+		{12345, {-636, 91}, 0xD10015CFA18A8935, 0xD10015CFA18A8935},
+		{12345, {-2928, 37}, 0x1F5F08E380FDC18B, 0x1F5F08E380FDC18B},
+		{12345, {-2886, 84}, 0x6DCE6B5690A06C33, 0x6DCE6B5690A06C33},
+		{12345, {-2979, 54}, 0xD643D2E6108C1E73, 0xD643D2E6108C1E73},
+		{12345, {1500, -40}, 0x0E9B438A3E7D5585, 0x0E9B438A3E7D5585},
+		{12345, {-138, -2}, 0x31A328A0446175D0, 0x31A328A0446175D0},
+		{1, {0, 0}, 0x06B83548275FE39E, 0xA55925D495E44DA6},
+		{1, {0, -1}, 0xC034FBA8F6E537F0, 0x11896894F1D71F61},
+		{1, {0, -30}, 0x6BEA21AB08833B10, 0x6BEA21AB08833B10},
+		{1, {-1791, 69}, 0x9F5415EC1A3B2525, 0x9F5415EC1A3B2525},
+		{1, {-1531, 49}, 0x245D3A5D2AF88718, 0x245D3A5D2AF88718},
+		{1, {-117, -2}, 0x378CAF390175D6A9, 0x378CAF390175D6A9},
+		{1, {2500, -12}, 0x6828B60639DC144F, 0x6828B60639DC144F},
+	};
+
+	/**
+	 * FNV-1a
+	 */
+	uint64 hashBytes(uint64 hash, const void* data, size_t size) {
+		const auto* bytes = static_cast<const byte*>(data);
+		for (size_t i = 0; i < size; ++i) {
+			hash ^= bytes[i];
+			hash *= 0x100000001B3;
+		}
+		return hash;
+	}
+
+	uint64 hashBlocks(const MapChunk::DenseData& data) {
+		return hashBytes(0xCBF29CE484222325, data, sizeof(data));
+	}
+
+	uint64 hashChunk(const MapChunk& chunk, const std::vector<BlockEntityDesc>& entData) {
+		MapChunk::DenseData data;
+		chunk.toDense(data);
+		uint64 hash = hashBlocks(data);
+
+		for (const auto& ent : entData) {
+			const auto type = static_cast<int32>(ent.data.type);
+			hash = hashBytes(hash, &ent.pos.x, sizeof(ent.pos.x));
+			hash = hashBytes(hash, &ent.pos.y, sizeof(ent.pos.y));
+			hash = hashBytes(hash, &type, sizeof(type));
+			hash = hashBytes(hash, &ent.data.asTree.type, sizeof(ent.data.asTree.type));
+			hash = hashBytes(hash, &ent.data.asTree.size.x, sizeof(ent.data.asTree.size.x));
+			hash = hashBytes(hash, &ent.data.asTree.size.y, sizeof(ent.data.asTree.size.y));
+		}
+
+		return hash;
+	}
+
+	TEST(Game_MapGenerator2, init_GoldenChunks) {
+		for (const auto& g : golden) {
+			const MapGenerator2 mgen{g.seed};
+			MapChunk chunk;
+			std::vector<BlockEntityDesc> entData;
+			mgen.init(g.chunk * MapChunk::size, chunk, entData);
+			EXPECT_EQ(g.hash, hashChunk(chunk, entData)) << "Seed " << g.seed << " chunk " << g.chunk.x << ", " << g.chunk.y;
+		}
+	}
+
+	TEST(Game_MapGenerator2, init_GoldenCoverage) {
+		using Biome = MapGenerator2::Biome;
+		bool biomes[3] = {};
+		bool sky = false;
+		bool tree = false;
+		bool portal = false;
+
+		for (const auto& g : golden) {
+			const MapGenerator2 mgen{g.seed};
+			const auto pos = g.chunk * MapChunk::size;
+			MapChunk chunk;
+			std::vector<BlockEntityDesc> entData;
+			mgen.init(pos, chunk, entData);
+
+			const auto biome = mgen.biome(pos + MapChunk::size / 2);
+			if (biome <= Biome::Jungle) { biomes[static_cast<int>(biome)] = true; }
+
+			for (const auto& ent : entData) {
+				tree = tree || ent.data.type == BlockEntityType::Tree;
+			}
+
+			bool allAir = true;
+			for (int x = 0; x < MapChunk::size.x; ++x) {
+				for (int y = 0; y < MapChunk::size.y; ++y) {
+					const auto block = chunk.getBlock({x, y});
+					allAir = allAir && block == BlockId::Air;
+					portal = portal || block == BlockId::Debug4; // Portal floor
+				}
+			}
+			sky = sky || allAir;
+		}
+
+		EXPECT_TRUE(biomes[static_cast<int>(Biome::Default)]);
+		EXPECT_TRUE(biomes[static_cast<int>(Biome::Forest)]);
+		EXPECT_TRUE(biomes[static_cast<int>(Biome::Jungle)]);
+		EXPECT_TRUE(sky);
+		EXPECT_TRUE(tree);
+		EXPECT_TRUE(portal);
+	}
+
+	TEST(Game_MapGenerator2, value_GoldenChunks) {
+		// Checks the single block path independently of init since both share the column code
+		for (const auto& g : golden) {
+			const MapGenerator2 mgen{g.seed};
+			const auto pos = g.chunk * MapChunk::size;
+			MapChunk::DenseData data;
+
+			for (int x = 0; x < MapChunk::size.x; ++x) {
+				for (int y = 0; y < MapChunk::size.y; ++y) {
+					MapGenerator2::BlockGenData bgd = {.exists = false};
+					auto& block = data[x][y];
+					block = mgen.value(pos.x + x, pos.y + y, bgd);
+
+					// Same post processing as the original init
+					if (bgd.exists) { block = BlockId::Entity; }
+					if (block > BlockId::Air && (x == 0 || y == 0) && block != BlockId::Debug2) {
+						block = BlockId::Debug;
+					}
+				}
+			}
+
+			EXPECT_EQ(g.blocks, hashBlocks(data)) << "Seed " << g.seed << " chunk " << g.chunk.x << ", " << g.chunk.y;
+		}
+	}
+}
@@ -0,0 +1,119 @@
+// STD
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+// Google Test
+#include <gtest/gtest.h>
+
+// Game
+#include <Game/MapRegion.hpp>
+
+
+namespace {
+	using namespace Game;
+
+	BlockEntityDesc makeTree(const glm::ivec2 pos, const uint8 type, const glm::vec2 size) {
+		BlockEntityDesc desc = {};
+		desc.pos = pos;
+		desc.data.type = BlockEntityType::Tree;
+		desc.data.asTree.type = type;
+		desc.data.asTree.size = size;
+		return desc;
+	}
+
+	TEST(Game_MapRegion, writeBlockEntities_RoundTrip) {
+		const glm::ivec2 regionPos = {-3, 2};
+		const glm::ivec2 regionBlock = regionPos * MapRegion::size * MapChunk::size;
+
+		auto region = std::make_unique<MapRegion>();
+		region->data[0][0].entData.push_back(makeTree(regionBlock + glm::ivec2{5, 9}, 2, {1, 20}));
+		region->data[0][0].entData.push_back(makeTree(regionBlock + glm::ivec2{63, 0}, 0, {2, 14}));
+		region->data[7][12].entData.emplace_back().pos = (regionPos * MapRegion::size + glm::ivec2{7, 12}) * MapChunk::size - 1;
+		region->data[7][12].entData.back().data.type = BlockEntityType::Portal;
+
+		std::vector<byte> data = {1, 2, 3};
+		region->writeBlockEntities(data, regionPos);
+		ASSERT_GT(data.size(), 3);
+		EXPECT_EQ(data[0], 1); // Appends
+
+		auto loaded = std::make_unique<MapRegion>();
+		loaded->data[4][4].entData.push_back(makeTree({}, 1, {1, 1})); // Replaced
+		EXPECT_EQ(loaded->readBlockEntities(data.data() + 3, data.data() + data.size(), regionPos), data.data() + data.size());
+
+		for (int32 x = 0; x < MapRegion::size.x; ++x) {
+			for (int32 y = 0; y < MapRegion::size.y; ++y) {
+				const auto& expected = region->data[x][y].entData;
+				const auto& actual = loaded->data[x][y].entData;
+				ASSERT_EQ(actual.size(), expected.size()) << x << ", " << y;
+
+				for (size_t i = 0; i < expected.size(); ++i) {
+					EXPECT_EQ(actual[i].pos, expected[i].pos);
+					ASSERT_EQ(actual[i].data.type, expected[i].data.type);
+					if (expected[i].data.type == BlockEntityType::Tree) {
+						EXPECT_EQ(actual[i].data.asTree.type, expected[i].data.asTree.type);
+						EXPECT_EQ(actual[i].data.asTree.size, expected[i].data.asTree.size);
+					}
+				}
+			}
+		}
+	}
+
+	TEST(Game_MapRegion, readBlockEntities_Malformed) {
+		auto region = std::make_unique<MapRegion>();
+		region->data[1][2].entData.push_back(makeTree(MapChunk::size * glm::ivec2{1, 2}, 1, {1, 20}));
+
+		std::vector<byte> data;
+		region->writeBlockEntities(data, {0, 0});
+
+		auto loaded = std::make_unique<MapRegion>();
+		for (size_t size = 0; size < data.size(); ++size) {
+			EXPECT_EQ(loaded->readBlockEntities(data.data(), data.data() + size, {0, 0}), nullptr) << size;
+		}
+
+		// Invalid type
+		const auto typeAt = sizeof(uint32) + MapRegion::size.x * MapRegion::size.y * sizeof(uint16) + 2 * sizeof(int16);
+		data[typeAt] = static_cast<byte>(BlockEntityType::_COUNT);
+		EXPECT_EQ(loaded->readBlockEntities(data.data(), data.data() + data.size(), {0, 0}), nullptr);
+	}
+
+	TEST(Game_MapRegion, load_Malformed) {
+		const auto path = (std::filesystem::temp_directory_path() / "Game_MapRegion_load_Malformed.region").string();
+		auto region = std::make_unique<MapRegion>();
+		ASSERT_TRUE(region->save(path, {0, 0}, 1234));
+
+		std::vector<char> content;
+		{
+			std::ifstream file{path, std::ios::binary};
+			content.assign(std::istreambuf_iterator<char>{file}, {});
+		}
+
+		const auto rewrite = [&](const std::vector<char>& data){
+			std::ofstream file{path, std::ios::binary | std::ios::trunc};
+			file.write(data.data(), data.size());
+		};
+
+		auto loaded = std::make_unique<MapRegion>();
+		EXPECT_TRUE(loaded->load(path, {0, 0}, 1234));
+
+		{ // Invalid block in the first chunk. Header then the chunk size.
+			auto bad = content;
+			const auto bid = BlockId::_COUNT;
+			memcpy(bad.data() + 32 + sizeof(uint32), &bid, sizeof(bid));
+			rewrite(bad);
+			EXPECT_FALSE(loaded->load(path, {0, 0}, 1234));
+		}
+
+		{ // Trailing data
+			auto bad = content;
+			bad.push_back(0);
+			rewrite(bad);
+			EXPECT_FALSE(loaded->load(path, {0, 0}, 1234));
+		}
+
+		std::filesystem::remove(path);
+	}
+}
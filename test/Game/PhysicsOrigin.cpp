@@ -0,0 +1,166 @@
+// STD
+#include <thread>
+#include <vector>
+
+// Google Test
+#include <gtest/gtest.h>
+
+// Meta
+#include <Meta/TypeSet/TypeSet.hpp>
+
+// Engine
+#include <Engine/ECS/World.hpp>
+
+// Game
+#include <Game/PhysicsOrigin.hpp>
+#include <Game/comps/PhysicsInterpComponent.hpp>
+
+
+namespace {
+	using namespace Game;
+
+	/** Stands in for PhysicsBodyComponent which needs a b2Body. */
+	class BodyComponent {
+		public:
+			b2Vec2 pos = b2Vec2_zero;
+
+			struct SnapshotData {
+				b2Transform trans;
+			};
+
+			operator SnapshotData() const noexcept {
+				SnapshotData data;
+				data.trans.Set(pos, 0.0f);
+				return data;
+			}
+	};
+
+	class World;
+
+	class NullSystem {
+		public:
+			NullSystem(World&) {};
+
+			void setup() {}
+			void preTick() {}
+			void tick() {}
+			void postTick() {}
+			void run(float) {}
+			void preStoreSnapshot() {}
+			void preLoadSnapshot() {}
+			void postLoadSnapshot() {}
+			void preRollback() {}
+			void postRollback() {}
+	};
+
+	using SystemsSet = Meta::TypeSet::TypeSet<NullSystem>;
+	using ComponentsSet = Meta::TypeSet::TypeSet<BodyComponent, PhysicsInterpComponent>;
+
+	class World : public Engine::ECS::World<World, tickrate, SystemsSet, ComponentsSet> {
+		public:
+			World() : Engine::ECS::World<World, tickrate, SystemsSet, ComponentsSet>(*this) {}
+	};
+
+	/** Runs @p world until it has stored a snapshot for @p count more ticks. */
+	void runTicks(World& world, const Engine::ECS::Tick count) {
+		const auto end = world.getTick() + count;
+		while (Engine::seqLess(world.getTick(), end)) {
+			std::this_thread::sleep_for(World::getTickInterval());
+			world.run();
+		}
+	}
+
+	b2Transform makeTransform(const b2Vec2 pos) {
+		b2Transform trans;
+		trans.Set(pos, 0.5f);
+		return trans;
+	}
+
+	struct StoredState {
+		Engine::ECS::Tick tick;
+		Engine::ECS::Entity ent;
+		b2Vec2 pos;
+	};
+
+	std::vector<StoredState> storedStates(const World& world) {
+		std::vector<StoredState> states;
+		for (auto tick = world.getTick() - tickrate + 1; tick != world.getTick() + 1; ++tick) {
+			world.forEachComponentState<BodyComponent>(tick, [&](auto ent, const auto& state){
+				states.push_back({tick, ent, state.trans.p});
+			});
+		}
+		return states;
+	}
+
+	// Positions and shifts are multiples of 1/4 well within float32 precision so the rebased values are exact
+	TEST(Game_PhysicsOrigin, shiftComponentOrigin_RebasesHistory) {
+		World world;
+		const auto a = world.createEntity();
+		const auto b = world.createEntity();
+		world.addComponent<BodyComponent>(a).pos = {10.0f, 20.0f};
+		world.addComponent<BodyComponent>(b).pos = {-300.25f, 4.5f};
+		runTicks(world, 2);
+
+		// Different positions on later ticks
+		world.getComponent<BodyComponent>(a).pos = {12.0f, 20.0f};
+		runTicks(world, 2);
+
+		const auto before = storedStates(world);
+		ASSERT_GE(before.size(), 8);
+
+		const b2Vec2 shift = {256.0f, -512.0f};
+		shiftComponentOrigin<BodyComponent, PhysicsInterpComponent>(world, shift);
+
+		const auto after = storedStates(world);
+		ASSERT_EQ(after.size(), before.size());
+		for (size_t i = 0; i < after.size(); ++i) {
+			EXPECT_EQ(after[i].tick, before[i].tick);
+			EXPECT_EQ(after[i].ent, before[i].ent);
+			EXPECT_EQ(after[i].pos, before[i].pos - shift);
+		}
+
+		// Only the stored history is rebased, the live components are PhysicsSystem's job
+		EXPECT_EQ(world.getComponent<BodyComponent>(a).pos, (b2Vec2{12.0f, 20.0f}));
+	}
+
+	TEST(Game_PhysicsOrigin, shiftComponentOrigin_RebasesInterpolation) {
+		World world;
+		const auto ent = world.createEntity();
+		world.addComponent<BodyComponent>(ent);
+		auto& interp = world.addComponent<PhysicsInterpComponent>(ent);
+
+		interp.prevTime = Engine::Clock::TimePoint{Engine::Clock::Duration{1000}};
+		interp.nextTime = Engine::Clock::TimePoint{Engine::Clock::Duration{3000}};
+		interp.prevTrans = makeTransform({100.0f, 50.0f});
+		interp.nextTrans = makeTransform({104.0f, 48.0f});
+		interp.trans = makeTransform({102.0f, 49.0f});
+		interp.confirm(10, makeTransform({96.0f, 52.0f}));
+		interp.confirm(12, makeTransform({100.0f, 50.0f}));
+		interp.confirm(11, makeTransform({98.0f, 51.0f}));
+
+		const auto lerp = [&](const float32 t){
+			return (1.0f - t) * interp.prevTrans.p + t * interp.nextTrans.p;
+		};
+		const auto mid = lerp(0.5f);
+
+		const b2Vec2 shift = {-64.0f, 128.0f};
+		shiftComponentOrigin<BodyComponent, PhysicsInterpComponent>(world, shift);
+
+		EXPECT_EQ(interp.prevTrans.p, (b2Vec2{164.0f, -78.0f}));
+		EXPECT_EQ(interp.nextTrans.p, (b2Vec2{168.0f, -80.0f}));
+		EXPECT_EQ(interp.trans.p, (b2Vec2{166.0f, -79.0f}));
+
+		// Interpolating after the shift gives the same result relative to the new origin
+		EXPECT_EQ(interp.calcInterpValue(Engine::Clock::TimePoint{Engine::Clock::Duration{2000}}), 0.5);
+		EXPECT_EQ(lerp(0.5f), mid - shift);
+
+		// Confirmed states keep their ticks and order
+		ASSERT_EQ(interp.confirmed.size(), 3);
+		EXPECT_EQ(interp.confirmed[0].tick, 10);
+		EXPECT_EQ(interp.confirmed[1].tick, 11);
+		EXPECT_EQ(interp.confirmed[2].tick, 12);
+		EXPECT_EQ(interp.confirmed[0].trans.p, (b2Vec2{160.0f, -76.0f}));
+		EXPECT_EQ(interp.confirmed[1].trans.p, (b2Vec2{162.0f, -77.0f}));
+		EXPECT_EQ(interp.confirmed[2].trans.p, (b2Vec2{164.0f, -78.0f}));
+	}
+}
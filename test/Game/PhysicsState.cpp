@@ -0,0 +1,241 @@
+// STD
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Google Test
+#include <gtest/gtest.h>
+
+// Game
+#include <Game/PhysicsState.hpp>
+
+
+namespace {
+	using namespace Game;
+
+	constexpr float32 timeStep = 1.0f / 64;
+
+	/**
+	 * Circles rolling along the ground. Spaced so that they only ever contact the ground.
+	 */
+	class RollingWorld {
+		public:
+			b2World world{{0.0f, -10.0f}};
+			std::vector<b2Body*> bodies;
+
+			/**
+			 * @param offset The position of the scene relative to the world origin.
+			 */
+			RollingWorld(const b2Vec2 offset = b2Vec2_zero) {
+				world.SetAllowSleeping(false);
+
+				b2BodyDef groundDef;
+				groundDef.position = offset + b2Vec2{0.0f, -1.0f};
+				b2PolygonShape groundShape;
+				groundShape.SetAsBox(1000.0f, 1.0f);
+				world.CreateBody(&groundDef)->CreateFixture(&groundShape, 0.0f);
+
+				b2CircleShape shape;
+				shape.m_radius = 0.5f;
+
+				for (int32 i = 0; i < 8; ++i) {
+					b2BodyDef bodyDef;
+					bodyDef.type = b2_dynamicBody;
+					bodyDef.position = offset + b2Vec2{i * 3.0f, 0.5f + i * 0.25f};
+
+					b2FixtureDef fixtureDef;
+					fixtureDef.shape = &shape;
+					fixtureDef.density = 1.0f;
+					fixtureDef.friction = 0.6f;
+
+					auto* body = bodies.emplace_back(world.CreateBody(&bodyDef));
+					body->CreateFixture(&fixtureDef);
+				}
+			}
+
+			void step(const int32 i) {
+				for (auto* body : bodies) {
+					body->ApplyForceToCenter({(i % 16) < 8 ? 4.0f : -3.0f, 0.0f}, true);
+				}
+				world.Step(timeStep, 8, 3);
+			}
+
+			void record(std::vector<float32>& out) const {
+				for (const auto* body : bodies) {
+					out.push_back(body->GetPosition().x);
+					out.push_back(body->GetPosition().y);
+					out.push_back(body->GetAngle());
+					out.push_back(body->GetLinearVelocity().x);
+					out.push_back(body->GetLinearVelocity().y);
+					out.push_back(body->GetAngularVelocity());
+				}
+			}
+
+			/**
+			 * Records positions relative to the map origin given the position of the world origin.
+			 */
+			void recordAbsolute(const b2Vec2 origin, std::vector<float64>& out) const {
+				for (const auto* body : bodies) {
+					out.push_back(static_cast<float64>(origin.x) + body->GetPosition().x);
+					out.push_back(static_cast<float64>(origin.y) + body->GetPosition().y);
+				}
+			}
+	};
+
+	float64 maxError(const std::vector<float64>& actual, const std::vector<float64>& expected) {
+		EXPECT_EQ(actual.size(), expected.size());
+		float64 err = 0;
+		for (size_t i = 0; i < std::min(actual.size(), expected.size()); ++i) {
+			err = std::max(err, std::abs(actual[i] - expected[i]));
+		}
+		return err;
+	}
+
+	TEST(Game_PhysicsState, load_ReplayMatches) {
+		RollingWorld rolling;
+		int32 i = 0;
+		for (; i < 64; ++i) { rolling.step(i); }
+		ASSERT_EQ(rolling.world.GetContactCount(), static_cast<int32>(rolling.bodies.size()));
+
+		PhysicsState state;
+		state.store(rolling.world);
+		EXPECT_EQ(state.getBodies().size(), rolling.bodies.size());
+		EXPECT_EQ(state.getContacts().size(), rolling.bodies.size());
+
+		constexpr int32 replayLength = 48;
+		std::vector<float32> expected;
+		for (int32 j = i; j < i + replayLength; ++j) {
+			rolling.step(j);
+			rolling.record(expected);
+		}
+
+		EXPECT_EQ(state.load(rolling.world), static_cast<int32>(rolling.bodies.size()));
+
+		std::vector<float32> actual;
+		for (int32 j = i; j < i + replayLength; ++j) {
+			rolling.step(j);
+			rolling.record(actual);
+		}
+
+		// Exact since the solver is warm started from the same impulses
+		ASSERT_EQ(actual.size(), expected.size());
+		for (size_t j = 0; j < expected.size(); ++j) {
+			ASSERT_EQ(actual[j], expected[j]) << j;
+		}
+	}
+
+	TEST(Game_PhysicsState, load_SkipsUnchanged) {
+		RollingWorld rolling;
+		for (int32 i = 0; i < 8; ++i) { rolling.step(i); }
+
+		PhysicsState state;
+		state.store(rolling.world);
+		EXPECT_EQ(state.load(rolling.world), 0);
+
+		rolling.step(8);
+		auto* removed = rolling.bodies.back();
+		const auto pos = removed->GetPosition();
+		state.remove(removed);
+		EXPECT_EQ(state.getBodies().size(), rolling.bodies.size() - 1);
+
+		EXPECT_EQ(state.load(rolling.world, [&](const b2Body& body){ return &body != rolling.bodies.front(); }), static_cast<int32>(rolling.bodies.size()) - 2);
+		EXPECT_EQ(removed->GetPosition(), pos);
+	}
+
+	TEST(Game_PhysicsState, removeContacts_KeepsBodies) {
+		RollingWorld rolling;
+		for (int32 i = 0; i < 8; ++i) { rolling.step(i); }
+
+		PhysicsState state;
+		state.store(rolling.world);
+		ASSERT_EQ(state.getContacts().size(), rolling.bodies.size());
+
+		state.removeContacts(rolling.bodies.front());
+		EXPECT_EQ(state.getContacts().size(), rolling.bodies.size() - 1);
+		EXPECT_EQ(state.getBodies().size(), rolling.bodies.size());
+
+		// Every contact involves the ground
+		const auto* ground = rolling.bodies.front()->GetContactList()->other;
+		state.removeContacts(ground);
+		EXPECT_TRUE(state.getContacts().empty());
+		EXPECT_EQ(state.getBodies().size(), rolling.bodies.size());
+	}
+
+	TEST(Game_PhysicsState, add_LoadsEachWorld) {
+		RollingWorld a;
+		RollingWorld b;
+		for (int32 i = 0; i < 8; ++i) { a.step(i); b.step(i); }
+
+		PhysicsState state;
+		state.store(a.world);
+		state.add(b.world);
+		EXPECT_EQ(state.getBodies().size(), a.bodies.size() + b.bodies.size());
+		EXPECT_EQ(state.getContacts().size(), a.bodies.size() + b.bodies.size());
+
+		a.step(8);
+		b.step(8);
+		const auto pos = b.bodies.front()->GetPosition();
+
+		EXPECT_EQ(state.load(a.world), static_cast<int32>(a.bodies.size()));
+		EXPECT_EQ(b.bodies.front()->GetPosition(), pos);
+		EXPECT_EQ(state.load(b.world), static_cast<int32>(b.bodies.size()));
+	}
+
+	TEST(Game_PhysicsState, shiftOrigin_KeepsPrecisionFarFromMapOrigin) {
+		// One million blocks from the map origin in each direction
+		const b2Vec2 far = {250000.0f, -250000.0f};
+		constexpr float64 eps = 0.0001; // Same as PLAYER_DATA
+		constexpr int32 warmup = 64;
+		constexpr int32 length = 96;
+
+		// The same scene simulated near the map origin
+		std::vector<float64> expected;
+		{
+			RollingWorld rolling;
+			for (int32 i = 0; i < warmup; ++i) { rolling.step(i); }
+			for (int32 i = warmup; i < warmup + length; ++i) {
+				rolling.step(i);
+				rolling.recordAbsolute(far, expected);
+			}
+		}
+
+		// Without shifting the origin positions this far out are only accurate to 1/64
+		{
+			RollingWorld rolling{far};
+			std::vector<float64> actual;
+			for (int32 i = 0; i < warmup; ++i) { rolling.step(i); }
+			for (int32 i = warmup; i < warmup + length; ++i) {
+				rolling.step(i);
+				rolling.recordAbsolute(b2Vec2_zero, actual);
+			}
+			EXPECT_GT(maxError(actual, expected), eps);
+		}
+
+		// Shifting mid-run and rolling back to a state stored before the shift
+		{
+			RollingWorld rolling{far};
+			b2Vec2 origin = far;
+			rolling.world.ShiftOrigin(origin);
+
+			for (int32 i = 0; i < warmup; ++i) { rolling.step(i); }
+
+			PhysicsState state;
+			state.store(rolling.world);
+			for (int32 i = warmup; i < warmup + 32; ++i) { rolling.step(i); }
+
+			const b2Vec2 shift = {16.0f, 0.0f};
+			rolling.world.ShiftOrigin(shift);
+			state.shiftOrigin(rolling.world, shift);
+			origin += shift;
+
+			EXPECT_EQ(state.load(rolling.world), static_cast<int32>(rolling.bodies.size()));
+
+			std::vector<float64> actual;
+			for (int32 i = warmup; i < warmup + length; ++i) {
+				rolling.step(i);
+				rolling.recordAbsolute(origin, actual);
+			}
+			EXPECT_LT(maxError(actual, expected), eps);
+		}
+	}
+}
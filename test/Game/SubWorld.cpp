@@ -0,0 +1,185 @@
+// STD
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Google Test
+#include <gtest/gtest.h>
+
+// Game
+#include <Game/SubWorld.hpp>
+
+
+namespace {
+	using namespace Game;
+
+	/** Grouping only compares worlds so these stay empty. */
+	b2World physWorldA{b2Vec2_zero};
+	b2World physWorldB{b2Vec2_zero};
+	b2World* const worldA = &physWorldA;
+	b2World* const worldB = &physWorldB;
+
+	void addPlayer(PlayerGroups& groups, const uint16 id, b2World* physWorld, const b2Vec2 pos) {
+		groups.players.push_back({
+			.ent = Engine::ECS::Entity{id, 0},
+			.physWorld = physWorld,
+			.origin = b2Vec2_zero,
+			.pos = pos,
+		});
+	}
+
+	/** The group of the player for entity @p id. */
+	int32 groupOf(const PlayerGroups& groups, const uint16 id) {
+		for (const auto& ply : groups.players) {
+			if (ply.ent.id == id) { return ply.group; }
+		}
+		ADD_FAILURE() << "No player for entity " << id;
+		return -1;
+	}
+
+	TEST(Game_SubWorld, build_GroupsChains) {
+		PlayerGroups groups;
+
+		// 0 and 2 are only grouped through 1
+		addPlayer(groups, 2, worldA, {80.0f, 0.0f});
+		addPlayer(groups, 0, worldA, {0.0f, 0.0f});
+		addPlayer(groups, 1, worldA, {40.0f, 10.0f});
+		addPlayer(groups, 3, worldA, {200.0f, 0.0f});
+		addPlayer(groups, 4, worldA, {0.0f, 100.0f});
+		groups.build();
+
+		ASSERT_EQ(groups.groups.size(), 3);
+		EXPECT_EQ(groupOf(groups, 0), groupOf(groups, 1));
+		EXPECT_EQ(groupOf(groups, 1), groupOf(groups, 2));
+		EXPECT_NE(groupOf(groups, 0), groupOf(groups, 3));
+		EXPECT_NE(groupOf(groups, 0), groupOf(groups, 4));
+		EXPECT_NE(groupOf(groups, 3), groupOf(groups, 4));
+
+		// Sorted by x and each group starts at its lowest index
+		for (size_t i = 1; i < groups.players.size(); ++i) {
+			EXPECT_LE(groups.players[i - 1].pos.x, groups.players[i].pos.x);
+		}
+
+		size_t total = 0;
+		for (const auto& group : groups.groups) {
+			ASSERT_FALSE(group.players.empty());
+			total += group.players.size();
+			for (const auto p : group.players) {
+				EXPECT_GE(p, group.players.front());
+				EXPECT_EQ(groups.groups[groups.players[p].group].players.front(), group.players.front());
+			}
+		}
+		EXPECT_EQ(total, groups.players.size());
+
+		const auto& chain = groups.groups[groupOf(groups, 0)];
+		EXPECT_EQ(chain.players.size(), 3);
+		EXPECT_EQ(chain.bounds.lowerBound, (b2Vec2{0.0f, 0.0f}));
+		EXPECT_EQ(chain.bounds.upperBound, (b2Vec2{80.0f, 10.0f}));
+	}
+
+	TEST(Game_SubWorld, build_MergeAndSplitRanges) {
+		static_assert(PlayerGroups::mergeRange == 48.0f);
+		static_assert(PlayerGroups::splitRange == 64.0f);
+
+		const auto together = [](b2World* physWorld1, b2World* physWorld2, const float32 dist) {
+			PlayerGroups groups;
+			addPlayer(groups, 0, physWorld1, {0.0f, 0.0f});
+			addPlayer(groups, 1, physWorld2, {0.6f * dist, 0.8f * dist});
+			groups.build();
+			return groups.groups.size() == 1;
+		};
+
+		// Different worlds only merge within mergeRange
+		EXPECT_TRUE(together(worldA, worldB, 40.0f));
+		EXPECT_TRUE(together(worldA, worldB, 47.5f));
+		EXPECT_FALSE(together(worldA, worldB, 48.5f));
+		EXPECT_FALSE(together(worldA, worldB, 56.0f));
+
+		// The same world stays together until splitRange
+		EXPECT_TRUE(together(worldA, worldA, 48.5f));
+		EXPECT_TRUE(together(worldA, worldA, 56.0f));
+		EXPECT_TRUE(together(worldA, worldA, 63.5f));
+		EXPECT_FALSE(together(worldA, worldA, 64.5f));
+		EXPECT_FALSE(together(worldA, worldA, 80.0f));
+	}
+
+	TEST(Game_SubWorld, build_MixedWorldsInGroup) {
+		PlayerGroups groups;
+
+		// 1 is kept with 0 by their shared world and brings in 2 from another world
+		addPlayer(groups, 0, worldA, {0.0f, 0.0f});
+		addPlayer(groups, 1, worldA, {60.0f, 0.0f});
+		addPlayer(groups, 2, worldB, {100.0f, 0.0f});
+
+		// Too far from 0 for a different world even though 1 is in range
+		addPlayer(groups, 3, worldB, {0.0f, 50.0f});
+		groups.build();
+
+		EXPECT_EQ(groupOf(groups, 0), groupOf(groups, 1));
+		EXPECT_EQ(groupOf(groups, 1), groupOf(groups, 2));
+		EXPECT_NE(groupOf(groups, 0), groupOf(groups, 3));
+		EXPECT_EQ(groups.groups.size(), 2);
+	}
+
+	TEST(Game_SubWorld, forEachNear_SquareRange) {
+		PlayerGroups groups;
+		addPlayer(groups, 0, worldA, {0.0f, 0.0f});
+		addPlayer(groups, 1, worldA, {10.0f, 10.0f});
+		addPlayer(groups, 2, worldA, {-10.0f, 30.0f});
+		addPlayer(groups, 3, worldA, {25.0f, 0.0f});
+		addPlayer(groups, 4, worldA, {-20.0f, -20.0f});
+		groups.build();
+
+		std::vector<uint16> found;
+		groups.forEachNear({0.0f, 0.0f}, 20.0f, [&](const PlayerGroups::Player& ply){ found.push_back(ply.ent.id); });
+		std::sort(found.begin(), found.end());
+		EXPECT_EQ(found, (std::vector<uint16>{0, 1, 4}));
+
+		found.clear();
+		groups.forEachNear({100.0f, 0.0f}, 20.0f, [&](const PlayerGroups::Player& ply){ found.push_back(ply.ent.id); });
+		EXPECT_TRUE(found.empty());
+	}
+
+	TEST(Game_SubWorld, copyBodyToWorld_ConvertsOrigin) {
+		b2World from{b2Vec2_zero};
+		b2World to{b2Vec2_zero};
+
+		// Origins are on chunk boundaries and positions are exact so the conversion is exact
+		const b2Vec2 fromOrigin = {4096.0f, -2048.0f};
+		const b2Vec2 toOrigin = {8192.0f, 1024.0f};
+
+		b2BodyDef bodyDef;
+		bodyDef.type = b2_dynamicBody;
+		bodyDef.position = {12.5f, -3.25f};
+		bodyDef.angle = 0.5f;
+		bodyDef.linearVelocity = {1.0f, 2.0f};
+		bodyDef.angularVelocity = 0.25f;
+		bodyDef.fixedRotation = true;
+		bodyDef.userData = reinterpret_cast<void*>(static_cast<std::uintptr_t>(1234));
+		auto* body = from.CreateBody(&bodyDef);
+
+		b2CircleShape shape;
+		shape.m_radius = 0.5f;
+		body->CreateFixture(&shape, 2.0f);
+
+		auto* copy = copyBodyToWorld(*body, fromOrigin, to, toOrigin);
+		ASSERT_EQ(copy->GetWorld(), &to);
+		EXPECT_EQ(copy->GetPosition(), (b2Vec2{12.5f + 4096.0f - 8192.0f, -3.25f - 2048.0f - 1024.0f}));
+		EXPECT_EQ(toOrigin + copy->GetPosition(), fromOrigin + body->GetPosition());
+		EXPECT_EQ(copy->GetAngle(), body->GetAngle());
+		EXPECT_EQ(copy->GetLinearVelocity(), body->GetLinearVelocity());
+		EXPECT_EQ(copy->GetAngularVelocity(), body->GetAngularVelocity());
+		EXPECT_EQ(copy->GetType(), b2_dynamicBody);
+		EXPECT_TRUE(copy->IsFixedRotation());
+		EXPECT_EQ(copy->GetUserData(), body->GetUserData());
+		EXPECT_EQ(copy->GetMass(), body->GetMass());
+
+		// Back to the original world and origin
+		auto* back = copyBodyToWorld(*copy, toOrigin, from, fromOrigin);
+		EXPECT_EQ(back->GetPosition(), body->GetPosition());
+
+		// Terrain is copied from the main world which has no origin
+		auto* terrain = copyBodyToWorld(*body, b2Vec2_zero, to, toOrigin);
+		EXPECT_EQ(terrain->GetPosition(), body->GetPosition() - toOrigin);
+	}
+}